@@ -7,10 +7,26 @@
 #include <stb_image.h>
 
 
+Application::Application(const ApplicationOptions& options) : options(options) {
+}
+
 void Application::run() {
-	initWindow();
+	if (!options.tracePath.empty()) {
+		Tracer::start();
+		Tracer::setThreadName("main");
+	}
+	if (!options.headless) {
+		auto phase = startupProfiler.scope("initWindow");
+		initWindow();
+	}
 	initVulkan();
+	logStartupReport();
 	mainLoop();
+	if (Tracer::isEnabled()) {
+		// The device is idle, so every traced thread is too
+		Tracer::stop();
+		Tracer::writeJson(options.tracePath);
+	}
 	cleanup();
 }
 
@@ -22,79 +38,290 @@ void Application::initWindow() {
 	window = glfwCreateWindow(WIDTH, HEIGHT, APPLICATION_NAME, nullptr, nullptr);
 	glfwSetWindowUserPointer(window, this);
 	glfwSetFramebufferSizeCallback(window, framebufferResizeCallback);
+	glfwSetKeyCallback(window, keyCallback);
 }
 
+/// @brief Runs the initialization steps as a task graph (see 'TaskGraph'): the file loads & decodes (model, texture, shaders) don't
+/// @brief depend on any Vulkan object, and overlap with the instance, device & swapchain creation. The steps submitting to the
+/// @brief transfer queue or allocating from the graphics command pool are chained, since both need external synchronization.
 void Application::initVulkan() {
-	createVulkanInstance();
-	createVulkanSurface();
-	pickVulkanPhysicalDevice();
-	createLogicalDevice();
-	createSwapChain();
-	createSwapChainImageViews();
-	createRenderPass();
-	createDescriptorSetLayout();
-	createGraphicsPipeline();
-	createDepthResources();
-	createFramebuffers();
-	createGraphicsCommandPool();
-	createTransferCommandPool();
-	createTransferCommandBuffer();
-	createTextureImage();
-	createTextureImageView();
-	createTextureSampler();
-	load3DModel();
-	createVertexBuffer();
-	createIndexBuffer();
-	createUniformBuffers();
-	createDescriptorPool();
-	createDescriptorSets();
-	createGraphicsCommandBuffers();
-	createSynchronizationObjects();
+	TaskGraph initGraph;
+	// Every step is a startup phase of its own (see 'StartupProfiler')
+	auto add = [this, &initGraph](const std::string& name, std::function<void()> function, const std::vector<TaskId>& dependencies, double estimatedCostMs = 1.0, bool mainThreadOnly = false) {
+		const char* traceName = Tracer::isEnabled() ? Tracer::intern(name) : nullptr;
+		return initGraph.add(name, [this, name, traceName, function = std::move(function)]() {
+			auto phase = startupProfiler.scope(name);
+			TraceScope traceScope(traceName, "init");
+			function();
+		}, dependencies, estimatedCostMs, mainThreadOnly);
+	};
+
+	// Files (no Vulkan object needed)
+	TaskId cameraPathTask = add("loadCameraPath", [this]() {
+		if (!options.cameraPathFile.empty()) {
+			cameraPath = CameraPath::loadFromFile(options.cameraPathFile);
+			StartupProfiler::recordFileRead(options.cameraPathFile);
+			std::cout << "> Loaded camera path '" << options.cameraPathFile << "' (" << cameraPath.getKeyframeCount() << " keyframes, " << cameraPath.getDuration() << " s).\n";
+		}
+	}, {});
+	TaskId modelTask = add("load3DModel", [this]() { load3DModel(); }, {}, 50.0);
+	TaskId textureDecodeTask = add("decodeTextureImage", [this]() { decodeTextureImage(); }, {}, 30.0);
+	TaskId shaderCodeTask = add("loadShaderCode", [this]() { loadShaderCode(); }, {}, 2.0);
+
+	// Instance, device & presentation (the windowing system calls stay on the main thread)
+	TaskId instanceTask = add("createVulkanInstance", [this]() { createVulkanInstance(); }, {}, 20.0);
+	TaskId surfaceTask = instanceTask;
+	if (!options.headless) {
+		surfaceTask = add("createVulkanSurface", [this]() { createVulkanSurface(); }, { instanceTask }, 1.0, true);
+	}
+	TaskId physicalDeviceTask = add("pickVulkanPhysicalDevice", [this]() { pickVulkanPhysicalDevice(); }, { surfaceTask }, 2.0);
+	TaskId deviceTask = add("createLogicalDevice", [this]() { createLogicalDevice(); }, { physicalDeviceTask }, 20.0);
+	TaskId pipelineCacheTask = add("createPipelineCache", [this]() { createPipelineCache(); }, { deviceTask }, 2.0);
+	TaskId dynamicResolutionTask = add("checkDynamicResolutionSupport", [this]() { checkDynamicResolutionSupport(); }, { deviceTask });
+	TaskId swapChainTask{};
+	if (options.headless) {
+		swapChainTask = add("createOffscreenImages", [this]() { createOffscreenImages(); }, { dynamicResolutionTask }, 2.0);
+	}
+	else {
+		swapChainTask = add("createSwapChain", [this]() { createSwapChain(); }, { dynamicResolutionTask }, 10.0, true);
+	}
+	TaskId imageViewsTask = add("createSwapChainImageViews", [this]() { createSwapChainImageViews(); }, { swapChainTask });
+	TaskId renderPassTask = add("createRenderPass", [this]() { createRenderPass(); }, { swapChainTask });
+	TaskId descriptorSetLayoutTask = add("createDescriptorSetLayout", [this]() { createDescriptorSetLayout(); }, { deviceTask });
+	TaskId pipelineTask = add("createGraphicsPipeline", [this]() { createGraphicsPipeline(); }, { renderPassTask, descriptorSetLayoutTask, pipelineCacheTask, shaderCodeTask }, 40.0);
+	TaskId depthTask = add("createDepthResources", [this]() { createDepthResources(); }, { swapChainTask }, 2.0);
+	TaskId sceneColorTask = depthTask;
+	if (options.dynamicResolution) {
+		sceneColorTask = add("createSceneColorResources", [this]() {
+			if (dynamicResolutionEnabled && !renderGraphEnabled) {
+				createSceneColorResources();
+			}
+		}, { depthTask }, 2.0);
+	}
+	TaskId framebuffersTask = add("createFramebuffers", [this]() { createFramebuffers(); }, { imageViewsTask, renderPassTask, depthTask, sceneColorTask });
+
+	// Command pools & the GPU profiler
+	TaskId graphicsCommandPoolTask = add("createGraphicsCommandPool", [this]() { createGraphicsCommandPool(); }, { deviceTask });
+	TaskId transferCommandPoolTask = add("createTransferCommandPool", [this]() { createTransferCommandPool(); }, { deviceTask });
+	TaskId transferCommandBufferTask = add("createTransferCommandBuffer", [this]() { createTransferCommandBuffer(); }, { transferCommandPoolTask });
+	TaskId gpuProfilerTask = add("createGpuProfiler", [this]() { createGpuProfiler(); }, { deviceTask, dynamicResolutionTask });
+
+	// Scene resources (the uploads share the transfer command buffer, one after the other)
+	TaskId textureImageTask = add("createTextureImage", [this]() { createTextureImage(); }, { textureDecodeTask, transferCommandBufferTask }, 10.0);
+	TaskId textureImageViewTask = add("createTextureImageView", [this]() { createTextureImageView(); }, { textureImageTask });
+	TaskId textureSamplerTask = add("createTextureSampler", [this]() { createTextureSampler(); }, { deviceTask });
+	TaskId vertexBufferTask = add("createVertexBuffer", [this]() { createVertexBuffer(); }, { modelTask, textureImageTask }, 5.0);
+	TaskId indexBufferTask = add("createIndexBuffer", [this]() { createIndexBuffer(); }, { vertexBufferTask }, 5.0);
+	TaskId uniformBuffersTask = add("createUniformBuffers", [this]() { createUniformBuffers(); }, { deviceTask });
+	TaskId instancesTask = add("createInstanceBuffers", [this]() {
+		createInstanceBuffers();
+		setInstanceCount(options.objectCount);
+	}, { deviceTask, modelTask }, 5.0);
+	TaskId cullingTask = instancesTask;
+	if (options.gpuCulling) {
+		cullingTask = add("createCullingResources", [this]() {
+			if (gpuCullingEnabled) {
+				createCullingResources();
+			}
+		}, { instancesTask, depthTask, pipelineCacheTask }, 5.0);
+	}
+	TaskId renderGraphTask = framebuffersTask;
+	if (options.renderGraph) {
+		renderGraphTask = add("buildRenderGraph", [this]() {
+			if (renderGraphEnabled) {
+				buildRenderGraph();
+			}
+		}, { framebuffersTask, cullingTask });
+	}
+	TaskId descriptorPoolTask = add("createDescriptorPool", [this]() { createDescriptorPool(); }, { deviceTask });
+	TaskId descriptorSetsTask = add("createDescriptorSets", [this]() { createDescriptorSets(); }, { descriptorPoolTask, descriptorSetLayoutTask, uniformBuffersTask, instancesTask, textureImageViewTask, textureSamplerTask });
+	TaskId synchronizationTask = add("createSynchronizationObjects", [this]() { createSynchronizationObjects(); }, { deviceTask });
+
+	// Command buffers (allocated from the graphics command pool, one step after the other), once everything they may record exists
+	TaskId commandBuffersTask = add("createGraphicsCommandBuffers", [this]() { createGraphicsCommandBuffers(); }, {
+		graphicsCommandPoolTask, renderGraphTask, pipelineTask, gpuProfilerTask, indexBufferTask, cullingTask, descriptorSetsTask, cameraPathTask
+	});
+	if (!options.captureDirectory.empty()) {
+		commandBuffersTask = add("createFrameCaptureResources", [this]() { createFrameCaptureResources(); }, { commandBuffersTask, swapChainTask });
+	}
+	if (options.staticCommandBuffers) {
+		commandBuffersTask = add("createCachedGraphicsCommandBuffers", [this]() { createCachedGraphicsCommandBuffers(); }, { commandBuffersTask });
+	}
+	if (options.recordThreadCount > 0) {
+		commandBuffersTask = add("createRecordingThreadResources", [this]() { createRecordingThreadResources(); }, { commandBuffersTask });
+	}
+	add("initialized", []() {}, { commandBuffersTask, synchronizationTask }, 0.0);
+
+	uint32_t initThreadCount = options.serialInit ? 1 : std::clamp(std::thread::hardware_concurrency(), 1u, MAX_INIT_THREAD_COUNT);
+	initGraph.run(initThreadCount);
+	initGraph.logSummary(std::cout);
+	if (!options.initGraphPath.empty()) {
+		std::ofstream initGraphFile(options.initGraphPath);
+		if (initGraphFile.is_open()) {
+			initGraph.writeJson(initGraphFile);
+			std::cout << "> Wrote the initialization graph to '" << options.initGraphPath << "'.\n";
+		}
+		else {
+			std::cerr << "WARNING: Failed to write the initialization graph to '" << options.initGraphPath << "'!\n";
+		}
+	}
+
+	// Pipeline creation cost (compare a cold launch with a warm one, or with '--no-pipeline-cache')
+	std::cout << "> Created " << pipelineCache.getPipelineCreationCount() << " pipelines in " << std::fixed << std::setprecision(2)
+		<< pipelineCache.getPipelineCreationMs() << std::defaultfloat << " ms (" << (pipelineCache.isWarm() ? "warm" : "cold") << " pipeline cache).\n";
+	// Report the memory footprint right after startup
+	logMemoryTelemetry();
+}
+
+/// @brief Reports the startup phases (and writes them as JSON for the regression checks, if asked to).
+void Application::logStartupReport() {
+	startupProfiler.logReport(std::cout);
+	if (options.startupReportPath.empty()) {
+		return;
+	}
+	std::ofstream startupReportFile(options.startupReportPath);
+	if (startupReportFile.is_open()) {
+		startupProfiler.writeJson(startupReportFile);
+		std::cout << "> Wrote the startup report to '" << options.startupReportPath << "'.\n";
+	}
+	else {
+		std::cerr << "WARNING: Failed to write the startup report to '" << options.startupReportPath << "'!\n";
+	}
 }
 
 void Application::mainLoop() {
+	if (options.benchmark) {
+		runBenchmark();
+		vkDeviceWaitIdle(vulkanLogicalDevice);
+		return;
+	}
+	if (options.instanceBenchmark) {
+		runInstanceBenchmark();
+		vkDeviceWaitIdle(vulkanLogicalDevice);
+		return;
+	}
+	if (options.recordingBenchmark) {
+		runRecordingBenchmark();
+		vkDeviceWaitIdle(vulkanLogicalDevice);
+		return;
+	}
+	if (options.headless) {
+		runHeadless();
+		return;
+	}
+	if (options.resizeStormCount > 0) {
+		runResizeStorm();
+		vkDeviceWaitIdle(vulkanLogicalDevice);
+		return;
+	}
+
 	while (!glfwWindowShouldClose(window)) {
-		glfwPollEvents();
+		pollInput();
 		drawFrame();
+
+		// Periodic memory telemetry
+		if (MEMORY_TELEMETRY_LOG_INTERVAL_SECONDS > 0.0) {
+			double secondsSinceLastLog = std::chrono::duration<double>(std::chrono::steady_clock::now() - lastMemoryTelemetryLogTime).count();
+			if (secondsSinceLastLog >= MEMORY_TELEMETRY_LOG_INTERVAL_SECONDS) {
+				logMemoryTelemetry();
+			}
+		}
 	}
 	// Wait for the logical device to finish operations before destroying the window
 	vkDeviceWaitIdle(vulkanLogicalDevice);
 }
 
 void Application::cleanup() {
+	writeFrameStatsCsv();
+	destroyFrameCaptureResources();
+
+	// The device is idle by now, so everything retired by swapchain recreations can go
+	deferredDeletions.flushAll();
 	cleanupSwapChain();
 
 	vkDestroySampler(vulkanLogicalDevice, textureSampler, nullptr);
 	vkDestroyImageView(vulkanLogicalDevice, textureImageView, nullptr);
 	vkDestroyImage(vulkanLogicalDevice, textureImage, nullptr);
-	vkFreeMemory(vulkanLogicalDevice, textureDeviceMemory, nullptr);
+	freeDeviceMemory(textureDeviceMemory);
 
 	// Destroy the UBOs
 	for (size_t i{ 0 }; i < uniformBuffers.size(); i++) {
 		vkDestroyBuffer(vulkanLogicalDevice, uniformBuffers.at(i), nullptr);
-		vkFreeMemory(vulkanLogicalDevice, uniformBuffersMemory.at(i), nullptr);
+		freeDeviceMemory(uniformBuffersMemory.at(i));
 		uniformBuffersMapped.at(i) = nullptr;
 	}
+	// Destroy the per-instance buffers
+	for (size_t i{ 0 }; i < instanceBuffers.size(); i++) {
+		vkDestroyBuffer(vulkanLogicalDevice, instanceBuffers.at(i), nullptr);
+		freeDeviceMemory(instanceBuffersMemory.at(i));
+		instanceBuffersMapped.at(i) = nullptr;
+	}
+	for (size_t i{ 0 }; i < objectBuffers.size(); i++) {
+		vkDestroyBuffer(vulkanLogicalDevice, objectBuffers.at(i), nullptr);
+		freeDeviceMemory(objectBuffersMemory.at(i));
+		objectBuffersMapped.at(i) = nullptr;
+	}
+	gpuProfiler.destroy();
+
+	// Destroy the GPU culling resources
+	for (size_t i{ 0 }; i < cullUniformBuffers.size(); i++) {
+		vkDestroyBuffer(vulkanLogicalDevice, cullUniformBuffers.at(i), nullptr);
+		freeDeviceMemory(cullUniformBuffersMemory.at(i));
+		vkDestroyBuffer(vulkanLogicalDevice, indirectDrawBuffers.at(i), nullptr);
+		freeDeviceMemory(indirectDrawBuffersMemory.at(i));
+		vkDestroyBuffer(vulkanLogicalDevice, drawCountBuffers.at(i), nullptr);
+		freeDeviceMemory(drawCountBuffersMemory.at(i));
+	}
+	vkDestroyDescriptorPool(vulkanLogicalDevice, cullDescriptorPool, nullptr);
+	vkDestroyDescriptorSetLayout(vulkanLogicalDevice, cullDescriptorSetLayout, nullptr);
+	vkDestroyPipeline(vulkanLogicalDevice, cullPipeline, nullptr);
+	vkDestroyPipelineLayout(vulkanLogicalDevice, cullPipelineLayout, nullptr);
+	// Destroy the occlusion culling resources
+	for (size_t i{ 0 }; i < occlusionStateBuffers.size(); i++) {
+		vkDestroyBuffer(vulkanLogicalDevice, occlusionStateBuffers.at(i), nullptr);
+		freeDeviceMemory(occlusionStateBuffersMemory.at(i));
+	}
+	for (VkImageView levelView : hiZLevelViews) {
+		vkDestroyImageView(vulkanLogicalDevice, levelView, nullptr);
+	}
+	if (hiZImage != VK_NULL_HANDLE) {
+		vkDestroyImageView(vulkanLogicalDevice, hiZImageView, nullptr);
+		vkDestroyImage(vulkanLogicalDevice, hiZImage, nullptr);
+		freeDeviceMemory(hiZImageMemory);
+	}
+	vkDestroyDescriptorPool(vulkanLogicalDevice, hiZDescriptorPool, nullptr);
+	vkDestroyDescriptorSetLayout(vulkanLogicalDevice, hiZDescriptorSetLayout, nullptr);
+	vkDestroyDescriptorSetLayout(vulkanLogicalDevice, hiZSampleDescriptorSetLayout, nullptr);
+	vkDestroyPipeline(vulkanLogicalDevice, hiZPipeline, nullptr);
+	vkDestroyPipelineLayout(vulkanLogicalDevice, hiZPipelineLayout, nullptr);
+	vkDestroySampler(vulkanLogicalDevice, hiZSampler, nullptr);
 	vkDestroyDescriptorPool(vulkanLogicalDevice, vulkanDescriptorPool, nullptr);
 	vkDestroyDescriptorSetLayout(vulkanLogicalDevice, vulkanDescriptorSetLayout, nullptr);
 
-	vkDestroyPipeline(vulkanLogicalDevice, vulkanGraphicsPipeline, nullptr);
+	pipelineRegistry.destroy();
+	vkDestroyShaderModule(vulkanLogicalDevice, sceneVertexShaderModule, nullptr);
+	vkDestroyShaderModule(vulkanLogicalDevice, sceneFragmentShaderModule, nullptr);
 	vkDestroyPipelineLayout(vulkanLogicalDevice, vulkanPipelineLayout, nullptr);
+	// Write back everything compiled during the run, so the next launch starts warm
+	pipelineCache.save();
+	pipelineCache.destroy();
 	vkDestroyRenderPass(vulkanLogicalDevice, vulkanRenderPass, nullptr);
+	vkDestroyRenderPass(vulkanLogicalDevice, vulkanLateRenderPass, nullptr);
 
 	// Destroy the vertex & index buffer and de-allocate the memory allocated for them:
 	vkDestroyBuffer(vulkanLogicalDevice, indexBuffer, nullptr);
-	vkFreeMemory(vulkanLogicalDevice, indexBufferMemory, nullptr);
+	freeDeviceMemory(indexBufferMemory);
 	vkDestroyBuffer(vulkanLogicalDevice, vertexBuffer, nullptr);
-	vkFreeMemory(vulkanLogicalDevice, vertexBufferMemory, nullptr);
+	freeDeviceMemory(vertexBufferMemory);
 
 	// Destroy synchronization objects
 	for (size_t i{ 0 }; i < MAX_FRAMES_IN_FLIGHT; i++) {
 		vkDestroySemaphore(vulkanLogicalDevice, imageAvailableSemaphores.at(i), nullptr);
 		vkDestroySemaphore(vulkanLogicalDevice, renderFinishedSemaphores.at(i), nullptr);
-		vkDestroyFence(vulkanLogicalDevice, inFlightFences.at(i), nullptr);
 	}
+	vkDestroySemaphore(vulkanLogicalDevice, frameTimelineSemaphore, nullptr);
 	// Destroy command buffer pools
+	destroyRecordingThreadResources();
 	vkDestroyCommandPool(vulkanLogicalDevice, vulkanGraphicsCommandPool, nullptr);
 	vkDestroyCommandPool(vulkanLogicalDevice, vulkanTransferCommandPool, nullptr);
 
@@ -103,8 +330,10 @@ void Application::cleanup() {
 	// Destroy Vulkan instance just before the program terminates
 	vkDestroyInstance(vulkanInstance, nullptr);
 
-	glfwDestroyWindow(window);
-	glfwTerminate();
+	if (!options.headless) {
+		glfwDestroyWindow(window);
+		glfwTerminate();
+	}
 }
 
 void Application::createVulkanInstance() {
@@ -127,9 +356,12 @@ void Application::createVulkanInstance() {
 	vulkanAppInfo.apiVersion = VK_API_VERSION_1_4;
 
 	// Vulkan needs extensions to deal with GLFW (GLFW provides handy methods to get these extension names)
+	// Headless mode has no window nor surface, so it needs none.
 	uint32_t glfwExtensionsCount{};
-	const char** glfwExtensionNames;
-	glfwExtensionNames = glfwGetRequiredInstanceExtensions(&glfwExtensionsCount);
+	const char** glfwExtensionNames = nullptr;
+	if (!options.headless) {
+		glfwExtensionNames = glfwGetRequiredInstanceExtensions(&glfwExtensionsCount);
+	}
 
 #ifdef NDEBUG
 	// Release Mode:
@@ -261,14 +493,166 @@ void Application::createLogicalDevice() {
 	// Specifying the physical device features we'll be using (eg. geometry shader)
 	VkPhysicalDeviceFeatures physicalDeviceFeatures{};
 
+	// GPU culling needs the indirect draws to select each object's transform through 'firstInstance',
+	// and compacts the visible draws only if the draw count can come from a buffer (core in Vulkan 1.2)
+	VkPhysicalDeviceVulkan12Features vulkan12Features{};
+	vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+	vulkan12Features.timelineSemaphore = VK_TRUE;  // frame scheduling (checked in 'isPhysicalDeviceSuitable')
+	if (options.gpuCulling) {
+		VkPhysicalDeviceProperties physicalDeviceProperties{};
+		vkGetPhysicalDeviceProperties(vulkanPhysicalDevice, &physicalDeviceProperties);
+
+		VkPhysicalDeviceVulkan12Features supportedVulkan12Features{};
+		supportedVulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+		VkPhysicalDeviceFeatures2 supportedFeatures{};
+		supportedFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+		if (physicalDeviceProperties.apiVersion >= VK_API_VERSION_1_2) {
+			supportedFeatures.pNext = &supportedVulkan12Features;
+		}
+		vkGetPhysicalDeviceFeatures2(vulkanPhysicalDevice, &supportedFeatures);
+
+		gpuCullingEnabled = supportedFeatures.features.drawIndirectFirstInstance == VK_TRUE;
+		if (gpuCullingEnabled) {
+			physicalDeviceFeatures.drawIndirectFirstInstance = VK_TRUE;
+			multiDrawIndirectSupported = supportedFeatures.features.multiDrawIndirect == VK_TRUE;
+			physicalDeviceFeatures.multiDrawIndirect = supportedFeatures.features.multiDrawIndirect;
+			drawIndirectCountSupported = supportedVulkan12Features.drawIndirectCount == VK_TRUE;
+			vulkan12Features.drawIndirectCount = supportedVulkan12Features.drawIndirectCount;
+			std::cout << "> GPU culling enabled (" << (drawIndirectCountSupported ? "vkCmdDrawIndexedIndirectCount" : "vkCmdDrawIndexedIndirect fallback") << ").\n";
+		}
+		else {
+			std::cout << "> GPU culling not supported by this GPU (drawIndirectFirstInstance). Falling back to CPU submitted draws.\n";
+		}
+	}
+	// Dynamic rendering (core in Vulkan 1.3): the scene is rendered straight into the image views, without render pass & framebuffer objects
+	VkPhysicalDeviceVulkan13Features vulkan13Features{};
+	vulkan13Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+	if (options.dynamicRendering) {
+		VkPhysicalDeviceProperties physicalDeviceProperties{};
+		vkGetPhysicalDeviceProperties(vulkanPhysicalDevice, &physicalDeviceProperties);
+		if (physicalDeviceProperties.apiVersion >= VK_API_VERSION_1_3) {
+			VkPhysicalDeviceVulkan13Features supportedVulkan13Features{};
+			supportedVulkan13Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+			VkPhysicalDeviceFeatures2 supportedFeatures{};
+			supportedFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+			supportedFeatures.pNext = &supportedVulkan13Features;
+			vkGetPhysicalDeviceFeatures2(vulkanPhysicalDevice, &supportedFeatures);
+			dynamicRenderingEnabled = supportedVulkan13Features.dynamicRendering == VK_TRUE;
+		}
+		if (dynamicRenderingEnabled) {
+			vulkan13Features.dynamicRendering = VK_TRUE;
+			vulkan12Features.pNext = &vulkan13Features;
+			std::cout << "> Dynamic rendering enabled (no render pass nor framebuffers).\n";
+		}
+		else {
+			std::cerr << "WARNING: Dynamic rendering not supported by this GPU. Falling back to the render pass.\n";
+		}
+	}
+
+	// Bindless descriptors (descriptor indexing, core in Vulkan 1.2): a texture array that's partially bound, updated after being bound and
+	// indexed per object (non-uniformly within a draw), and arrays of uniform & storage buffers indexed by the frame's push constant
+	if (options.bindless) {
+		VkPhysicalDeviceProperties physicalDeviceProperties{};
+		vkGetPhysicalDeviceProperties(vulkanPhysicalDevice, &physicalDeviceProperties);
+		if (physicalDeviceProperties.apiVersion >= VK_API_VERSION_1_2) {
+			VkPhysicalDeviceVulkan12Features supportedVulkan12Features{};
+			supportedVulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+			VkPhysicalDeviceFeatures2 supportedFeatures{};
+			supportedFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+			supportedFeatures.pNext = &supportedVulkan12Features;
+			vkGetPhysicalDeviceFeatures2(vulkanPhysicalDevice, &supportedFeatures);
+			bindlessEnabled = supportedVulkan12Features.runtimeDescriptorArray == VK_TRUE
+				&& supportedVulkan12Features.descriptorBindingPartiallyBound == VK_TRUE
+				&& supportedVulkan12Features.descriptorBindingSampledImageUpdateAfterBind == VK_TRUE
+				&& supportedVulkan12Features.shaderSampledImageArrayNonUniformIndexing == VK_TRUE
+				&& supportedFeatures.features.shaderUniformBufferArrayDynamicIndexing == VK_TRUE
+				&& supportedFeatures.features.shaderStorageBufferArrayDynamicIndexing == VK_TRUE;
+
+			// The texture array's size counts against the update after bind limits (as samplers and as sampled images)
+			VkPhysicalDeviceVulkan12Properties vulkan12Properties{};
+			vulkan12Properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES;
+			VkPhysicalDeviceProperties2 properties2{};
+			properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+			properties2.pNext = &vulkan12Properties;
+			vkGetPhysicalDeviceProperties2(vulkanPhysicalDevice, &properties2);
+			bindlessTextureCapacity = std::min({
+				MAX_BINDLESS_TEXTURES,
+				vulkan12Properties.maxPerStageDescriptorUpdateAfterBindSamplers, vulkan12Properties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+				vulkan12Properties.maxDescriptorSetUpdateAfterBindSamplers, vulkan12Properties.maxDescriptorSetUpdateAfterBindSampledImages
+			});
+			bindlessEnabled = bindlessEnabled && bindlessTextureCapacity > BINDLESS_SCENE_TEXTURE_SLOT;
+		}
+		if (bindlessEnabled) {
+			vulkan12Features.runtimeDescriptorArray = VK_TRUE;
+			vulkan12Features.descriptorBindingPartiallyBound = VK_TRUE;
+			vulkan12Features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+			vulkan12Features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+			physicalDeviceFeatures.shaderUniformBufferArrayDynamicIndexing = VK_TRUE;
+			physicalDeviceFeatures.shaderStorageBufferArrayDynamicIndexing = VK_TRUE;
+			std::cout << "> Bindless descriptors enabled (" << bindlessTextureCapacity << " texture slots, one descriptor set for every frame).\n";
+		}
+		else {
+			std::cerr << "WARNING: Descriptor indexing not supported by this GPU. Falling back to a descriptor set per frame in flight.\n";
+		}
+	}
+
+	renderGraphEnabled = options.renderGraph && dynamicRenderingEnabled;
+	if (renderGraphEnabled) {
+		std::cout << "> Render graph enabled (the frame's barriers are compiled from the passes' reads & writes).\n";
+	}
+	else if (options.renderGraph) {
+		std::cerr << "WARNING: The render graph needs dynamic rendering, which isn't enabled. Using the hand-written barriers.\n";
+	}
+
+	occlusionCullingEnabled = options.occlusionCulling && gpuCullingEnabled;
+	if (occlusionCullingEnabled) {
+		std::cout << "> Hi-Z occlusion culling enabled (two phase, the previous frame's occluded objects are re-tested).\n";
+	}
+	else if (options.occlusionCulling) {
+		std::cerr << "WARNING: Occlusion culling needs GPU culling, which isn't supported. Disabling it.\n";
+	}
+	// The late occlusion pass loads the depth and the Hi-Z pyramid samples it, so it can't be transient with occlusion culling
+	transientDepthEnabled = options.transientDepth && !occlusionCullingEnabled;
+	if (options.transientDepth && !transientDepthEnabled) {
+		std::cerr << "WARNING: Occlusion culling reads the depth after the scene pass. The depth attachment won't be transient.\n";
+	}
+	cpuCullingEnabled = options.cpuCulling && !gpuCullingEnabled;
+	if (cpuCullingEnabled) {
+		std::cout << "> CPU culling enabled (" << SceneObjects::getPathName(SceneObjects::getBestSupportedPath()) << " frustum test).\n";
+	}
+
+	// GPU profiler pipeline statistics. When the draws are recorded into Secondary command buffers,
+	// those execute inside the primary's query, which needs 'inheritedQueries'.
+	{
+		VkPhysicalDeviceFeatures supportedFeatures{};
+		vkGetPhysicalDeviceFeatures(vulkanPhysicalDevice, &supportedFeatures);
+		bool secondaryCommandBuffersUsed = options.recordThreadCount > 0;
+		gpuPipelineStatisticsSupported = supportedFeatures.pipelineStatisticsQuery == VK_TRUE
+			&& (!secondaryCommandBuffersUsed || supportedFeatures.inheritedQueries == VK_TRUE);
+		if (gpuPipelineStatisticsSupported) {
+			physicalDeviceFeatures.pipelineStatisticsQuery = VK_TRUE;
+			physicalDeviceFeatures.inheritedQueries = secondaryCommandBuffersUsed ? VK_TRUE : VK_FALSE;
+		}
+	}
+
 	// Specify how to create the Logical Device to Vulkan
 	VkDeviceCreateInfo createDeviceInfo{};
 	createDeviceInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
 	createDeviceInfo.pQueueCreateInfos = queueCreateInfos.data();
 	createDeviceInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
 	createDeviceInfo.pEnabledFeatures = &physicalDeviceFeatures;
-	createDeviceInfo.ppEnabledExtensionNames = deviceExtensions.data();
-	createDeviceInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
+	createDeviceInfo.pNext = &vulkan12Features;
+	// Required extensions, plus the optional ones that this GPU happens to support
+	enabledDeviceExtensions = getRequiredDeviceExtensions();
+	for (const char* optionalExtension : optionalDeviceExtensions) {
+		if (isPhysicalDeviceExtensionSupported(vulkanPhysicalDevice, optionalExtension)) {
+			enabledDeviceExtensions.push_back(optionalExtension);
+		}
+	}
+	memoryBudgetExtensionEnabled = isPhysicalDeviceExtensionSupported(vulkanPhysicalDevice, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+	calibratedTimestampsExtensionEnabled = isPhysicalDeviceExtensionSupported(vulkanPhysicalDevice, VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME);
+	createDeviceInfo.ppEnabledExtensionNames = enabledDeviceExtensions.data();
+	createDeviceInfo.enabledExtensionCount = static_cast<uint32_t>(enabledDeviceExtensions.size());
 	createDeviceInfo.enabledLayerCount = 0;
 	if (enableVulkanValidationLayers) {
 		createDeviceInfo.enabledLayerCount = static_cast<uint32_t>(vulkanValidationLayers.size());
@@ -290,6 +674,16 @@ void Application::createLogicalDevice() {
 	vkGetDeviceQueue(vulkanLogicalDevice, queueFamilyIndices.transferFamily.value(), 0, &deviceTransferQueue);
 	std::cout << "> Retrieved queue handles.\n";
 
+	// Memory telemetry needs the memory heaps of the GPU, and whether the budget can be queried
+	memoryTelemetry.initialize(vulkanPhysicalDevice, memoryBudgetExtensionEnabled);
+	if (!memoryBudgetExtensionEnabled) {
+		std::cout << "> VK_EXT_memory_budget not supported. Memory telemetry will only report tracked allocations.\n";
+	}
+	transientAllocator.initialize(vulkanPhysicalDevice);
+	if (transientDepthEnabled) {
+		std::cout << "> Transient depth attachment enabled (" << (transientAllocator.hasLazilyAllocatedMemory() ? "lazily allocated memory" : "no lazily allocated memory type on this GPU, plain device local memory") << ").\n";
+	}
+
 }
 
 void Application::recreateSwapChain() {
@@ -300,24 +694,86 @@ void Application::recreateSwapChain() {
 		glfwGetFramebufferSize(window, &width, &height);
 		glfwWaitEvents();
 	}
+	auto recreateStartTime = std::chrono::steady_clock::now();
 
-	// Don't touch resources that may still be in use
-	vkDeviceWaitIdle(vulkanLogicalDevice);
-
-	cleanupSwapChain();
+	// No device wide wait: the frames already submitted keep using the old resources, which are retired into
+	// the deferred deletion queue and destroyed once the GPU has finished the last of those frames
+	retireSwapChainResources();
 
-	createSwapChain();
+	createSwapChain();  // hands the old swapchain over to the new one, then retires it
 	createSwapChainImageViews();
-	createDepthResources();
+	createDepthResources();  // (only reallocated if the new extent outgrows it)
+	if (dynamicResolutionEnabled && !renderGraphEnabled) {
+		createSceneColorResources();
+	}
+	if (occlusionCullingEnabled) {
+		createHiZResources();  // (only recreated along with the depth image)
+	}
 	createFramebuffers();
-	std::cout << "> Recreated swapchain successfully.\n";
+	if (renderGraphEnabled) {
+		buildRenderGraph();  // (only rebuilt along with the depth image)
+	}
+
+	// The pre-recorded command buffers reference the old framebuffers (and the image count may have changed).
+	// They may still be executing, so they're freed through the deferred deletion queue as well.
+	if (options.staticCommandBuffers) {
+		freeCachedGraphicsCommandBuffers();
+		createCachedGraphicsCommandBuffers();
+		invalidateCommandBufferCache();
+	}
+
+	lastSwapChainRecreateMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - recreateStartTime).count();
+	swapChainRecreateCount++;
+	std::cout << "> Recreated swapchain (" << vulkanSwapChainExtent.width << "x" << vulkanSwapChainExtent.height << ") in " << lastSwapChainRecreateMs
+		<< " ms successfully (" << getRenderPathName() << "), " << deferredDeletions.getPendingCount() << " deferred deletion(s) pending.\n";
+}
+
+/// @brief Hands the swapchain image-views and framebuffers over to the deferred deletion queue, keyed on the most recently
+/// @brief submitted frame (the last one that may use them). The swapchain itself is retired by 'createSwapChain', and the
+/// @brief depth image is kept unless the new extent outgrows it (see 'createDepthResources').
+void Application::retireSwapChainResources() {
+	std::vector<VkFramebuffer> retiredFramebuffers;
+	std::vector<VkImageView> retiredImageViews;
+	retiredFramebuffers.swap(vulkanSwapChainFramebuffers);
+	retiredImageViews.swap(vulkanSwapChainImageViews);
+
+	deferredDeletions.enqueue(frameTimelineValue, [this, retiredFramebuffers, retiredImageViews]() {
+		for (VkFramebuffer framebuffer : retiredFramebuffers) {
+			vkDestroyFramebuffer(vulkanLogicalDevice, framebuffer, nullptr);
+		}
+		for (VkImageView imageView : retiredImageViews) {
+			vkDestroyImageView(vulkanLogicalDevice, imageView, nullptr);
+		}
+	});
+}
+
+/// @brief True once no resize event has come in for 'RESIZE_DEBOUNCE_MS' (so a window drag recreates the swapchain once, not per event).
+bool Application::isResizeSettled() const {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - lastResizeEventTime).count() >= RESIZE_DEBOUNCE_MS;
 }
 
 void Application::cleanupSwapChain() {
 	// Destroy the depth images
 	vkDestroyImageView(vulkanLogicalDevice, depthImageView, nullptr);
 	vkDestroyImage(vulkanLogicalDevice, depthImage, nullptr);
-	vkFreeMemory(vulkanLogicalDevice, depthImageMemory, nullptr);
+	freeDeviceMemory(depthImageMemory);
+	// Destroy the render graph's transient images (the scene color target with dynamic resolution)
+	if (renderGraph) {
+		VkDeviceMemory transientMemory = renderGraph->getTransientBlock().memory;
+		renderGraph->destroy(vulkanLogicalDevice);
+		if (transientMemory != VK_NULL_HANDLE) {
+			freeDeviceMemory(transientMemory);
+		}
+		renderGraph.reset();
+		sceneColorImage = VK_NULL_HANDLE;
+		sceneColorImageView = VK_NULL_HANDLE;
+	}
+	// Destroy the dynamic resolution scene target
+	if (sceneColorImage != VK_NULL_HANDLE) {
+		vkDestroyImageView(vulkanLogicalDevice, sceneColorImageView, nullptr);
+		vkDestroyImage(vulkanLogicalDevice, sceneColorImage, nullptr);
+		freeDeviceMemory(sceneColorImageMemory);
+	}
 
 	// Delete all the framebuffers
 	for (auto framebuffer : vulkanSwapChainFramebuffers) {
@@ -327,7 +783,16 @@ void Application::cleanupSwapChain() {
 	for (VkImageView imageView : vulkanSwapChainImageViews) {
 		vkDestroyImageView(vulkanLogicalDevice, imageView, nullptr);
 	}
-	vkDestroySwapchainKHR(vulkanLogicalDevice, vulkanSwapChain, nullptr);
+	if (options.headless) {
+		// The offscreen images are ours to destroy (swapchain images belong to the swapchain)
+		for (size_t i{ 0 }; i < vulkanSwapChainImages.size(); i++) {
+			vkDestroyImage(vulkanLogicalDevice, vulkanSwapChainImages.at(i), nullptr);
+			freeDeviceMemory(offscreenImagesMemory.at(i));
+		}
+	}
+	else {
+		vkDestroySwapchainKHR(vulkanLogicalDevice, vulkanSwapChain, nullptr);
+	}
 }
 
 void Application::createSwapChain() {
@@ -345,6 +810,7 @@ void Application::createSwapChain() {
 	// Choose and set the desired properties of our swapchain
 	VkSurfaceFormatKHR surfaceFormat = chooseSwapSurfaceFormat(swapChainSupport.surfaceFormats);
 	VkPresentModeKHR presentationMode = chooseSwapPresentationMode(swapChainSupport.presentationModes);
+	vulkanSwapChainPresentMode = presentationMode;
 	VkExtent2D swapExtent = chooseSwapExtent(swapChainSupport.surfaceCapabilities);
 
 	// We would like one image more than the min supported images in the swapchain by the device (ensured that its clamped)
@@ -360,6 +826,9 @@ void Application::createSwapChain() {
 	swapChainCreateInfo.imageExtent = swapExtent;
 	swapChainCreateInfo.imageArrayLayers = 1;  // Layers in each image (will always be 1, unless building a stereoscopic 3D application)
 	swapChainCreateInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+	if (dynamicResolutionEnabled) {
+		swapChainCreateInfo.imageUsage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;  // the scene is blitted onto the swapchain images
+	}
 	// Need to specify how to handle swapchain images that will be used across multiple queue families (eg: graphics & presentation queues)
 	QueueFamilyIndices queueFamilyIndices = findQueueFamilies(vulkanPhysicalDevice);
 	uint32_t indices[] = { queueFamilyIndices.graphicsFamily.value(), queueFamilyIndices.presentationFamily.value() };
@@ -383,7 +852,10 @@ void Application::createSwapChain() {
 	swapChainCreateInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;  // No blending with other windows in the window system
 	swapChainCreateInfo.presentMode = presentationMode;
 	swapChainCreateInfo.clipped = VK_TRUE;  // Don't care about pixels that are obscured by say, other windows for example
-	swapChainCreateInfo.oldSwapchain = VK_NULL_HANDLE;  // Swapchain might be unoptimized over time, recreating required. Specify the old one here.
+	// When recreating, the old swapchain is handed over: the driver can reuse its resources, and the images
+	// already acquired from it can still be presented (it's retired, no new image can be acquired from it)
+	VkSwapchainKHR oldSwapChain = vulkanSwapChain;
+	swapChainCreateInfo.oldSwapchain = oldSwapChain;
 
 	// Create the SwapChain:
 	VkResult result = vkCreateSwapchainKHR(vulkanLogicalDevice, &swapChainCreateInfo, nullptr, &vulkanSwapChain);
@@ -392,6 +864,13 @@ void Application::createSwapChain() {
 	}
 	std::cout << "> Vulkan swapchain created successfully.\n";
 
+	// The frames in flight may still render to / present the old swapchain's images
+	if (oldSwapChain != VK_NULL_HANDLE) {
+		deferredDeletions.enqueue(frameTimelineValue, [this, oldSwapChain]() {
+			vkDestroySwapchainKHR(vulkanLogicalDevice, oldSwapChain, nullptr);
+		});
+	}
+
 	// Store the swapchain image-format and extent in member variables:
 	vulkanSwapChainImageFormat = surfaceFormat.format;
 	vulkanSwapChainImageColorspace = surfaceFormat.colorSpace;
@@ -405,6 +884,25 @@ void Application::createSwapChain() {
 
 }
 
+/// @brief Headless mode: creates the color images rendered into in place of the swapchain images.
+/// @brief There's one per frame in flight, and each frame slot always renders into its own (so it's idle once the slot has been waited on).
+void Application::createOffscreenImages() {
+	vulkanSwapChainImageFormat = OFFSCREEN_IMAGE_FORMAT;
+	vulkanSwapChainImageColorspace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
+	vulkanSwapChainExtent = { WIDTH, HEIGHT };
+
+	vulkanSwapChainImages.resize(MAX_FRAMES_IN_FLIGHT);
+	offscreenImagesMemory.resize(MAX_FRAMES_IN_FLIGHT);
+	for (size_t i{ 0 }; i < MAX_FRAMES_IN_FLIGHT; i++) {
+		create2DVulkanImage(
+			vulkanLogicalDevice, vulkanSwapChainExtent.width, vulkanSwapChainExtent.height, vulkanSwapChainImageFormat,
+			VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			MemoryCategory::Attachment, vulkanSwapChainImages.at(i), offscreenImagesMemory.at(i)
+		);
+	}
+	std::cout << "> Created " << MAX_FRAMES_IN_FLIGHT << " offscreen color images (" << vulkanSwapChainExtent.width << "x" << vulkanSwapChainExtent.height << ") successfully.\n";
+}
+
 void Application::createSwapChainImageViews() {
 	// FResize the vector holding the image-views to fit the number of images
 	vulkanSwapChainImageViews.resize(vulkanSwapChainImages.size());
@@ -418,6 +916,12 @@ void Application::createSwapChainImageViews() {
 }
 
 void Application::createRenderPass() {
+	sceneDepthFormat = findDepthFormat();
+	if (dynamicRenderingEnabled) {
+		// Nothing to create: the attachments are given to vkCmdBeginRendering, and their formats to the pipelines
+		return;
+	}
+
 	// We'll just have one color buffer attachment for our framebuffer represented by one of the swapchain images
 	VkAttachmentDescription colorAttachment{};
 	colorAttachment.format = vulkanSwapChainImageFormat;
@@ -431,6 +935,13 @@ void Application::createRenderPass() {
 	// Initial and Final states of the Images before and after the render pass
 	colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 	colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;  // Images to be used for presentation in swap chain
+	if (options.headless) {
+		colorAttachment.finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;  // Offscreen images are only ever copied out
+	}
+	if (dynamicResolutionEnabled) {
+		colorAttachment.finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;  // The scene color image is blitted onto the swapchain image
+	}
+	VkImageLayout sceneColorFinalLayout = colorAttachment.finalLayout;  // (that of the late render pass with occlusion culling)
 
 	VkAttachmentReference colorAttachmentRef{};
 	colorAttachmentRef.attachment = 0;
@@ -438,7 +949,7 @@ void Application::createRenderPass() {
 
 
 	VkAttachmentDescription depthAttachment{};
-	depthAttachment.format = findDepthFormat();
+	depthAttachment.format = sceneDepthFormat;
 	depthAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
 	depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
 	depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
@@ -447,6 +958,13 @@ void Application::createRenderPass() {
 	depthAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 	depthAttachment.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
 
+	// Occlusion culling: this (early) render pass keeps both attachments for the late one, and leaves the depth readable by the Hi-Z build
+	if (occlusionCullingEnabled) {
+		colorAttachment.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+		depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+		depthAttachment.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+	}
+
 	VkAttachmentReference depthAttachmentRef{};
 	depthAttachmentRef.attachment = 1;
 	depthAttachmentRef.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
@@ -466,9 +984,23 @@ void Application::createRenderPass() {
 	subpassDependency.dstSubpass = 0;
 	subpassDependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
 	subpassDependency.srcAccessMask = 0;
+	if (dynamicResolutionEnabled) {
+		subpassDependency.srcStageMask |= VK_PIPELINE_STAGE_TRANSFER_BIT;  // The previous frame's upscale blit reads the scene color image
+	}
 	subpassDependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
 	subpassDependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
 
+	// Occlusion culling: the depth is read by the Hi-Z build, and both attachments are loaded by the late render pass
+	VkSubpassDependency earlyToLateDependency{};
+	earlyToLateDependency.srcSubpass = 0;
+	earlyToLateDependency.dstSubpass = VK_SUBPASS_EXTERNAL;
+	earlyToLateDependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+	earlyToLateDependency.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+	earlyToLateDependency.dstStageMask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+	earlyToLateDependency.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT
+		| VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+	std::array<VkSubpassDependency, 2> subpassDependencies = { subpassDependency, earlyToLateDependency };
+
 
 	// Render Pass creation
 	std::array<VkAttachmentDescription, 2> attachments = { colorAttachment, depthAttachment };
@@ -478,8 +1010,8 @@ void Application::createRenderPass() {
 	renderPassCreateInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
 	renderPassCreateInfo.pSubpasses = &subpass;
 	renderPassCreateInfo.subpassCount = 1;
-	renderPassCreateInfo.pDependencies = &subpassDependency;
-	renderPassCreateInfo.dependencyCount = 1;
+	renderPassCreateInfo.pDependencies = subpassDependencies.data();
+	renderPassCreateInfo.dependencyCount = occlusionCullingEnabled ? 2 : 1;
 
 	VkResult result = vkCreateRenderPass(vulkanLogicalDevice, &renderPassCreateInfo, nullptr, &vulkanRenderPass);
 	if (result != VK_SUCCESS) {
@@ -487,9 +1019,78 @@ void Application::createRenderPass() {
 	}
 	std::cout << "> Created render pass successfully.\n";
 
+	// Late render pass (occlusion culling): same attachments, loaded as the early render pass left them, and ending like it would without
+	// occlusion culling. It waits for the Hi-Z build to be done reading the depth before writing it again.
+	if (occlusionCullingEnabled) {
+		attachments[0].loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+		attachments[0].initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+		attachments[0].finalLayout = sceneColorFinalLayout;
+		attachments[1].loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+		attachments[1].storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+		attachments[1].initialLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+		attachments[1].finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+		VkSubpassDependency lateDependency{};
+		lateDependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+		lateDependency.dstSubpass = 0;
+		lateDependency.srcStageMask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+		lateDependency.srcAccessMask = 0;
+		lateDependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+		lateDependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT
+			| VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+		renderPassCreateInfo.pDependencies = &lateDependency;
+		renderPassCreateInfo.dependencyCount = 1;
+
+		if (vkCreateRenderPass(vulkanLogicalDevice, &renderPassCreateInfo, nullptr, &vulkanLateRenderPass) != VK_SUCCESS) {
+			throw std::runtime_error("RUNTIME ERROR: Failed to create the late render pass!");
+		}
+		std::cout << "> Created late render pass successfully.\n";
+	}
+
 }
 
 void Application::createDescriptorSetLayout() {
+	if (bindlessEnabled) {
+		// Binding 0: every frame's UBO, binding 1: every frame's object buffer, binding 2: the texture array. Only the texture array may be
+		// written while the set is bound (a texture can be added at any time), and its unused slots may stay unbound.
+		std::array<VkDescriptorSetLayoutBinding, 3> bindlessBindings{};
+		bindlessBindings[0].binding = 0;
+		bindlessBindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		bindlessBindings[0].descriptorCount = MAX_FRAMES_IN_FLIGHT;
+		bindlessBindings[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+		bindlessBindings[1].binding = 1;
+		bindlessBindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		bindlessBindings[1].descriptorCount = MAX_FRAMES_IN_FLIGHT;
+		bindlessBindings[1].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+		bindlessBindings[2].binding = 2;
+		bindlessBindings[2].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		bindlessBindings[2].descriptorCount = bindlessTextureCapacity;
+		bindlessBindings[2].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+		std::array<VkDescriptorBindingFlags, 3> bindingFlags = {
+			0u,
+			0u,
+			static_cast<VkDescriptorBindingFlags>(VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT)
+		};
+
+		VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsCreateInfo{};
+		bindingFlagsCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+		bindingFlagsCreateInfo.bindingCount = static_cast<uint32_t>(bindingFlags.size());
+		bindingFlagsCreateInfo.pBindingFlags = bindingFlags.data();
+
+		VkDescriptorSetLayoutCreateInfo bindlessLayoutCreateInfo{};
+		bindlessLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		bindlessLayoutCreateInfo.pNext = &bindingFlagsCreateInfo;
+		bindlessLayoutCreateInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+		bindlessLayoutCreateInfo.bindingCount = static_cast<uint32_t>(bindlessBindings.size());
+		bindlessLayoutCreateInfo.pBindings = bindlessBindings.data();
+
+		if (vkCreateDescriptorSetLayout(vulkanLogicalDevice, &bindlessLayoutCreateInfo, nullptr, &vulkanDescriptorSetLayout) != VK_SUCCESS) {
+			throw std::runtime_error("RUNTIME ERROR: Failed to create the bindless Descriptor Set Layout!");
+		}
+		std::cout << "> Created Vulkan bindless descriptor set layout successfully.\n";
+		return;
+	}
+
 	// Specify the UBO Layout Binding
 	VkDescriptorSetLayoutBinding uboLayoutBinding{};
 	uboLayoutBinding.binding = 0;
@@ -523,37 +1124,112 @@ void Application::createDescriptorSetLayout() {
 
 }
 
+/// @brief Reads in the compiled Vertex and Fragment shaders (Spir-V) of the scene (no Vulkan object needed).
+void Application::loadShaderCode() {
+	sceneVertexShaderCode = readFile("shaders/vert.spv");
+	sceneFragmentShaderCode = readFile("shaders/frag.spv");
+	// (whether the GPU supports the bindless variant is only known once the device is picked)
+	if (options.bindless) {
+		bindlessVertexShaderCode = readFile("shaders/vert_bindless.spv");
+		bindlessFragmentShaderCode = readFile("shaders/frag_bindless.spv");
+	}
+}
+
 void Application::createGraphicsPipeline() {
-	// Read in the compiled Vertex and Fragment shaders (Spir-V)
-	auto vertShaderCode = readFile("shaders/vert.spv");
-	auto fragShaderCode = readFile("shaders/frag.spv");
+	// Create the shader modules from the compiled shader code (kept until cleanup: variants may be compiled at any time)
+	sceneVertexShaderModule = createShaderModule(bindlessEnabled ? bindlessVertexShaderCode : sceneVertexShaderCode);
+	sceneFragmentShaderModule = createShaderModule(bindlessEnabled ? bindlessFragmentShaderCode : sceneFragmentShaderCode);
+	sceneVertexShaderCode.clear();
+	sceneFragmentShaderCode.clear();
+	bindlessVertexShaderCode.clear();
+	bindlessFragmentShaderCode.clear();
+
+	// Defining the Pipeline layout (specifies the 'uniforms' (global shader variables) that can be changed at runtime)
+	// The bindless layout also has the frame index push constant (see 'ScenePushConstants')
+	VkPushConstantRange scenePushConstantRange{};
+	scenePushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+	scenePushConstantRange.offset = 0;
+	scenePushConstantRange.size = sizeof(ScenePushConstants);
+
+	VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+	pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+	pipelineLayoutCreateInfo.setLayoutCount = 1;  // Descriptor set layouts count
+	pipelineLayoutCreateInfo.pSetLayouts = &vulkanDescriptorSetLayout;  // Descriptor set layouts
+	pipelineLayoutCreateInfo.pPushConstantRanges = bindlessEnabled ? &scenePushConstantRange : nullptr;
+	pipelineLayoutCreateInfo.pushConstantRangeCount = bindlessEnabled ? 1 : 0;
+	// Create the pipeline layout
+	VkResult result = vkCreatePipelineLayout(vulkanLogicalDevice, &pipelineLayoutCreateInfo, nullptr, &vulkanPipelineLayout);
+	if (result != VK_SUCCESS) {
+		throw std::runtime_error("RUNTIME ERROR: Failed to create pipeline layout!");
+	}
+	std::cout << "> Created pipeline layout successfully.\n";
+
+	// The generic variant is compiled right away (it's the fallback of every other variant), the scene's variant in the background
+	GraphicsPipelineKey genericPipelineKey{};
+	genericPipelineKey.cullMode = RASTERIZER_CULL_MODE;
+	pipelineRegistry.initialize(
+		vulkanLogicalDevice, pipelineCache,
+		[this](const GraphicsPipelineKey& key, VkPipelineCache cache) { return createGraphicsPipelineVariant(key, cache); },
+		genericPipelineKey, PIPELINE_COMPILER_THREAD_COUNT
+	);
+	std::cout << "> Vulkan graphics pipeline created successfully.\n";
+
+	scenePipelineKey = genericPipelineKey;
+	scenePipelineKey.cullMode = options.cullMode;
+	scenePipelineKey.specializationConstants[0] = static_cast<uint32_t>(options.shadingMode);
+	pipelineRegistry.request(scenePipelineKey);
+}
 
-	// Create the shader modules from the compiled shader code and assign them to their respective pipeline stages
-	VkShaderModule vertShaderModule = createShaderModule(vertShaderCode);
-	VkShaderModule fragShaderModule = createShaderModule(fragShaderCode);
+/// @brief Builds the graphics pipeline of a variant (see 'PipelineRegistry'). Also runs on the registry's worker threads, so it only
+/// @brief reads state that doesn't change after 'createGraphicsPipeline' (shader modules, pipeline layout, render pass).
+VkPipeline Application::createGraphicsPipelineVariant(const GraphicsPipelineKey& key, VkPipelineCache cache) {
+	// Fragment shader specialization constants (constant_id i = key.specializationConstants[i])
+	std::array<VkSpecializationMapEntry, GraphicsPipelineKey::MAX_SPECIALIZATION_CONSTANTS> specializationMapEntries{};
+	for (uint32_t i{ 0 }; i < specializationMapEntries.size(); i++) {
+		specializationMapEntries[i].constantID = i;
+		specializationMapEntries[i].offset = i * sizeof(uint32_t);
+		specializationMapEntries[i].size = sizeof(uint32_t);
+	}
+	VkSpecializationInfo specializationInfo{};
+	specializationInfo.pMapEntries = specializationMapEntries.data();
+	specializationInfo.mapEntryCount = static_cast<uint32_t>(specializationMapEntries.size());
+	specializationInfo.pData = key.specializationConstants.data();
+	specializationInfo.dataSize = sizeof(key.specializationConstants);
 
+	// Assign the shader modules to their respective pipeline stages
 	VkPipelineShaderStageCreateInfo vertShaderStageInfo{};
 	vertShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
 	vertShaderStageInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
-	vertShaderStageInfo.module = vertShaderModule;
+	vertShaderStageInfo.module = sceneVertexShaderModule;
 	vertShaderStageInfo.pName = "main";  // the entry point of the shader code
 
 	VkPipelineShaderStageCreateInfo fragShaderStageInfo{};
 	fragShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
 	fragShaderStageInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-	fragShaderStageInfo.module = fragShaderModule;
+	fragShaderStageInfo.module = sceneFragmentShaderModule;
 	fragShaderStageInfo.pName = "main";  // the entry point of the shader code
+	fragShaderStageInfo.pSpecializationInfo = &specializationInfo;
 
 	VkPipelineShaderStageCreateInfo shaderStages[] = { vertShaderStageInfo, fragShaderStageInfo };
 
-	// Describing the vertex input to the Vulkan vertex shader
-	auto vertexBindingDecription = Vertex::getBindingDescription();
-	auto vertexAttributeDescription = Vertex::getAttributeDescriptions();
+	// Describing the vertex input to the Vulkan vertex shader (binding 0: per-vertex data, binding 1: per-instance data)
+	// ('VertexLayout::MeshInstanced' is the only vertex layout so far)
+	std::array<VkVertexInputBindingDescription, 2> vertexBindingDecription = {
+		Vertex::getBindingDescription(),
+		InstanceData::getBindingDescription()
+	};
+	std::vector<VkVertexInputAttributeDescription> vertexAttributeDescription{};
+	for (const auto& attributeDescription : Vertex::getAttributeDescriptions()) {
+		vertexAttributeDescription.push_back(attributeDescription);
+	}
+	for (const auto& attributeDescription : InstanceData::getAttributeDescriptions()) {
+		vertexAttributeDescription.push_back(attributeDescription);
+	}
 
 	VkPipelineVertexInputStateCreateInfo vertexDataInputInfo{};
 	vertexDataInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-	vertexDataInputInfo.pVertexBindingDescriptions = &vertexBindingDecription;
-	vertexDataInputInfo.vertexBindingDescriptionCount = 1;
+	vertexDataInputInfo.pVertexBindingDescriptions = vertexBindingDecription.data();
+	vertexDataInputInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(vertexBindingDecription.size());
 	vertexDataInputInfo.pVertexAttributeDescriptions = vertexAttributeDescription.data();
 	vertexDataInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(vertexAttributeDescription.size());
 
@@ -564,20 +1240,6 @@ void Application::createGraphicsPipeline() {
 	inputAssemblyCreateInfo.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
 	inputAssemblyCreateInfo.primitiveRestartEnable = VK_FALSE;
 
-	// Viewport definition
-	VkViewport viewport{};
-	viewport.x = 0;
-	viewport.y = 0;
-	viewport.width = (float)vulkanSwapChainExtent.width;
-	viewport.height = (float)vulkanSwapChainExtent.height;
-	viewport.minDepth = 0.0f;
-	viewport.maxDepth = 1.0f;
-
-	// Scissor definition (we'll just draw the entire framebuffer for now)
-	VkRect2D scissor{};
-	scissor.offset = { 0, 0 };
-	scissor.extent = vulkanSwapChainExtent;
-
 	// Make certain parts of the pipeline dynamic [Viewport and Scissor]
 	std::vector<VkDynamicState> dynamicStates = {
 		VK_DYNAMIC_STATE_VIEWPORT,
@@ -589,7 +1251,7 @@ void Application::createGraphicsPipeline() {
 	dynamicPipelineCreateInfo.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
 
 	// Telling Vulkan about our Viewports and Scissors (only mention the counts for a dynamic version of the two)
-	// If we need a static viewport and scissor (unlikely), just pass the reference to the viewport and scissor now
+	// If we need a static viewport and scissor (unlikely), we'd pass references to them here
 	// Since we're using a dynamic viewport and scissor, we'll be passing them later using 'vkCmd' commands
 	VkPipelineViewportStateCreateInfo viewportStateCreateInfo{};
 	viewportStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
@@ -603,7 +1265,7 @@ void Application::createGraphicsPipeline() {
 	rasterizer.rasterizerDiscardEnable = VK_FALSE;  // Disable any output to the framebuffer (geometry never passes through the rasterizer)
 	rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
 	rasterizer.lineWidth = 1.0f;
-	rasterizer.cullMode = RASTERIZER_CULL_MODE;
+	rasterizer.cullMode = key.cullMode;
 	// Vulkan uses the order of the vertices when projected on to the screen to determine front/back faces
 	// We're telling Vulkan what order (clockwise/anti-clockwise) must be treated as front face [OBJ, GLTF etc. use anti-clockwise]
 	rasterizer.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
@@ -625,9 +1287,9 @@ void Application::createGraphicsPipeline() {
 	// Depth Stencil state create info
 	VkPipelineDepthStencilStateCreateInfo depthStencil{};
 	depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
-	depthStencil.depthTestEnable = VK_TRUE;
-	depthStencil.depthWriteEnable = VK_TRUE;
-	depthStencil.depthCompareOp = VK_COMPARE_OP_LESS;
+	depthStencil.depthTestEnable = key.depthTestEnable ? VK_TRUE : VK_FALSE;
+	depthStencil.depthWriteEnable = key.depthWriteEnable ? VK_TRUE : VK_FALSE;
+	depthStencil.depthCompareOp = key.depthCompareOp;
 	depthStencil.depthBoundsTestEnable = VK_FALSE;
 	depthStencil.stencilTestEnable = VK_FALSE;
 
@@ -636,7 +1298,14 @@ void Application::createGraphicsPipeline() {
 	colorBlendAttachment.colorWriteMask =
 		VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
 	// Opaque rendering (no color blending) - What this means is new colors simply overwrite the old colors of the frame buffer
-	colorBlendAttachment.blendEnable = VK_FALSE;
+	// Blended variants use regular alpha blending instead
+	colorBlendAttachment.blendEnable = key.blendEnable ? VK_TRUE : VK_FALSE;
+	colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+	colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+	colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
+	colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+	colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+	colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
 
 	// Color Blending stage properties (global color blend settings)
 	VkPipelineColorBlendStateCreateInfo colorBlending{};
@@ -645,22 +1314,6 @@ void Application::createGraphicsPipeline() {
 	colorBlending.pAttachments = &colorBlendAttachment;
 	colorBlending.attachmentCount = 1;
 
-	// Defining the Pipeline layout (specifies the 'uniforms' (global shader variables) that can be changed at runtime)
-	// Creating an empty pipeline layout for now
-	VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
-	pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-	pipelineLayoutCreateInfo.setLayoutCount = 1;  // Descriptor set layouts count
-	pipelineLayoutCreateInfo.pSetLayouts = &vulkanDescriptorSetLayout;  // Descriptor set layouts
-	pipelineLayoutCreateInfo.pPushConstantRanges = nullptr;
-	pipelineLayoutCreateInfo.pushConstantRangeCount = 0;
-	// Create the pipeline layout
-	VkResult result = vkCreatePipelineLayout(vulkanLogicalDevice, &pipelineLayoutCreateInfo, nullptr, &vulkanPipelineLayout);
-	if (result != VK_SUCCESS) {
-		throw std::runtime_error("RUNTIME ERROR: Failed to create pipeline layout!");
-	}
-	std::cout << "> Created pipeline layout successfully.\n";
-
-
 	// Specify how to create the Graphics Pipeline:
 	VkGraphicsPipelineCreateInfo graphicsPipelineCreateInfo{};
 	graphicsPipelineCreateInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
@@ -677,28 +1330,41 @@ void Application::createGraphicsPipeline() {
 	graphicsPipelineCreateInfo.pDynamicState = &dynamicPipelineCreateInfo;
 	// Pipeline layout:
 	graphicsPipelineCreateInfo.layout = vulkanPipelineLayout;
-	// Render pass and Sub passes:
+	// Render pass and Sub passes (with dynamic rendering, the formats of the attachments it will render into instead):
 	graphicsPipelineCreateInfo.renderPass = vulkanRenderPass;
 	graphicsPipelineCreateInfo.subpass = 0;
+	VkPipelineRenderingCreateInfo pipelineRenderingCreateInfo{};
+	pipelineRenderingCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
+	pipelineRenderingCreateInfo.colorAttachmentCount = 1;
+	pipelineRenderingCreateInfo.pColorAttachmentFormats = &vulkanSwapChainImageFormat;  // (the scene color image has the same format)
+	pipelineRenderingCreateInfo.depthAttachmentFormat = sceneDepthFormat;
+	pipelineRenderingCreateInfo.stencilAttachmentFormat = VK_FORMAT_UNDEFINED;
+	if (dynamicRenderingEnabled) {
+		graphicsPipelineCreateInfo.pNext = &pipelineRenderingCreateInfo;
+		graphicsPipelineCreateInfo.renderPass = VK_NULL_HANDLE;
+	}
 	// Possible to derive a pipeline more efficienbtly from an existing pipeline (if they share a lot in common)
-	// We won't be using this feature here, since we have only one graphics pipeline
+	// We won't be using this feature here (the variants are compiled independently, on any thread)
 	graphicsPipelineCreateInfo.basePipelineHandle = nullptr;
 	graphicsPipelineCreateInfo.basePipelineIndex = -1;
 
 	// Create the Graphics Pipeline:
-	result = vkCreateGraphicsPipelines(
-		vulkanLogicalDevice, VK_NULL_HANDLE, 1, &graphicsPipelineCreateInfo, nullptr, &vulkanGraphicsPipeline
+	VkPipeline graphicsPipeline = VK_NULL_HANDLE;
+	auto pipelineStartTime = std::chrono::steady_clock::now();
+	VkResult result = vkCreateGraphicsPipelines(
+		vulkanLogicalDevice, cache, 1, &graphicsPipelineCreateInfo, nullptr, &graphicsPipeline
 	);
+	pipelineCache.recordPipelineCreation(std::chrono::steady_clock::now() - pipelineStartTime);
 	if (result != VK_SUCCESS) {
 		throw std::runtime_error("RUNTIME ERROR: Failed to create Vulkan Graphics Pipeline!");
 	}
-	std::cout << "> Vulkan graphics pipeline created successfully.\n";
-
-	vkDestroyShaderModule(vulkanLogicalDevice, vertShaderModule, nullptr);
-	vkDestroyShaderModule(vulkanLogicalDevice, fragShaderModule, nullptr);
+	return graphicsPipeline;
 }
 
 void Application::createFramebuffers() {
+	if (dynamicRenderingEnabled) {
+		return;  // rendered straight into the image views
+	}
 	// Each framebuffer wraps a SwapChain image view
 	vulkanSwapChainFramebuffers.resize(vulkanSwapChainImageViews.size());
 
@@ -706,7 +1372,7 @@ void Application::createFramebuffers() {
 		VkImageView framebufferAttachments[] = {
 			// We're only attaching the Color attachment for now 
 			// Can have Depth, Stencil and Resolve[MSAA] in the future per framebuffer
-			vulkanSwapChainImageViews[i],
+			dynamicResolutionEnabled ? sceneColorImageView : vulkanSwapChainImageViews[i],
 			depthImageView
 		};
 
@@ -736,10 +1402,11 @@ void Application::createFramebuffers() {
 /// <param name="usage"> = Specifies the usage of this buffer (eg: VK_BUFFER_USAGE_VERTEX_BUFFER_BIT). vert</param>
 /// <param name="queueFamilyIndices"> = (Optional) Pass the indices of the queue families that can access this buffer. Passing this field will switch the 'sharingMode' of the buffer to CONCURRENT mode instead of EXCLUSIVE mode. </param>
 /// <param name="memoryProperties"> = The memory properties of this buffer (eg: HOST_VISIBLE, DEVICE_LOCAL, etc.) </param>
+/// <param name="memoryCategory"> = The category the allocation is accounted under in the memory telemetry (eg: MemoryCategory::Geometry). </param>
 /// <param name="outVkBuffer"> = (Output) The resultant buffer. </param>
 /// <param name="outBufferMemory"> = (Output) The resultant memory allocated for the buffer. </param>
 /// <param name="queueFamilyIndices"> = (Optional Param) The indices of the queue families that will be sharing this buffer. </param>
-void Application::createBuffer(VkDevice logicalDevice, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags memoryProperties, VkBuffer& outVkBuffer, VkDeviceMemory& outBufferMemory, const std::vector<uint32_t>& queueFamilyIndices) {
+void Application::createBuffer(VkDevice logicalDevice, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags memoryProperties, MemoryCategory memoryCategory, VkBuffer& outVkBuffer, VkDeviceMemory& outBufferMemory, const std::vector<uint32_t>& queueFamilyIndices) {
 
 	// Specify the buffer creation
 	VkBufferCreateInfo bufferCreateInfo{};
@@ -785,6 +1452,8 @@ void Application::createBuffer(VkDevice logicalDevice, VkDeviceSize size, VkBuff
 	if (result != VK_SUCCESS) {
 		throw std::runtime_error("RUNTIME ERROR: Failed to allocate device memory for buffer!");
 	}
+	memoryTelemetry.trackAllocation(outBufferMemory, memoryCategory, memAllocateInfo.allocationSize, memAllocateInfo.memoryTypeIndex);
+	StartupProfiler::recordDeviceMemoryAllocation(memAllocateInfo.allocationSize);
 
 	// Bind the allocated memory and the buffer created
 	vkBindBufferMemory(logicalDevice, outVkBuffer, outBufferMemory, 0);
@@ -800,10 +1469,11 @@ void Application::createBuffer(VkDevice logicalDevice, VkDeviceSize size, VkBuff
 /// <param name="imageTiling"> = The tiling behaviour of the image. (VK_IMAGE_TILING_LINEAR or VK_IMAGE_TILING_OPTIMAL) </param>
 /// <param name="usageFlags"> = The flags indicating the intended use for this image. (eg: VK_IMAGE_USAGE_SAMPLED_BIT) </param>
 /// <param name="memoryProperties"> = The memory properties of the allocated image. (eg: VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) </param>
+/// <param name="memoryCategory"> = The category the allocation is accounted under in the memory telemetry. (eg: MemoryCategory::Texture) </param>
 /// <param name="outImage"> = (Output) The resulting image. </param>
 /// <param name="outImageDeviceMemory"> = (Output) The resulting image device memory. </param>
 /// <param name="queueFamilyIndices"> = (Optional Param) The indices of the queue families that will be sharing this image. </param>
-void Application::create2DVulkanImage(VkDevice logicalDevice, uint32_t width, uint32_t height, VkFormat imageFormat, VkImageTiling imageTiling, VkImageUsageFlags usageFlags, VkMemoryPropertyFlags memoryProperties, VkImage& outImage, VkDeviceMemory& outImageDeviceMemory, const std::vector<uint32_t>& queueFamilyIndices) {
+void Application::create2DVulkanImage(VkDevice logicalDevice, uint32_t width, uint32_t height, VkFormat imageFormat, VkImageTiling imageTiling, VkImageUsageFlags usageFlags, VkMemoryPropertyFlags memoryProperties, MemoryCategory memoryCategory, VkImage& outImage, VkDeviceMemory& outImageDeviceMemory, const std::vector<uint32_t>& queueFamilyIndices, uint32_t mipLevels) {
 
 	VkImageCreateInfo imageCreateInfo{};
 	imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
@@ -811,7 +1481,7 @@ void Application::create2DVulkanImage(VkDevice logicalDevice, uint32_t width, ui
 	imageCreateInfo.extent.width = width;
 	imageCreateInfo.extent.height = height;
 	imageCreateInfo.extent.depth = 1;
-	imageCreateInfo.mipLevels = 1;
+	imageCreateInfo.mipLevels = mipLevels;
 	imageCreateInfo.arrayLayers = 1;
 	imageCreateInfo.format = imageFormat;
 	imageCreateInfo.tiling = imageTiling;  // For efficient access in our shader
@@ -848,12 +1518,30 @@ void Application::create2DVulkanImage(VkDevice logicalDevice, uint32_t width, ui
 	if (result != VK_SUCCESS) {
 		throw std::runtime_error("RUNTIME ERROR: Failed to allocate memory for image!");
 	}
+	memoryTelemetry.trackAllocation(outImageDeviceMemory, memoryCategory, imageMemoryAllocInfo.allocationSize, imageMemoryAllocInfo.memoryTypeIndex);
+	StartupProfiler::recordDeviceMemoryAllocation(imageMemoryAllocInfo.allocationSize);
 	std::cout << "> Allocated memory for Vulkan image successfully.\n";
 
 	vkBindImageMemory(logicalDevice, outImage, outImageDeviceMemory, 0);
 
 }
 
+/// @brief Frees device memory allocated through 'createBuffer' or 'create2DVulkanImage', and removes it from the memory telemetry.
+void Application::freeDeviceMemory(VkDeviceMemory& memory) {
+	memoryTelemetry.trackFree(memory);
+	vkFreeMemory(vulkanLogicalDevice, memory, nullptr);
+	memory = VK_NULL_HANDLE;
+}
+
+/// @brief Logs the per-category allocations and the per-heap usage vs. budget (periodically, or on demand with the 'M' key).
+void Application::logMemoryTelemetry() {
+	memoryTelemetry.logReport(std::cout);
+	if (transientDepthEnabled) {
+		logTransientDepthReport();
+	}
+	lastMemoryTelemetryLogTime = std::chrono::steady_clock::now();
+}
+
 VkFormat Application::findSupportedFormat(const std::vector<VkFormat>& candidates, VkImageTiling tiling, VkFormatFeatureFlags features) {
 	for (VkFormat format : candidates) {
 		VkFormatProperties props;
@@ -871,10 +1559,11 @@ VkFormat Application::findSupportedFormat(const std::vector<VkFormat>& candidate
 }
 
 VkFormat Application::findDepthFormat() {
+	// Occlusion culling builds its Hi-Z pyramid by sampling the depth image
 	return findSupportedFormat(
 		{ VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT },
 		VK_IMAGE_TILING_OPTIMAL,
-		VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT
+		VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT | (occlusionCullingEnabled ? VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT : 0)
 	);
 }
 
@@ -882,60 +1571,319 @@ bool Application::hasStencilComponent(VkFormat format) {
 	return format == VK_FORMAT_D32_SFLOAT_S8_UINT || format == VK_FORMAT_D24_UNORM_S8_UINT;
 }
 
+/// @brief Creates the depth image, unless the current one is already large enough for the swapchain extent (the render area,
+/// @brief viewport and scissor only ever cover the swapchain extent, so a larger depth image works as is).
+/// @brief With a window it's allocated in grow-only power-of-two buckets, so resizing mostly reuses the existing memory.
 void Application::createDepthResources() {
+	if (depthImage != VK_NULL_HANDLE) {
+		if (vulkanSwapChainExtent.width <= depthImageCapacity.width && vulkanSwapChainExtent.height <= depthImageCapacity.height) {
+			return;
+		}
+		retireImage(depthImage, depthImageView, depthImageMemory);
+	}
+
+	VkExtent2D depthImageExtent = vulkanSwapChainExtent;
+	if (!options.headless) {
+		// (headless images are never resized, so they don't need any headroom)
+		depthImageExtent.width = std::max(roundUpToPowerOfTwo(vulkanSwapChainExtent.width), depthImageCapacity.width);
+		depthImageExtent.height = std::max(roundUpToPowerOfTwo(vulkanSwapChainExtent.height), depthImageCapacity.height);
+	}
 	VkFormat depthFormat = findDepthFormat();
 
-	create2DVulkanImage(vulkanLogicalDevice, vulkanSwapChainExtent.width, vulkanSwapChainExtent.height, depthFormat, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, depthImage, depthImageMemory);
+	if (transientDepthEnabled) {
+		createTransientDepthImage(depthImageExtent, depthFormat);
+	}
+	else {
+		VkImageUsageFlags depthImageUsage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | (occlusionCullingEnabled ? VK_IMAGE_USAGE_SAMPLED_BIT : 0);
+		create2DVulkanImage(vulkanLogicalDevice, depthImageExtent.width, depthImageExtent.height, depthFormat, VK_IMAGE_TILING_OPTIMAL, depthImageUsage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, MemoryCategory::Attachment, depthImage, depthImageMemory);
+	}
 	depthImageView = createImageView(depthImage, depthFormat, VK_IMAGE_ASPECT_DEPTH_BIT);
-
+	depthImageCapacity = depthImageExtent;
+	depthImageAllocationCount++;
+	std::cout << "> Created " << (transientDepthEnabled ? "transient " : "") << "depth image (" << depthImageExtent.width << "x" << depthImageExtent.height << ") successfully.\n";
+	if (transientDepthEnabled) {
+		logTransientDepthReport();
+	}
 }
 
-VkImageView Application::createImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags) {
-	VkImageViewCreateInfo viewInfo{};
-	viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-	viewInfo.image = image;
-	viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-	viewInfo.format = format;
-	viewInfo.subresourceRange.aspectMask = aspectFlags;
-	viewInfo.subresourceRange.baseMipLevel = 0;
-	viewInfo.subresourceRange.levelCount = 1;
-	viewInfo.subresourceRange.baseArrayLayer = 0;
-	viewInfo.subresourceRange.layerCount = 1;
-
-	VkImageView imageView;
-	if (vkCreateImageView(vulkanLogicalDevice, &viewInfo, nullptr, &imageView) != VK_SUCCESS) {
-		throw std::runtime_error("failed to create texture image view!");
+/// @brief Creates the depth image as a transient attachment (cleared at the start of the scene pass, never stored) and binds it
+/// @brief into a block of the transient allocator. In lazily allocated memory, a tile-based GPU keeps the depth in tile memory
+/// @brief and never backs the block with real memory. The depth lives within the single scene pass; other transient targets
+/// @brief whose passes don't overlap it would share the block.
+void Application::createTransientDepthImage(VkExtent2D extent, VkFormat format) {
+	VkImageCreateInfo imageCreateInfo{};
+	imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+	imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
+	imageCreateInfo.extent = { extent.width, extent.height, 1 };
+	imageCreateInfo.mipLevels = 1;
+	imageCreateInfo.arrayLayers = 1;
+	imageCreateInfo.format = format;
+	imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+	imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	imageCreateInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+	imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+	imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	if (vkCreateImage(vulkanLogicalDevice, &imageCreateInfo, nullptr, &depthImage) != VK_SUCCESS) {
+		throw std::runtime_error("RUNTIME ERROR: Failed to create the transient depth image!");
 	}
 
-	return imageView;
+	transientDepthBlock = transientAllocator.allocate(vulkanLogicalDevice, { TransientImage{ depthImage, 0, 0 } }, true);
+	depthImageMemory = transientDepthBlock.memory;
+	memoryTelemetry.trackAllocation(depthImageMemory, MemoryCategory::Attachment, transientDepthBlock.size, transientDepthBlock.memoryTypeIndex);
+	StartupProfiler::recordDeviceMemoryAllocation(transientDepthBlock.size);
 }
 
-void Application::createTextureSampler() {
-	VkPhysicalDeviceProperties properties{};
-	vkGetPhysicalDeviceProperties(vulkanPhysicalDevice, &properties);
+/// @brief Logs what the transient depth saves: the memory actually committed to its block (lazily allocated memory is only backed
+/// @brief as far as the GPU needs it, nothing on a tiler), what aliasing saved within the block, and the depth write-back the
+/// @brief DONT_CARE store avoids every frame.
+void Application::logTransientDepthReport() {
+	if (depthImageMemory == VK_NULL_HANDLE || depthImageMemory != transientDepthBlock.memory) {
+		return;
+	}
+	uint32_t bytesPerPixel = findDepthFormat() == VK_FORMAT_D32_SFLOAT_S8_UINT ? 5 : 4;
+	double writeBackMiB = static_cast<double>(vulkanSwapChainExtent.width) * vulkanSwapChainExtent.height * bytesPerPixel / (1024.0 * 1024.0);
+	VkDeviceSize committedBytes = TransientAllocator::getCommittedBytes(vulkanLogicalDevice, transientDepthBlock);
+
+	std::cout << std::fixed << std::setprecision(2)
+		<< "> Transient depth: " << transientDepthBlock.size / 1024 << " KiB block (" << (transientDepthBlock.lazilyAllocated ? "lazily allocated" : "device local") << ")"
+		<< ", " << committedBytes / 1024 << " KiB committed"
+		<< ", " << (transientDepthBlock.unaliasedSize - transientDepthBlock.size) / 1024 << " KiB saved by aliasing"
+		<< ", " << writeBackMiB << " MiB/frame of depth write-back avoided\n"
+		<< std::defaultfloat;
+	if (!transientDepthBlock.lazilyAllocated) {
+		std::cout << "> (No lazily allocated memory type on this GPU: the depth memory is still fully committed, only the store is saved.)\n";
+	}
+}
 
-	VkSamplerCreateInfo samplerInfo{};
-	samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
-	samplerInfo.magFilter = VK_FILTER_LINEAR;
-	samplerInfo.minFilter = VK_FILTER_LINEAR;
-	samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
-	samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
-	samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
-	samplerInfo.anisotropyEnable = VK_TRUE;
-	samplerInfo.maxAnisotropy = properties.limits.maxSamplerAnisotropy;
-	samplerInfo.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
-	samplerInfo.unnormalizedCoordinates = VK_FALSE;
-	samplerInfo.compareEnable = VK_FALSE;
-	samplerInfo.compareOp = VK_COMPARE_OP_ALWAYS;
-	samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
-	samplerInfo.mipLodBias = 0.0f;
-	samplerInfo.minLod = 0.0f;
-	samplerInfo.maxLod = 0.0f;
+/// @brief Hands an image (with its view & memory) over to the deferred deletion queue, since the frames in flight may still be using it.
+void Application::retireImage(VkImage& image, VkImageView& imageView, VkDeviceMemory& imageMemory) {
+	VkImage retiredImage = image;
+	VkImageView retiredImageView = imageView;
+	VkDeviceMemory retiredImageMemory = imageMemory;
+	deferredDeletions.enqueue(frameTimelineValue, [this, retiredImage, retiredImageView, retiredImageMemory]() mutable {
+		vkDestroyImageView(vulkanLogicalDevice, retiredImageView, nullptr);
+		vkDestroyImage(vulkanLogicalDevice, retiredImage, nullptr);
+		freeDeviceMemory(retiredImageMemory);
+	});
+
+	image = VK_NULL_HANDLE;
+	imageView = VK_NULL_HANDLE;
+	imageMemory = VK_NULL_HANDLE;
+}
 
-	if (vkCreateSampler(vulkanLogicalDevice, &samplerInfo, nullptr, &textureSampler) != VK_SUCCESS) {
-		throw std::runtime_error("failed to create texture sampler!");
+/// @brief Dynamic resolution blits the scene color image onto the swapchain (or offscreen) images with a linear filter,
+/// @brief which needs blit & linear filtering support for their format, and transfer destination swapchain images.
+void Application::checkDynamicResolutionSupport() {
+	if (!options.dynamicResolution) {
+		return;
+	}
+
+	VkFormat colorFormat = OFFSCREEN_IMAGE_FORMAT;
+	bool transferDestinationSupported{ true };
+	if (!options.headless) {
+		SwapChainSupportDetails swapChainSupport = querySwapChainSupport(vulkanPhysicalDevice);
+		colorFormat = chooseSwapSurfaceFormat(swapChainSupport.surfaceFormats).format;
+		transferDestinationSupported = (swapChainSupport.surfaceCapabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_DST_BIT) != 0;
 	}
-	std::cout << "> Created texture sampler successfully.\n";
+
+	VkFormatProperties formatProperties{};
+	vkGetPhysicalDeviceFormatProperties(vulkanPhysicalDevice, colorFormat, &formatProperties);
+	VkFormatFeatureFlags requiredFeatures = VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT | VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+	dynamicResolutionEnabled = transferDestinationSupported && (formatProperties.optimalTilingFeatures & requiredFeatures) == requiredFeatures;
+	if (dynamicResolutionEnabled) {
+		std::cout << "> Dynamic resolution enabled (target GPU frame time " << options.targetGpuFrameMs << " ms, min scale " << options.minResolutionScale << ").\n";
+	}
+	else {
+		std::cerr << "WARNING: Dynamic resolution not supported (linear blits of the swapchain format). Rendering at full resolution.\n";
+	}
+}
+
+/// @brief Creates the scene color image dynamic resolution renders into, at the depth image's size (so it follows the same
+/// @brief grow-only buckets, and is only reallocated when the depth image is).
+void Application::createSceneColorResources() {
+	if (sceneColorImage != VK_NULL_HANDLE) {
+		if (sceneColorImageCapacity.width == depthImageCapacity.width && sceneColorImageCapacity.height == depthImageCapacity.height) {
+			return;
+		}
+		retireImage(sceneColorImage, sceneColorImageView, sceneColorImageMemory);
+	}
+
+	create2DVulkanImage(
+		vulkanLogicalDevice, depthImageCapacity.width, depthImageCapacity.height, vulkanSwapChainImageFormat, VK_IMAGE_TILING_OPTIMAL,
+		VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+		MemoryCategory::Attachment, sceneColorImage, sceneColorImageMemory
+	);
+	sceneColorImageView = createImageView(sceneColorImage, vulkanSwapChainImageFormat, VK_IMAGE_ASPECT_COLOR_BIT);
+	sceneColorImageCapacity = depthImageCapacity;
+	std::cout << "> Created scene color image (" << sceneColorImageCapacity.width << "x" << sceneColorImageCapacity.height << ") successfully.\n";
+}
+
+/// @brief Extent the scene is rendered at: the swapchain extent, scaled by the resolution scale with dynamic resolution.
+VkExtent2D Application::getSceneRenderExtent() const {
+	if (!dynamicResolutionEnabled) {
+		return vulkanSwapChainExtent;
+	}
+	return {
+		std::max(1u, static_cast<uint32_t>(vulkanSwapChainExtent.width * resolutionScale + 0.5f)),
+		std::max(1u, static_cast<uint32_t>(vulkanSwapChainExtent.height * resolutionScale + 0.5f))
+	};
+}
+
+/// @brief Dynamic resolution controller: adapts the resolution scale to the GPU time of the most recently completed frame.
+/// @brief Hysteresis: it drops as soon as the GPU is over the target, but only rises after a streak of frames well under it,
+/// @brief and ignores the frames rendered before its last change (they're still coming back from the GPU).
+void Application::updateResolutionScale() {
+	if (!dynamicResolutionEnabled || !gpuProfiler.isTimestampSupported()) {
+		return;
+	}
+	const GpuFrameResult& gpuResult = gpuProfiler.getLastResult();
+	if (gpuResult.frameNumber < resolutionScaleChangeFrame || gpuResult.frameNumber == lastResolutionScaleGpuFrame || gpuResult.frameTimeMs <= 0.0) {
+		return;
+	}
+	lastResolutionScaleGpuFrame = gpuResult.frameNumber;
+
+	float newScale = resolutionScale;
+	if (gpuResult.frameTimeMs > options.targetGpuFrameMs) {
+		// The fragment work is proportional to the pixel count, i.e. to the square of the scale
+		newScale = resolutionScale * static_cast<float>(std::sqrt(options.targetGpuFrameMs * RESOLUTION_SCALE_DROP_MARGIN / gpuResult.frameTimeMs));
+		newScale = std::min(newScale, resolutionScale - RESOLUTION_SCALE_STEP);
+		resolutionScaleHeadroomFrames = 0;
+	}
+	else if (gpuResult.frameTimeMs < options.targetGpuFrameMs * RESOLUTION_SCALE_RAISE_THRESHOLD) {
+		if (++resolutionScaleHeadroomFrames >= RESOLUTION_SCALE_RAISE_FRAMES) {
+			newScale = resolutionScale + RESOLUTION_SCALE_STEP;
+			resolutionScaleHeadroomFrames = 0;
+		}
+	}
+	else {
+		resolutionScaleHeadroomFrames = 0;
+	}
+	newScale = std::clamp(std::round(newScale / RESOLUTION_SCALE_STEP) * RESOLUTION_SCALE_STEP, options.minResolutionScale, 1.0f);
+
+	if (newScale != resolutionScale) {
+		resolutionScale = newScale;
+		resolutionScaleChangeFrame = frameNumber;
+		// The render area & viewport are baked into the pre-recorded command buffers
+		invalidateCommandBufferCache();
+	}
+}
+
+/// @brief Dynamic resolution: blits the rendered part of the scene color image onto the whole swapchain (or offscreen) image.
+void Application::recordUpscale(VkCommandBuffer commandBuffer, uint32_t swapChainImageIndex) {
+	VkExtent2D sceneRenderExtent = getSceneRenderExtent();
+	VkImage targetImage = vulkanSwapChainImages.at(swapChainImageIndex);
+
+	// The scene color writes must be visible to the blit, and the target image's previous contents are discarded.
+	// (The target's barrier starts at the color attachment output stage, which is where the submission waits on image acquisition.)
+	std::array<VkImageMemoryBarrier, 2> blitBarriers{};
+	for (VkImageMemoryBarrier& barrier : blitBarriers) {
+		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		barrier.subresourceRange.baseMipLevel = 0;
+		barrier.subresourceRange.levelCount = 1;
+		barrier.subresourceRange.baseArrayLayer = 0;
+		barrier.subresourceRange.layerCount = 1;
+	}
+	blitBarriers.at(0).image = sceneColorImage;
+	blitBarriers.at(0).oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+	blitBarriers.at(0).newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+	blitBarriers.at(0).srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+	blitBarriers.at(0).dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+	blitBarriers.at(1).image = targetImage;
+	blitBarriers.at(1).oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	blitBarriers.at(1).newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	blitBarriers.at(1).srcAccessMask = 0;
+	blitBarriers.at(1).dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	if (!renderGraphEnabled) {
+		vkCmdPipelineBarrier(
+			commandBuffer,
+			VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+			0,
+			0, nullptr,
+			0, nullptr,
+			static_cast<uint32_t>(blitBarriers.size()), blitBarriers.data()
+		);
+	}
+
+	VkImageBlit blitRegion{};
+	blitRegion.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+	blitRegion.srcSubresource.mipLevel = 0;
+	blitRegion.srcSubresource.baseArrayLayer = 0;
+	blitRegion.srcSubresource.layerCount = 1;
+	blitRegion.srcOffsets[0] = { 0, 0, 0 };
+	blitRegion.srcOffsets[1] = { static_cast<int32_t>(sceneRenderExtent.width), static_cast<int32_t>(sceneRenderExtent.height), 1 };
+	blitRegion.dstSubresource = blitRegion.srcSubresource;
+	blitRegion.dstOffsets[0] = { 0, 0, 0 };
+	blitRegion.dstOffsets[1] = { static_cast<int32_t>(vulkanSwapChainExtent.width), static_cast<int32_t>(vulkanSwapChainExtent.height), 1 };
+	vkCmdBlitImage(commandBuffer, sceneColorImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, targetImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blitRegion, VK_FILTER_LINEAR);
+
+	// Hand the target image over to presentation (or to the frame capture's copy in headless mode)
+	if (renderGraphEnabled) {
+		return;  // (the render graph's final barriers do)
+	}
+	VkImageMemoryBarrier presentBarrier = blitBarriers.at(1);
+	presentBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	presentBarrier.newLayout = options.headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+	presentBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	presentBarrier.dstAccessMask = options.headless ? VK_ACCESS_TRANSFER_READ_BIT : 0;
+	vkCmdPipelineBarrier(
+		commandBuffer,
+		VK_PIPELINE_STAGE_TRANSFER_BIT, options.headless ? VK_PIPELINE_STAGE_TRANSFER_BIT : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+		0,
+		0, nullptr,
+		0, nullptr,
+		1, &presentBarrier
+	);
+}
+
+VkImageView Application::createImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags, uint32_t baseMipLevel, uint32_t levelCount) {
+	VkImageViewCreateInfo viewInfo{};
+	viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+	viewInfo.image = image;
+	viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+	viewInfo.format = format;
+	viewInfo.subresourceRange.aspectMask = aspectFlags;
+	viewInfo.subresourceRange.baseMipLevel = baseMipLevel;
+	viewInfo.subresourceRange.levelCount = levelCount;
+	viewInfo.subresourceRange.baseArrayLayer = 0;
+	viewInfo.subresourceRange.layerCount = 1;
+
+	VkImageView imageView;
+	if (vkCreateImageView(vulkanLogicalDevice, &viewInfo, nullptr, &imageView) != VK_SUCCESS) {
+		throw std::runtime_error("failed to create texture image view!");
+	}
+
+	return imageView;
+}
+
+void Application::createTextureSampler() {
+	VkPhysicalDeviceProperties properties{};
+	vkGetPhysicalDeviceProperties(vulkanPhysicalDevice, &properties);
+
+	VkSamplerCreateInfo samplerInfo{};
+	samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+	samplerInfo.magFilter = VK_FILTER_LINEAR;
+	samplerInfo.minFilter = VK_FILTER_LINEAR;
+	samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+	samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+	samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+	samplerInfo.anisotropyEnable = VK_TRUE;
+	samplerInfo.maxAnisotropy = properties.limits.maxSamplerAnisotropy;
+	samplerInfo.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
+	samplerInfo.unnormalizedCoordinates = VK_FALSE;
+	samplerInfo.compareEnable = VK_FALSE;
+	samplerInfo.compareOp = VK_COMPARE_OP_ALWAYS;
+	samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+	samplerInfo.mipLodBias = 0.0f;
+	samplerInfo.minLod = 0.0f;
+	samplerInfo.maxLod = 0.0f;
+
+	if (vkCreateSampler(vulkanLogicalDevice, &samplerInfo, nullptr, &textureSampler) != VK_SUCCESS) {
+		throw std::runtime_error("failed to create texture sampler!");
+	}
+	std::cout << "> Created texture sampler successfully.\n";
 
 }
 
@@ -1015,13 +1963,16 @@ void Application::copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t wid
 	submitAndEndSingleTimeTransferCommands();
 }
 
-void Application::transitionImageLayout(VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout) {
+/// @brief Transitions a color image from one use to another, with the stages, accesses & layouts of the render graph's accesses.
+void Application::transitionImageLayout(VkImage image, RenderGraphAccess oldAccess, RenderGraphAccess newAccess) {
 	beginSingleTimeTransferCommands();
 
+	RenderGraphAccessInfo oldAccessInfo = RenderGraph::getAccessInfo(oldAccess);
+	RenderGraphAccessInfo newAccessInfo = RenderGraph::getAccessInfo(newAccess);
 	VkImageMemoryBarrier barrier{};
 	barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-	barrier.oldLayout = oldLayout;
-	barrier.newLayout = newLayout;
+	barrier.oldLayout = oldAccessInfo.layout;
+	barrier.newLayout = newAccessInfo.layout;
 	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
 	barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
 	barrier.image = image;
@@ -1031,26 +1982,11 @@ void Application::transitionImageLayout(VkImage image, VkFormat format, VkImageL
 	barrier.subresourceRange.baseArrayLayer = 0;
 	barrier.subresourceRange.layerCount = 1;
 
-	VkPipelineStageFlags sourceStage;
-	VkPipelineStageFlags destinationStage;
-
-	if (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) {
-		barrier.srcAccessMask = 0;
-		barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-
-		sourceStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-		destinationStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-	}
-	else if (oldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) {
-		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-		sourceStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-		destinationStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-	}
-	else {
-		throw std::invalid_argument("unsupported layout transition!");
-	}
+	// (only the old access's writes need to be made available)
+	barrier.srcAccessMask = oldAccessInfo.writes ? oldAccessInfo.access : 0;
+	barrier.dstAccessMask = newAccessInfo.access;
+	VkPipelineStageFlags sourceStage = oldAccessInfo.stages != 0 ? oldAccessInfo.stages : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+	VkPipelineStageFlags destinationStage = newAccessInfo.stages != 0 ? newAccessInfo.stages : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
 
 	vkCmdPipelineBarrier(
 		vulkanTransferCommandBuffer,
@@ -1068,9 +2004,9 @@ bool Application::isPhysicalDeviceSuitable(VkPhysicalDevice physicalDevice) {
 	// We're deeming a GPU as suitable if it has the Queue Families that we need (eg. Graphics family)
 	QueueFamilyIndices indices = findQueueFamilies(physicalDevice);
 	bool deviceExtensionsSupported = checkPhysicalDeviceExtensionsSupport(physicalDevice);
-	bool swapChainSupportAdequate{ false };
+	bool swapChainSupportAdequate{ options.headless };  // (nothing is presented in headless mode)
 
-	if (deviceExtensionsSupported) {
+	if (deviceExtensionsSupported && !options.headless) {
 		SwapChainSupportDetails swapChainSupportDetails = querySwapChainSupport(physicalDevice);
 		// If we have atleast 1 surface format and 1 presentation mode supported, thats adequate for now
 		swapChainSupportAdequate = !swapChainSupportDetails.surfaceFormats.empty() && !swapChainSupportDetails.presentationModes.empty();
@@ -1079,8 +2015,20 @@ bool Application::isPhysicalDeviceSuitable(VkPhysicalDevice physicalDevice) {
 	VkPhysicalDeviceFeatures supportedFeatures;
 	vkGetPhysicalDeviceFeatures(physicalDevice, &supportedFeatures);
 
+	// Timeline semaphores (core in Vulkan 1.2) are needed by the frame scheduler
+	VkPhysicalDeviceProperties physicalDeviceProperties{};
+	vkGetPhysicalDeviceProperties(physicalDevice, &physicalDeviceProperties);
+	VkPhysicalDeviceVulkan12Features supportedVulkan12Features{};
+	supportedVulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+	if (physicalDeviceProperties.apiVersion >= VK_API_VERSION_1_2) {
+		VkPhysicalDeviceFeatures2 supportedFeatures2{};
+		supportedFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+		supportedFeatures2.pNext = &supportedVulkan12Features;
+		vkGetPhysicalDeviceFeatures2(physicalDevice, &supportedFeatures2);
+	}
+
 	// IMPORTANT: Need to check for 'swapChainSupportAdequate' AFTER 'deviceExtensionsSupported' due to the way AND conditions work
-	return indices.isComplete() && deviceExtensionsSupported && swapChainSupportAdequate && supportedFeatures.samplerAnisotropy;
+	return indices.isComplete() && deviceExtensionsSupported && swapChainSupportAdequate && supportedFeatures.samplerAnisotropy && supportedVulkan12Features.timelineSemaphore;
 }
 
 /// @brief Finds the required Queue Family indices in the Physical-Device.
@@ -1101,8 +2049,14 @@ QueueFamilyIndices Application::findQueueFamilies(VkPhysicalDevice physicalDevic
 	size_t i{ 0 };
 	for (const auto& queueFamily : queueFamilies) {
 		// Check for presentation support by the queue family
+		// (headless mode has no surface: the graphics queue family stands in for the presentation one)
 		VkBool32 presentationSupport{ false };
-		vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, i, vulkanSurface, &presentationSupport);
+		if (options.headless) {
+			presentationSupport = (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) ? VK_TRUE : VK_FALSE;
+		}
+		else {
+			vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, i, vulkanSurface, &presentationSupport);
+		}
 
 		// Check if queue family supports graphics queue
 		if ((queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) && !foundGraphicsQueue) {
@@ -1187,6 +2141,13 @@ VkSurfaceFormatKHR Application::chooseSwapSurfaceFormat(const std::vector<VkSurf
 }
 
 VkPresentModeKHR Application::chooseSwapPresentationMode(const std::vector<VkPresentModeKHR>& availablePresentationModes) {
+	// The present mode chosen at launch wins, if the surface supports it
+	if (options.presentMode.has_value()) {
+		if (std::find(availablePresentationModes.begin(), availablePresentationModes.end(), options.presentMode.value()) != availablePresentationModes.end()) {
+			return options.presentMode.value();
+		}
+		std::cout << "> Requested present mode not supported by the surface, falling back to the default.\n";
+	}
 	// We'll prefer the MAILBOX presentation mode (suitable for desktop apps, but not for mobile apps due to power consumption & wastage of images)
 	for (const VkPresentModeKHR& presentationMode : availablePresentationModes) {
 		if (presentationMode == VK_PRESENT_MODE_MAILBOX_KHR) {
@@ -1251,8 +2212,9 @@ bool Application::checkPhysicalDeviceExtensionsSupport(VkPhysicalDevice physical
 	std::vector<VkExtensionProperties> availableExtensions(availableExtensionsCount);
 	vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &availableExtensionsCount, availableExtensions.data());
 
-	// Create a set of required extensions (copies unique contents from deviceExtensions member and stores)
-	std::set<std::string> requiredExtensions(deviceExtensions.begin(), deviceExtensions.end());
+	// Create a set of required extensions (copies unique contents from the required device extensions and stores)
+	std::vector<const char*> requiredDeviceExtensions = getRequiredDeviceExtensions();
+	std::set<std::string> requiredExtensions(requiredDeviceExtensions.begin(), requiredDeviceExtensions.end());
 
 	// Tick off all the required extensions that are already there
 	for (const auto& extension : availableExtensions) {
@@ -1263,6 +2225,33 @@ bool Application::checkPhysicalDeviceExtensionsSupport(VkPhysicalDevice physical
 	return requiredExtensions.empty();
 }
 
+/// @brief Returns the device extensions that must be supported (the swapchain isn't needed in headless mode).
+std::vector<const char*> Application::getRequiredDeviceExtensions() const {
+	std::vector<const char*> requiredExtensions{};
+	for (const char* extension : deviceExtensions) {
+		if (options.headless && strcmp(extension, VK_KHR_SWAPCHAIN_EXTENSION_NAME) == 0) {
+			continue;
+		}
+		requiredExtensions.push_back(extension);
+	}
+	return requiredExtensions;
+}
+
+/// @brief Checks if a single (optional) device extension is supported by the physical device.
+bool Application::isPhysicalDeviceExtensionSupported(VkPhysicalDevice physicalDevice, const char* extensionName) {
+	uint32_t availableExtensionsCount{};
+	vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &availableExtensionsCount, nullptr);
+	std::vector<VkExtensionProperties> availableExtensions(availableExtensionsCount);
+	vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &availableExtensionsCount, availableExtensions.data());
+
+	for (const auto& extension : availableExtensions) {
+		if (strcmp(extension.extensionName, extensionName) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
 /// @brief Creates and returns a VkShaderModule wrapper around the Spir-V compiled shader code.
 VkShaderModule Application::createShaderModule(const std::vector<char>& compiledShaderCode) {
 	VkShaderModuleCreateInfo shaderModuleCreateInfo{};
@@ -1337,6 +2326,7 @@ void Application::createVertexBuffer() {
 		bufferSize,
 		VK_BUFFER_USAGE_TRANSFER_SRC_BIT,  // Buffer can be used as Source in a memory transfer operation.
 		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+		MemoryCategory::Staging,
 		stagingBuffer,
 		stagingBufferMemory
 	);
@@ -1354,6 +2344,7 @@ void Application::createVertexBuffer() {
 		bufferSize,
 		VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
 		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+		MemoryCategory::Geometry,
 		vertexBuffer,
 		vertexBufferMemory,
 		queueFamilyIndices
@@ -1364,7 +2355,7 @@ void Application::createVertexBuffer() {
 
 	// Destroy the Staging buffer
 	vkDestroyBuffer(vulkanLogicalDevice, stagingBuffer, nullptr);
-	vkFreeMemory(vulkanLogicalDevice, stagingBufferMemory, nullptr);
+	freeDeviceMemory(stagingBufferMemory);
 
 }
 
@@ -1384,6 +2375,7 @@ void Application::createIndexBuffer() {
 		bufferSize,
 		VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
 		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+		MemoryCategory::Staging,
 		stagingBuffer,
 		stagingBufferMemory
 	);
@@ -1398,6 +2390,7 @@ void Application::createIndexBuffer() {
 		bufferSize,
 		VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
 		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+		MemoryCategory::Geometry,
 		indexBuffer,
 		indexBufferMemory,
 		queueFamilyIndices
@@ -1408,7 +2401,7 @@ void Application::createIndexBuffer() {
 
 	// Destroy the staging buffer and free the memory allocated to it
 	vkDestroyBuffer(vulkanLogicalDevice, stagingBuffer, nullptr);
-	vkFreeMemory(vulkanLogicalDevice, stagingBufferMemory, nullptr);
+	freeDeviceMemory(stagingBufferMemory);
 
 }
 
@@ -1432,6 +2425,7 @@ void Application::createUniformBuffers() {
 			uboBufferSize,
 			VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
 			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			MemoryCategory::Uniform,
 			uniformBuffers.at(i),
 			uniformBuffersMemory.at(i)
 			//queueFamilyIndices
@@ -1444,18 +2438,23 @@ void Application::createUniformBuffers() {
 
 void Application::createDescriptorPool() {
 	// Type of descriptors in our pool, plus the size of the pool
-	std::array<VkDescriptorPoolSize, 2> poolSizes{};
+	// (bindless: a single set, with the buffers of every frame & the whole texture array, allocated from an update after bind pool)
+	std::vector<VkDescriptorPoolSize> poolSizes(2);
 	poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
 	poolSizes[0].descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
 	poolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-	poolSizes[1].descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
+	poolSizes[1].descriptorCount = bindlessEnabled ? bindlessTextureCapacity : static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
+	if (bindlessEnabled) {
+		poolSizes.push_back({ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT) });
+	}
 
 	// Create the Descriptor pool
 	VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
 	descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	descriptorPoolCreateInfo.flags = bindlessEnabled ? VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT : 0;
 	descriptorPoolCreateInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
 	descriptorPoolCreateInfo.pPoolSizes = poolSizes.data();
-	descriptorPoolCreateInfo.maxSets = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
+	descriptorPoolCreateInfo.maxSets = bindlessEnabled ? 1 : static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
 
 	VkResult result = vkCreateDescriptorPool(vulkanLogicalDevice, &descriptorPoolCreateInfo, nullptr, &vulkanDescriptorPool);
 	if (result != VK_SUCCESS) {
@@ -1465,6 +2464,11 @@ void Application::createDescriptorPool() {
 }
 
 void Application::createDescriptorSets() {
+	if (bindlessEnabled) {
+		createBindlessDescriptorSet();
+		return;
+	}
+
 	// Descriptor Layout for each Descriptor Set
 	std::vector<VkDescriptorSetLayout> descriptorSetLayouts(MAX_FRAMES_IN_FLIGHT, vulkanDescriptorSetLayout);
 
@@ -1518,11 +2522,197 @@ void Application::createDescriptorSets() {
 	}
 }
 
-void Application::updateUniformBuffers(uint32_t currentImage) {
-	static auto startTime = std::chrono::high_resolution_clock::now();
+/// @brief Allocates the bindless descriptor set (the only one the scene uses), points its buffer arrays at every frame's uniform & object
+/// @brief buffers, and puts the model's texture in its slot of the texture array.
+void Application::createBindlessDescriptorSet() {
+	VkDescriptorSetAllocateInfo descriptorSetAllocInfo{};
+	descriptorSetAllocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	descriptorSetAllocInfo.descriptorPool = vulkanDescriptorPool;
+	descriptorSetAllocInfo.descriptorSetCount = 1;
+	descriptorSetAllocInfo.pSetLayouts = &vulkanDescriptorSetLayout;
+	if (vkAllocateDescriptorSets(vulkanLogicalDevice, &descriptorSetAllocInfo, &bindlessDescriptorSet) != VK_SUCCESS) {
+		throw std::runtime_error("RUNTIME ERROR: Failed to allocate the bindless Descriptor Set!");
+	}
 
-	auto currentTime = std::chrono::high_resolution_clock::now();
-	float deltaTime = std::chrono::duration<float, std::chrono::seconds::period>(currentTime - startTime).count();
+	std::vector<VkDescriptorBufferInfo> uniformBufferInfos(MAX_FRAMES_IN_FLIGHT);
+	std::vector<VkDescriptorBufferInfo> objectBufferInfos(MAX_FRAMES_IN_FLIGHT);
+	for (size_t i{ 0 }; i < MAX_FRAMES_IN_FLIGHT; i++) {
+		uniformBufferInfos.at(i) = { uniformBuffers.at(i), 0, sizeof(UniformBufferObject) };
+		objectBufferInfos.at(i) = { objectBuffers.at(i), 0, VK_WHOLE_SIZE };
+	}
+
+	std::array<VkWriteDescriptorSet, 2> descriptorWrites{};
+	descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	descriptorWrites[0].dstSet = bindlessDescriptorSet;
+	descriptorWrites[0].dstBinding = 0;
+	descriptorWrites[0].dstArrayElement = 0;
+	descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+	descriptorWrites[0].descriptorCount = static_cast<uint32_t>(uniformBufferInfos.size());
+	descriptorWrites[0].pBufferInfo = uniformBufferInfos.data();
+
+	descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	descriptorWrites[1].dstSet = bindlessDescriptorSet;
+	descriptorWrites[1].dstBinding = 1;
+	descriptorWrites[1].dstArrayElement = 0;
+	descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	descriptorWrites[1].descriptorCount = static_cast<uint32_t>(objectBufferInfos.size());
+	descriptorWrites[1].pBufferInfo = objectBufferInfos.data();
+
+	vkUpdateDescriptorSets(vulkanLogicalDevice, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+	writeBindlessTexture(BINDLESS_SCENE_TEXTURE_SLOT, textureImageView, textureSampler);
+	std::cout << "> Created Vulkan bindless descriptor set successfully.\n";
+}
+
+/// @brief Puts a texture in a slot of the bindless texture array. The array is update after bind, so this may be called while the set is
+/// @brief bound by recorded command buffers, as long as none of the pending ones samples that slot.
+void Application::writeBindlessTexture(uint32_t slot, VkImageView imageView, VkSampler sampler) {
+	if (slot >= bindlessTextureCapacity) {
+		throw std::runtime_error("RUNTIME ERROR: Bindless texture slot " + std::to_string(slot) + " exceeds the texture array's capacity!");
+	}
+	VkDescriptorImageInfo imageInfo{};
+	imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	imageInfo.imageView = imageView;
+	imageInfo.sampler = sampler;
+
+	VkWriteDescriptorSet descriptorWrite{};
+	descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	descriptorWrite.dstSet = bindlessDescriptorSet;
+	descriptorWrite.dstBinding = 2;
+	descriptorWrite.dstArrayElement = slot;
+	descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	descriptorWrite.descriptorCount = 1;
+	descriptorWrite.pImageInfo = &imageInfo;
+	vkUpdateDescriptorSets(vulkanLogicalDevice, 1, &descriptorWrite, 0, nullptr);
+	bindlessTextureCount = std::max(bindlessTextureCount, slot + 1);
+}
+
+/// @brief Binds the bindless descriptor set and selects the current frame's buffers in it. Bindings & push constants last for the
+/// @brief whole command buffer (the compute passes use the other bind point), so it's only needed once per command buffer.
+void Application::bindBindlessDescriptorSet(VkCommandBuffer commandBuffer) {
+	ScenePushConstants pushConstants{};
+	pushConstants.frameIndex = currentFrame;
+	vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkanPipelineLayout, 0, 1, &bindlessDescriptorSet, 0, nullptr);
+	vkCmdPushConstants(commandBuffer, vulkanPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(pushConstants), &pushConstants);
+}
+
+/// @brief Creates one persistently mapped per-instance vertex buffer per frame in flight (the CPU writes the current frame's one every frame).
+void Application::createInstanceBuffers() {
+	// Sized once for the largest instance count we'll ever draw, so changing the count never reallocates
+	instanceBufferCapacity = options.objectCount;
+	if (options.instanceBenchmark) {
+		instanceBufferCapacity = std::max(instanceBufferCapacity, *std::max_element(INSTANCE_BENCHMARK_COUNTS.begin(), INSTANCE_BENCHMARK_COUNTS.end()));
+	}
+	VkDeviceSize instanceBufferSize = sizeof(InstanceData) * instanceBufferCapacity;
+
+	instanceBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+	instanceBuffersMemory.resize(MAX_FRAMES_IN_FLIGHT);
+	instanceBuffersMapped.resize(MAX_FRAMES_IN_FLIGHT);
+
+	for (size_t i{ 0 }; i < MAX_FRAMES_IN_FLIGHT; i++) {
+		createBuffer(
+			vulkanLogicalDevice,
+			instanceBufferSize,
+			VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,  // also read by the GPU culling compute shader
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			MemoryCategory::Geometry,
+			instanceBuffers.at(i),
+			instanceBuffersMemory.at(i)
+		);
+
+		// Persistent Memory Mapping (written every frame, like the UBOs)
+		vkMapMemory(vulkanLogicalDevice, instanceBuffersMemory.at(i), 0, instanceBufferSize, 0, &instanceBuffersMapped.at(i));
+	}
+	std::cout << "> Created instance buffers for " << instanceBufferCapacity << " instance(s) successfully.\n";
+
+	// Bindless: the per-object data, in the same order as the instances (packed the same way with CPU culling)
+	if (bindlessEnabled) {
+		VkDeviceSize objectBufferSize = sizeof(ObjectData) * instanceBufferCapacity;
+		objectBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+		objectBuffersMemory.resize(MAX_FRAMES_IN_FLIGHT);
+		objectBuffersMapped.resize(MAX_FRAMES_IN_FLIGHT);
+		for (size_t i{ 0 }; i < MAX_FRAMES_IN_FLIGHT; i++) {
+			createBuffer(
+				vulkanLogicalDevice,
+				objectBufferSize,
+				VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+				VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+				MemoryCategory::Geometry,
+				objectBuffers.at(i),
+				objectBuffersMemory.at(i)
+			);
+			vkMapMemory(vulkanLogicalDevice, objectBuffersMemory.at(i), 0, objectBufferSize, 0, &objectBuffersMapped.at(i));
+		}
+	}
+}
+
+/// @brief Rebuilds the CPU instance list: 'instanceCount' copies of the model laid out on a square grid centered at the origin.
+void Application::setInstanceCount(uint32_t instanceCount) {
+	if (instanceCount == 0 || instanceCount > instanceBufferCapacity) {
+		throw std::runtime_error("RUNTIME ERROR: Instance count " + std::to_string(instanceCount) + " exceeds the instance buffer capacity!");
+	}
+
+	uint32_t gridColumns = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(instanceCount))));
+	uint32_t gridRows = (instanceCount + gridColumns - 1) / gridColumns;
+	float spacing = INSTANCE_GRID_SPACING_FACTOR * modelBoundsRadius;
+
+	instances.resize(instanceCount);
+	for (uint32_t i{ 0 }; i < instanceCount; i++) {
+		glm::vec3 gridPosition{
+			(static_cast<float>(i % gridColumns) - 0.5f * static_cast<float>(gridColumns - 1)) * spacing,
+			(static_cast<float>(i / gridColumns) - 0.5f * static_cast<float>(gridRows - 1)) * spacing,
+			0.0f
+		};
+		instances.at(i).model = glm::translate(glm::mat4(1.0f), gridPosition);
+	}
+	// (every object samples the model's texture, the only one loaded)
+	if (bindlessEnabled) {
+		objects.assign(instanceCount, ObjectData{ BINDLESS_SCENE_TEXTURE_SLOT });
+	}
+
+	// Half the grid diagonal, plus the model itself (its bounding sphere isn't necessarily centered at its origin)
+	float gridHalfDiagonal = 0.5f * spacing * std::sqrt(static_cast<float>((gridColumns - 1) * (gridColumns - 1) + (gridRows - 1) * (gridRows - 1)));
+	sceneBoundsRadius = gridHalfDiagonal + glm::length(modelBoundsCenter) + modelBoundsRadius;
+
+	// CPU culling bounds: the model spins around its z axis, so they must hold at every angle.
+	// The sphere center stays on the axis (its distance to it is added to the radius), the AABB is the spin bounds.
+	if (cpuCullingEnabled) {
+		glm::vec3 spinSphereCenter{ 0.0f, 0.0f, modelBoundsCenter.z };
+		float spinSphereRadius = modelBoundsRadius + glm::length(glm::vec2(modelBoundsCenter.x, modelBoundsCenter.y));
+		sceneObjects.clear();
+		sceneObjects.reserve(instanceCount);
+		for (const InstanceData& instance : instances) {
+			glm::vec3 translation = glm::vec3(instance.model[3]);
+			sceneObjects.add(translation + spinSphereCenter, spinSphereRadius, translation + modelSpinBoundsMin, translation + modelSpinBoundsMax);
+		}
+		lastVisibleObjectCount = instanceCount;
+	}
+
+	// The draw calls recorded in the cached command buffers depend on the instance count
+	invalidateCommandBufferCache();
+}
+
+/// @brief Copies the CPU instance list into the instance buffer of the current frame (only the visible instances, packed, with CPU culling).
+void Application::updateInstanceBuffer(uint32_t currentImage) {
+	if (!cpuCullingEnabled) {
+		memcpy(instanceBuffersMapped.at(currentImage), instances.data(), sizeof(InstanceData) * instances.size());
+		if (bindlessEnabled) {
+			memcpy(objectBuffersMapped.at(currentImage), objects.data(), sizeof(ObjectData) * objects.size());
+		}
+		return;
+	}
+	InstanceData* instanceBuffer = static_cast<InstanceData*>(instanceBuffersMapped.at(currentImage));
+	ObjectData* objectBuffer = bindlessEnabled ? static_cast<ObjectData*>(objectBuffersMapped.at(currentImage)) : nullptr;
+	uint32_t drawnCount{ 0 };
+	SceneObjects::forEachVisible(objectVisibilityMask, [&](uint32_t objectIndex) {
+		if (objectBuffer) {
+			objectBuffer[drawnCount] = objects[objectIndex];
+		}
+		instanceBuffer[drawnCount++] = instances[objectIndex];
+	});
+}
+
+void Application::updateUniformBuffers(uint32_t currentImage) {
+	float deltaTime = getAnimationTime();
 
 	UniformBufferObject ubo{};
 	
@@ -1541,7 +2731,42 @@ void Application::updateUniformBuffers(uint32_t currentImage) {
 		ubo.proj[1][1] *= -1;
 	}
 
+	// Multiple instances: pull the camera back (along the same direction) until the whole grid fits in view
+	if (instances.size() > 1) {
+		float fieldOfView = (MODEL_PATH == viking_room_model_path) ? glm::radians(45.0f) : glm::radians(35.0f);
+		glm::vec3 cameraPosition = glm::vec3(glm::inverse(ubo.view)[3]);
+		float cameraDistance = std::max(glm::length(cameraPosition), sceneBoundsRadius / std::sin(0.5f * fieldOfView));
+		ubo.view = glm::lookAt(glm::normalize(cameraPosition) * cameraDistance, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+		ubo.proj = glm::perspective(fieldOfView, vulkanSwapChainExtent.width / (float)vulkanSwapChainExtent.height, 0.1f, cameraDistance + sceneBoundsRadius);
+		ubo.proj[1][1] *= -1;
+	}
+
+	// Scripted camera path (its positions are in units of the scene radius, so it fits any object count)
+	if (!cameraPath.isEmpty()) {
+		float fieldOfView = (MODEL_PATH == viking_room_model_path) ? glm::radians(45.0f) : glm::radians(35.0f);
+		glm::vec3 cameraPosition{ 0.0f };
+		glm::vec3 cameraTarget{ 0.0f };
+		cameraPath.sample(deltaTime, cameraPosition, cameraTarget);
+		cameraPosition *= sceneBoundsRadius;
+		cameraTarget *= sceneBoundsRadius;
+		ubo.view = glm::lookAt(cameraPosition, cameraTarget, glm::vec3(0.0f, 0.0f, 1.0f));
+		ubo.proj = glm::perspective(fieldOfView, vulkanSwapChainExtent.width / (float)vulkanSwapChainExtent.height, 0.01f * sceneBoundsRadius, glm::length(cameraPosition) + sceneBoundsRadius);
+		ubo.proj[1][1] *= -1;
+	}
+
 	memcpy(uniformBuffersMapped[currentImage], &ubo, sizeof(ubo));
+
+	if (gpuCullingEnabled) {
+		updateCullUniforms(currentImage, ubo);
+	}
+	else if (cpuCullingEnabled) {
+		uint32_t visibleObjectCount = sceneObjects.cull(SceneObjects::extractFrustumPlanes(ubo.proj * ubo.view), objectVisibilityMask);
+		// The draws recorded in the cached command buffers cover exactly the visible instances
+		if (visibleObjectCount != lastVisibleObjectCount) {
+			invalidateCommandBufferCache();
+		}
+		lastVisibleObjectCount = visibleObjectCount;
+	}
 }
 
 
@@ -1589,6 +2814,65 @@ void Application::createTransferCommandBuffer() {
 
 }
 
+/// @brief Allocates one (initially empty) graphics command buffer per (swapchain image, frame in flight) pair.
+/// @brief These get recorded lazily by 'getCachedGraphicsCommandBuffer' and then reused until the cache is invalidated.
+void Application::createCachedGraphicsCommandBuffers() {
+	size_t cachedCommandBuffersCount = vulkanSwapChainImages.size() * MAX_FRAMES_IN_FLIGHT;
+	cachedGraphicsCommandBuffers.resize(cachedCommandBuffersCount);
+	// Generation 0 is never current, so every command buffer gets recorded on first use
+	cachedGraphicsCommandBufferGenerations.assign(cachedCommandBuffersCount, 0);
+
+	VkCommandBufferAllocateInfo cachedCommandBuffersAllocateInfo{};
+	cachedCommandBuffersAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+	cachedCommandBuffersAllocateInfo.commandPool = vulkanGraphicsCommandPool;
+	cachedCommandBuffersAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	cachedCommandBuffersAllocateInfo.commandBufferCount = static_cast<uint32_t>(cachedCommandBuffersCount);
+
+	VkResult result = vkAllocateCommandBuffers(vulkanLogicalDevice, &cachedCommandBuffersAllocateInfo, cachedGraphicsCommandBuffers.data());
+	if (result != VK_SUCCESS) {
+		throw std::runtime_error("RUNTIME ERROR: Failed to allocate the cached Graphics Command Buffers from the Graphics Command Pool!\n");
+	}
+	std::cout << "> Allocated " << cachedCommandBuffersCount << " cached graphics command buffer(s) successfully.\n";
+}
+
+/// @brief Frees the pre-recorded command buffers, through the deferred deletion queue since the frames in flight may still be executing them.
+void Application::freeCachedGraphicsCommandBuffers() {
+	if (!cachedGraphicsCommandBuffers.empty()) {
+		std::vector<VkCommandBuffer> retiredCommandBuffers;
+		retiredCommandBuffers.swap(cachedGraphicsCommandBuffers);
+		deferredDeletions.enqueue(frameTimelineValue, [this, retiredCommandBuffers]() {
+			vkFreeCommandBuffers(vulkanLogicalDevice, vulkanGraphicsCommandPool, static_cast<uint32_t>(retiredCommandBuffers.size()), retiredCommandBuffers.data());
+		});
+	}
+	cachedGraphicsCommandBuffers.clear();
+	cachedGraphicsCommandBufferGenerations.clear();
+}
+
+/// @brief Marks every pre-recorded command buffer as stale (call on swapchain recreation or whenever the scene changes).
+/// @brief Nothing is re-recorded here: each command buffer is re-recorded the next time it's needed.
+void Application::invalidateCommandBufferCache() {
+	++commandBufferCacheGeneration;
+}
+
+/// @brief Returns the pre-recorded command buffer for the current frame in flight and the given swapchain image,
+/// @brief re-recording it first if the cache has been invalidated since it was last recorded.
+VkCommandBuffer Application::getCachedGraphicsCommandBuffer(uint32_t swapChainImageIndex) {
+	size_t cacheIndex = static_cast<size_t>(swapChainImageIndex) * MAX_FRAMES_IN_FLIGHT + currentFrame;
+	VkCommandBuffer commandBuffer = cachedGraphicsCommandBuffers.at(cacheIndex);
+
+	if (cachedGraphicsCommandBufferGenerations.at(cacheIndex) != commandBufferCacheGeneration) {
+		// Safe to re-record: this command buffer is only ever submitted from the frame slot 'currentFrame',
+		// whose previous submission 'drawFrame' has already waited on.
+		// The generation is taken before recording: commands that must only run once (see 'recordHiZInitialTransition')
+		// invalidate the cache while being recorded, so that this command buffer gets re-recorded without them.
+		uint64_t recordedGeneration = commandBufferCacheGeneration;
+		vkResetCommandBuffer(commandBuffer, 0);
+		recordCommandBuffer(commandBuffer, swapChainImageIndex);
+		cachedGraphicsCommandBufferGenerations.at(cacheIndex) = recordedGeneration;
+	}
+	return commandBuffer;
+}
+
 /// @brief Function that writes the commands we want to execute into a command buffer.
 /// @param commandBuffer: The command buffer (VkCommandBuffer object) that you want to write the command to.
 /// @param swapChainImageIndex: The index of the SwapChain image that you want to write to.
@@ -1603,63 +2887,34 @@ void Application::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t sw
 		throw std::runtime_error("RUNTIME ERROR: Failed to begin recording Command Buffer!");
 	}
 
-	// Begin the Render Pass
-	VkRenderPassBeginInfo renderPassBeginInfo{};
-	renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-	renderPassBeginInfo.renderPass = vulkanRenderPass;
-	renderPassBeginInfo.framebuffer = vulkanSwapChainFramebuffers.at(swapChainImageIndex);
-	renderPassBeginInfo.renderArea.offset = { 0,0 };
-	renderPassBeginInfo.renderArea.extent = vulkanSwapChainExtent;
-
-	std::array<VkClearValue, 2> clearValues{};
-	clearValues[0].color = { {0.0f, 0.0f, 0.0f, 1.0f} };
-	clearValues[1].depthStencil = { 1.0f, 0 };
-
-	renderPassBeginInfo.pClearValues = clearValues.data();  // Clear values to use for VK_ATTACHMENT_LOAD_OP_CLEAR (black in this case)
-	renderPassBeginInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
+	// GPU profiling: the queries are reset inside the command buffer itself, so cached command buffers can be resubmitted as is
+	gpuProfiler.beginFrame(commandBuffer, currentFrame);
 
+	// Bindless: the frame's only descriptor set bind (the scene passes & their draws then just select entries by index)
+	if (bindlessEnabled) {
+		bindBindlessDescriptorSet(commandBuffer);
+	}
 
-	// Begin the render pass (commands will be embedded in the Primary command buffer itself. No usage of secondary cmd buffers)
-	vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
-
-	// Bind the Graphics Pipeline
-	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkanGraphicsPipeline);
-
-	// Bind the Vertex Buffer
-	VkBuffer vertexBuffers[] = { vertexBuffer };
-	VkDeviceSize offsets[] = { 0 };
-	vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
-
-	// Bind the Index Buffer
-	vkCmdBindIndexBuffer(commandBuffer, indexBuffer, 0, VK_INDEX_TYPE_UINT32);
-
-
-	// We specified viewport and scissor state for this pipeline to be dynamic. 
-	// So we need to set them in the command buffer before issuing our draw command.
-	VkViewport viewport{};
-	viewport.x = 0.0f;
-	viewport.y = 0.0f;
-	viewport.minDepth = 0.0f;
-	viewport.maxDepth = 1.0f;
-	viewport.width = static_cast<float>(vulkanSwapChainExtent.width);
-	viewport.height = static_cast<float>(vulkanSwapChainExtent.height);
-	vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
-
-	VkRect2D scissor{};
-	scissor.offset = { 0,0 };
-	scissor.extent = vulkanSwapChainExtent;
-	vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
-
-	// Bind descriptor sets
-	vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkanPipelineLayout, 0, 1, &vulkanDescriptorSets[currentFrame], 0, nullptr);
-
-	// Issue the Draw command for the Triangle
-	// Use 1 for instanceCount if NOT using instanced rendering
-	//vkCmdDraw(commandBuffer, static_cast<uint32_t>(vertices.size()), 1, 0, 0);
-	vkCmdDrawIndexed(commandBuffer, static_cast<uint32_t>(indices.size()), 1, 0, 0, 0);
+	if (renderGraphEnabled) {
+		// The passes & their barriers were compiled once (see 'buildRenderGraph'): only the swapchain image changes
+		buildRenderGraph();  // (rebuilt once a new Hi-Z pyramid's first frame was recorded)
+		renderGraphImageIndex = swapChainImageIndex;
+		renderGraph->setImportedImage(renderGraphSwapChainImage, vulkanSwapChainImages.at(swapChainImageIndex));
+		renderGraph->execute(commandBuffer);
+
+		// That frame's graph imported the pyramid as discarded (UNDEFINED): a pre-recorded command buffer gets re-recorded with the rebuilt graph
+		if (occlusionCullingEnabled && !hiZInitialized) {
+			hiZInitialized = true;
+			if (options.staticCommandBuffers) {
+				invalidateCommandBufferCache();
+			}
+		}
+	}
+	else {
+		recordFramePasses(commandBuffer, swapChainImageIndex);
+	}
 
-	// End the Render Pass
-	vkCmdEndRenderPass(commandBuffer);
+	gpuProfiler.endFrame(commandBuffer, currentFrame);
 
 	// Finished recording the Command Buffer:
 	result = vkEndCommandBuffer(commandBuffer);
@@ -1669,87 +2924,1217 @@ void Application::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t sw
 
 }
 
-/// @brief The render loop.
-void Application::drawFrame() {
-
-	// At the start of the frame, we want to wait until the previous frame has finished, 
-	// so that the command buffer and semaphores are available to use.
-	vkWaitForFences(vulkanLogicalDevice, 1, &inFlightFences.at(currentFrame), VK_TRUE, UINT64_MAX);
-
-	// Acquiring an image from the SwapChain
-	uint32_t swapChainImageIndex{};
-	VkResult result = vkAcquireNextImageKHR(vulkanLogicalDevice, vulkanSwapChain, UINT64_MAX, imageAvailableSemaphores.at(currentFrame), VK_NULL_HANDLE, &swapChainImageIndex);
-	if (result == VK_ERROR_OUT_OF_DATE_KHR) {
-		recreateSwapChain();
-		return;
-	}
-	else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
-		throw std::runtime_error("RUNTIME ERROR: Failed to acquire the next image from the swapchain!");
+/// @brief Records the frame's passes with their hand-written barriers (the render graph derives them instead, see 'buildRenderGraph').
+void Application::recordFramePasses(VkCommandBuffer commandBuffer, uint32_t swapChainImageIndex) {
+	// GPU culling writes this frame's indirect draw commands before the render pass begins
+	if (gpuCullingEnabled) {
+		if (occlusionCullingEnabled && !hiZInitialized) {
+			recordHiZInitialTransition(commandBuffer);
+		}
+		gpuProfiler.beginScope(commandBuffer, currentFrame, "culling");
+		recordCullingPass(commandBuffer, occlusionCullingEnabled ? CullPhase::Early : CullPhase::Frustum);
+		gpuProfiler.endScope(commandBuffer, currentFrame, "culling");
 	}
 
-	// Updating the Uniform Buffers
-	updateUniformBuffers(currentFrame);
-
-	// Only reset the fence if we are submitting work (avoiding a potential Deadlock)
-	// After waiting, we need to manually reset the fence to the 'unisgnalled' state
-	vkResetFences(vulkanLogicalDevice, 1, &inFlightFences.at(currentFrame));
-
-	// Recording the Command Buffer
-	vkResetCommandBuffer(vulkanGraphicsCommandBuffers.at(currentFrame), 0);
-	recordCommandBuffer(vulkanGraphicsCommandBuffers.at(currentFrame), swapChainImageIndex);
+	gpuProfiler.beginPipelineStatistics(commandBuffer, currentFrame);
+	recordScenePass(commandBuffer, swapChainImageIndex, false);
 
-	// Submit the command buffer:
-	VkSemaphore waitSemaphores[] = { imageAvailableSemaphores.at(currentFrame) };  // wait semaphores
-	VkSemaphore signalSemaphores[] = { renderFinishedSemaphores.at(currentFrame) };  // signal semaphores
-	VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };  // pipeline wait stages
+	// Occlusion culling: rebuild the Hi-Z pyramid from the early draws' depth, re-test what the early phase found occluded
+	// against it, and draw the disoccluded objects on top of the early draws
+	if (occlusionCullingEnabled) {
+		gpuProfiler.beginScope(commandBuffer, currentFrame, "hi-z");
+		recordHiZBuild(commandBuffer);
+		gpuProfiler.endScope(commandBuffer, currentFrame, "hi-z");
 
-	VkSubmitInfo commandBufferSubmitInfo{};  // command submit info
-	commandBufferSubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-	commandBufferSubmitInfo.waitSemaphoreCount = 1;
-	commandBufferSubmitInfo.signalSemaphoreCount = 1;
-	commandBufferSubmitInfo.pWaitSemaphores = waitSemaphores;
-	commandBufferSubmitInfo.pWaitDstStageMask = waitStages;
-	commandBufferSubmitInfo.pSignalSemaphores = signalSemaphores;
-	commandBufferSubmitInfo.pCommandBuffers = &vulkanGraphicsCommandBuffers.at(currentFrame);
-	commandBufferSubmitInfo.commandBufferCount = 1;
+		gpuProfiler.beginScope(commandBuffer, currentFrame, "late culling");
+		recordCullingPass(commandBuffer, CullPhase::Late);
+		gpuProfiler.endScope(commandBuffer, currentFrame, "late culling");
 
-	result = vkQueueSubmit(deviceGraphicsQueue, 1, &commandBufferSubmitInfo, inFlightFences.at(currentFrame));
-	if (result != VK_SUCCESS) {
-		throw std::runtime_error("RUNTIME ERROR: Failed to submit draw command buffer to graphics queue!");
+		recordScenePass(commandBuffer, swapChainImageIndex, true);
 	}
+	gpuProfiler.endPipelineStatistics(commandBuffer, currentFrame);
 
-	// Presentation
-	VkSwapchainKHR swapChains[] = { vulkanSwapChain };
-
-	VkPresentInfoKHR presentationInfo{};
-	presentationInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-	presentationInfo.pWaitSemaphores = signalSemaphores;
-	presentationInfo.waitSemaphoreCount = 1;
-	presentationInfo.pSwapchains = swapChains;
-	presentationInfo.swapchainCount = 1;  // Will almost always be only 1
-	presentationInfo.pImageIndices = &swapChainImageIndex;
-	presentationInfo.pResults = nullptr; // optional: Allows specifying a VkResult array to check for success of presentation in each swapchain
+	// Dynamic resolution: upscale the scene onto the swapchain image
+	if (dynamicResolutionEnabled) {
+		gpuProfiler.beginScope(commandBuffer, currentFrame, "upscale");
+		recordUpscale(commandBuffer, swapChainImageIndex);
+		gpuProfiler.endScope(commandBuffer, currentFrame, "upscale");
+	}
+}
 
-	result = vkQueuePresentKHR(devicePresentationQueue, &presentationInfo);
-	if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || frameBufferResized) {
-		frameBufferResized = false;
-		recreateSwapChain();
+/// @brief Records the scene's early (or occlusion late) pass. The draws are either recorded inline in the Primary command buffer,
+/// @brief or split across the worker threads (each recording a Secondary command buffer that the Primary then executes).
+/// @brief The GPU culled path is a single indirect draw, so there's nothing to split.
+void Application::recordScenePass(VkCommandBuffer commandBuffer, uint32_t swapChainImageIndex, bool latePass) {
+	bool useSecondaryCommandBuffers = recordingThreadPool && !gpuCullingEnabled && !latePass;
+	const char* scopeName = latePass ? "late render pass" : "render pass";
+	gpuProfiler.beginScope(commandBuffer, currentFrame, scopeName);
+	beginSceneRendering(commandBuffer, swapChainImageIndex, latePass, useSecondaryCommandBuffers);
+
+	if (useSecondaryCommandBuffers) {
+		recordSecondaryCommandBuffers(swapChainImageIndex);
+		vkCmdExecuteCommands(commandBuffer, activeRecordingSlotCount, &recordingSecondaryCommandBuffers.at(currentFrame * recordingSlotCount));
 	}
-	else if (result != VK_SUCCESS) {
-		throw std::runtime_error("RUNTIME ERROR: Failed to present SwapChaim images to the Queue!");
+	else {
+		recordSceneDraws(commandBuffer, 0, getDrawnObjectCount(), latePass);
 	}
 
-	// Increment the frame
-	currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
-
+	endSceneRendering(commandBuffer, swapChainImageIndex, latePass);
+	gpuProfiler.endScope(commandBuffer, currentFrame, scopeName);
 }
 
-uint32_t Application::findMemoryType(uint32_t typefilter, VkMemoryPropertyFlags properties) {
-	// Get the memory properties of the GPU
-	VkPhysicalDeviceMemoryProperties memoryProperties{};
-	vkGetPhysicalDeviceMemoryProperties(vulkanPhysicalDevice, &memoryProperties);
+/// @brief Begins the scene's (early or late) render pass. With dynamic rendering, the layout transitions & dependencies the render passes
+/// @brief declare are recorded as image barriers instead, and the rendering begins straight on the image views.
+void Application::beginSceneRendering(VkCommandBuffer commandBuffer, uint32_t swapChainImageIndex, bool latePass, bool secondaryContents) {
+	VkRect2D renderArea{};
+	renderArea.offset = { 0, 0 };
+	renderArea.extent = getSceneRenderExtent();  // (a part of the scene color image with dynamic resolution)
+	std::array<VkClearValue, 2> clearValues{};
+	clearValues[0].color = { {0.0f, 0.0f, 0.0f, 1.0f} };
+	clearValues[1].depthStencil = { 1.0f, 0 };
 
-	/*
+	if (!dynamicRenderingEnabled) {
+		VkRenderPassBeginInfo renderPassBeginInfo{};
+		renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+		renderPassBeginInfo.renderPass = latePass ? vulkanLateRenderPass : vulkanRenderPass;
+		renderPassBeginInfo.framebuffer = vulkanSwapChainFramebuffers.at(swapChainImageIndex);
+		renderPassBeginInfo.renderArea = renderArea;
+		renderPassBeginInfo.pClearValues = latePass ? nullptr : clearValues.data();  // (the late render pass loads everything)
+		renderPassBeginInfo.clearValueCount = latePass ? 0 : static_cast<uint32_t>(clearValues.size());
+		vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, secondaryContents ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE);
+		return;
+	}
+
+	VkImage colorImage = dynamicResolutionEnabled ? sceneColorImage : vulkanSwapChainImages.at(swapChainImageIndex);
+	VkImageView colorImageView = dynamicResolutionEnabled ? sceneColorImageView : vulkanSwapChainImageViews.at(swapChainImageIndex);
+	VkImageAspectFlags depthAspect = VK_IMAGE_ASPECT_DEPTH_BIT | (hasStencilComponent(sceneDepthFormat) ? VK_IMAGE_ASPECT_STENCIL_BIT : 0);
+
+	// (the render graph records these transitions itself, batched with the other barriers before the pass)
+	if (!renderGraphEnabled) {
+		// The late pass loads what the early pass (and the Hi-Z build, for the depth) left. Otherwise both attachments start over.
+		std::array<VkImageMemoryBarrier, 2> barriers{};
+		for (VkImageMemoryBarrier& barrier : barriers) {
+			barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+			barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			barrier.subresourceRange.levelCount = 1;
+			barrier.subresourceRange.layerCount = 1;
+		}
+		barriers.at(0).image = colorImage;
+		barriers.at(0).subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		barriers.at(0).oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		barriers.at(0).newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+		barriers.at(0).srcAccessMask = 0;
+		barriers.at(0).dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+		barriers.at(1).image = depthImage;
+		barriers.at(1).subresourceRange.aspectMask = depthAspect;
+		barriers.at(1).oldLayout = latePass ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED;
+		barriers.at(1).newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+		barriers.at(1).srcAccessMask = 0;
+		barriers.at(1).dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+		VkPipelineStageFlags srcStages = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+		if (dynamicResolutionEnabled) {
+			srcStages |= VK_PIPELINE_STAGE_TRANSFER_BIT;  // The previous frame's upscale blit reads the scene color image
+		}
+		if (occlusionCullingEnabled) {
+			srcStages |= VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;  // The Hi-Z build reads the depth
+		}
+		VkPipelineStageFlags dstStages = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+		// (the color attachment of the late pass is already made visible by the early pass's end)
+		uint32_t barrierCount = latePass ? 1 : 2;
+		VkImageMemoryBarrier* firstBarrier = latePass ? &barriers.at(1) : barriers.data();
+		vkCmdPipelineBarrier(commandBuffer, srcStages, dstStages, 0, 0, nullptr, 0, nullptr, barrierCount, firstBarrier);
+	}
+
+	VkRenderingAttachmentInfo colorAttachment{};
+	colorAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+	colorAttachment.imageView = colorImageView;
+	colorAttachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+	colorAttachment.resolveMode = VK_RESOLVE_MODE_NONE;
+	colorAttachment.loadOp = latePass ? VK_ATTACHMENT_LOAD_OP_LOAD : VK_ATTACHMENT_LOAD_OP_CLEAR;
+	colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+	colorAttachment.clearValue = clearValues[0];
+
+	VkRenderingAttachmentInfo depthAttachment{};
+	depthAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+	depthAttachment.imageView = depthImageView;
+	depthAttachment.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+	depthAttachment.resolveMode = VK_RESOLVE_MODE_NONE;
+	depthAttachment.loadOp = latePass ? VK_ATTACHMENT_LOAD_OP_LOAD : VK_ATTACHMENT_LOAD_OP_CLEAR;
+	depthAttachment.storeOp = (occlusionCullingEnabled && !latePass) ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+	depthAttachment.clearValue = clearValues[1];
+
+	VkRenderingInfo renderingInfo{};
+	renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO;
+	renderingInfo.flags = secondaryContents ? VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT : 0;
+	renderingInfo.renderArea = renderArea;
+	renderingInfo.layerCount = 1;
+	renderingInfo.colorAttachmentCount = 1;
+	renderingInfo.pColorAttachments = &colorAttachment;
+	renderingInfo.pDepthAttachment = &depthAttachment;
+	vkCmdBeginRendering(commandBuffer, &renderingInfo);
+}
+
+/// @brief Ends the scene's (early or late) render pass, leaving the attachments in the layouts the render passes' final layouts would.
+void Application::endSceneRendering(VkCommandBuffer commandBuffer, uint32_t swapChainImageIndex, bool latePass) {
+	if (!dynamicRenderingEnabled) {
+		vkCmdEndRenderPass(commandBuffer);
+		return;
+	}
+	vkCmdEndRendering(commandBuffer);
+	if (renderGraphEnabled) {
+		return;  // (the render graph hands the attachments over to their next uses)
+	}
+
+	std::array<VkImageMemoryBarrier, 2> barriers{};
+	for (VkImageMemoryBarrier& barrier : barriers) {
+		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.subresourceRange.levelCount = 1;
+		barrier.subresourceRange.layerCount = 1;
+	}
+	VkImageMemoryBarrier& colorBarrier = barriers.at(0);
+	colorBarrier.image = dynamicResolutionEnabled ? sceneColorImage : vulkanSwapChainImages.at(swapChainImageIndex);
+	colorBarrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+	colorBarrier.oldLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+	colorBarrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+
+	if (occlusionCullingEnabled && !latePass) {
+		// Early pass: the Hi-Z build samples the depth, then the late pass loads both attachments
+		colorBarrier.newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+		colorBarrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+		VkImageMemoryBarrier& depthBarrier = barriers.at(1);
+		depthBarrier.image = depthImage;
+		depthBarrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT | (hasStencilComponent(sceneDepthFormat) ? VK_IMAGE_ASPECT_STENCIL_BIT : 0);
+		depthBarrier.oldLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+		depthBarrier.newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+		depthBarrier.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+		depthBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
+		vkCmdPipelineBarrier(
+			commandBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+			VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT,
+			0, 0, nullptr, 0, nullptr, static_cast<uint32_t>(barriers.size()), barriers.data()
+		);
+		return;
+	}
+
+	// Last pass of the frame: presented, or copied out (headless) / blitted (dynamic resolution)
+	bool copiedOut = options.headless || dynamicResolutionEnabled;
+	colorBarrier.newLayout = copiedOut ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+	colorBarrier.dstAccessMask = copiedOut ? VK_ACCESS_TRANSFER_READ_BIT : 0;
+	vkCmdPipelineBarrier(
+		commandBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, copiedOut ? VK_PIPELINE_STAGE_TRANSFER_BIT : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+		0, 0, nullptr, 0, nullptr, 1, &colorBarrier
+	);
+}
+
+/// @brief Describes the frame as render graph passes and compiles it: the barriers between the culling, scene, Hi-Z and upscale passes
+/// @brief are derived from what each pass reads & writes, and the dynamic resolution's scene color becomes a transient image of the graph.
+/// @brief Only rebuilt along with the depth image, and once after a new Hi-Z pyramid's first frame (the swapchain image is bound at each
+/// @brief recording, see 'recordCommandBuffer').
+void Application::buildRenderGraph() {
+	bool hiZImportUpToDate = !occlusionCullingEnabled || renderGraphHiZInitialized == hiZInitialized;
+	if (renderGraph && renderGraphExtent.width == depthImageCapacity.width && renderGraphExtent.height == depthImageCapacity.height && hiZImportUpToDate) {
+		return;
+	}
+	retireRenderGraph();
+	auto graph = std::make_shared<RenderGraph>();
+
+	// The swapchain image is overwritten every frame, once the submission has waited for its acquisition (at the color attachment output stage)
+	renderGraphSwapChainImage = graph->importImage(
+		"swapchain image", VK_NULL_HANDLE, VK_IMAGE_ASPECT_COLOR_BIT, 1,
+		RenderGraphAccess::ColorAttachmentWrite, options.headless ? RenderGraphAccess::TransferRead : RenderGraphAccess::Present, true
+	);
+	// The depth is cleared every frame, and only read within it (by the Hi-Z build)
+	VkImageAspectFlags depthAspect = VK_IMAGE_ASPECT_DEPTH_BIT | (hasStencilComponent(sceneDepthFormat) ? VK_IMAGE_ASPECT_STENCIL_BIT : 0);
+	RenderGraph::ResourceId depth = graph->importImage("depth", depthImage, depthAspect, 1, RenderGraphAccess::DepthAttachmentReadWrite, std::nullopt, true);
+	RenderGraph::ResourceId colorTarget = renderGraphSwapChainImage;
+	if (dynamicResolutionEnabled) {
+		colorTarget = graph->createTransientImage(
+			"scene color", depthImageCapacity, vulkanSwapChainImageFormat, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, VK_IMAGE_ASPECT_COLOR_BIT
+		);
+	}
+	// The culling's draw commands, counts & occlusion state (the counts are read back by the CPU once the frame is done)
+	RenderGraph::ResourceId cullBuffers{ 0 };
+	if (gpuCullingEnabled) {
+		cullBuffers = graph->importBuffer("culling buffers", RenderGraphAccess::None, RenderGraphAccess::HostRead);
+	}
+	// The Hi-Z pyramid is kept from one frame to the next (the early culling tests against the previous frame's).
+	// A new pyramid is still UNDEFINED: its first frame discards it, and the graph is then rebuilt to keep it.
+	RenderGraph::ResourceId hiZ{ 0 };
+	if (occlusionCullingEnabled) {
+		hiZ = graph->importImage(
+			"hi-z pyramid", hiZImage, VK_IMAGE_ASPECT_COLOR_BIT, static_cast<uint32_t>(hiZLevelViews.size()),
+			hiZInitialized ? RenderGraphAccess::ComputeRead : RenderGraphAccess::None, RenderGraphAccess::ComputeRead, !hiZInitialized
+		);
+	}
+
+	if (gpuCullingEnabled) {
+		std::vector<RenderGraph::Use> cullingUses = { { cullBuffers, RenderGraphAccess::ComputeReadWrite } };
+		if (occlusionCullingEnabled) {
+			cullingUses.push_back({ hiZ, RenderGraphAccess::ComputeRead });
+		}
+		graph->addPass("culling", cullingUses, [this](VkCommandBuffer commandBuffer) {
+			gpuProfiler.beginScope(commandBuffer, currentFrame, "culling");
+			recordCullingPass(commandBuffer, occlusionCullingEnabled ? CullPhase::Early : CullPhase::Frustum);
+			gpuProfiler.endScope(commandBuffer, currentFrame, "culling");
+		});
+	}
+	std::vector<RenderGraph::Use> sceneUses = { { colorTarget, RenderGraphAccess::ColorAttachmentWrite }, { depth, RenderGraphAccess::DepthAttachmentWrite } };
+	if (gpuCullingEnabled) {
+		sceneUses.push_back({ cullBuffers, RenderGraphAccess::IndirectRead });
+	}
+	graph->addPass("scene", sceneUses, [this](VkCommandBuffer commandBuffer) {
+		gpuProfiler.beginPipelineStatistics(commandBuffer, currentFrame);
+		recordScenePass(commandBuffer, renderGraphImageIndex, false);
+		if (!occlusionCullingEnabled) {
+			gpuProfiler.endPipelineStatistics(commandBuffer, currentFrame);
+		}
+	});
+	if (occlusionCullingEnabled) {
+		graph->addPass("hi-z build", { { depth, RenderGraphAccess::DepthSampledRead }, { hiZ, RenderGraphAccess::ComputeWrite } }, [this](VkCommandBuffer commandBuffer) {
+			gpuProfiler.beginScope(commandBuffer, currentFrame, "hi-z");
+			recordHiZBuild(commandBuffer);
+			gpuProfiler.endScope(commandBuffer, currentFrame, "hi-z");
+		});
+		graph->addPass("late culling", { { hiZ, RenderGraphAccess::ComputeRead }, { cullBuffers, RenderGraphAccess::ComputeReadWrite } }, [this](VkCommandBuffer commandBuffer) {
+			gpuProfiler.beginScope(commandBuffer, currentFrame, "late culling");
+			recordCullingPass(commandBuffer, CullPhase::Late);
+			gpuProfiler.endScope(commandBuffer, currentFrame, "late culling");
+		});
+		std::vector<RenderGraph::Use> lateSceneUses = {
+			{ colorTarget, RenderGraphAccess::ColorAttachmentReadWrite }, { depth, RenderGraphAccess::DepthAttachmentReadWrite }, { cullBuffers, RenderGraphAccess::IndirectRead }
+		};
+		graph->addPass("late scene", lateSceneUses, [this](VkCommandBuffer commandBuffer) {
+			recordScenePass(commandBuffer, renderGraphImageIndex, true);
+			gpuProfiler.endPipelineStatistics(commandBuffer, currentFrame);
+		});
+	}
+	if (dynamicResolutionEnabled) {
+		graph->addPass("upscale", { { colorTarget, RenderGraphAccess::TransferRead }, { renderGraphSwapChainImage, RenderGraphAccess::TransferWrite } }, [this](VkCommandBuffer commandBuffer) {
+			gpuProfiler.beginScope(commandBuffer, currentFrame, "upscale");
+			recordUpscale(commandBuffer, renderGraphImageIndex);
+			gpuProfiler.endScope(commandBuffer, currentFrame, "upscale");
+		});
+	}
+	graph->compile(vulkanLogicalDevice, transientAllocator);
+
+	const TransientBlock& transientBlock = graph->getTransientBlock();
+	if (transientBlock.memory != VK_NULL_HANDLE) {
+		memoryTelemetry.trackAllocation(transientBlock.memory, MemoryCategory::Attachment, transientBlock.size, transientBlock.memoryTypeIndex);
+		StartupProfiler::recordDeviceMemoryAllocation(transientBlock.size);
+	}
+	if (dynamicResolutionEnabled) {
+		sceneColorImage = graph->getImage(colorTarget);
+		sceneColorImageView = graph->getImageView(colorTarget);
+		sceneColorImageCapacity = depthImageCapacity;
+	}
+	renderGraph = graph;
+	renderGraphExtent = depthImageCapacity;
+	renderGraphHiZInitialized = hiZInitialized;
+	renderGraph->logSummary(std::cout);
+
+	if (!options.renderGraphDumpPath.empty()) {
+		std::ofstream dumpFile(options.renderGraphDumpPath);
+		renderGraph->writeSchedule(dumpFile);
+		if (!dumpFile) {
+			std::cerr << "WARNING: Failed to write the render graph schedule to '" << options.renderGraphDumpPath << "'!\n";
+		}
+		else {
+			std::cout << "> Wrote the render graph schedule to '" << options.renderGraphDumpPath << "'.\n";
+		}
+	}
+}
+
+/// @brief Hands the render graph (with its transient images & their memory) over to the deferred deletion queue, since the frames in flight may still be using it.
+void Application::retireRenderGraph() {
+	if (!renderGraph) {
+		return;
+	}
+	std::shared_ptr<RenderGraph> retiredGraph = std::move(renderGraph);
+	deferredDeletions.enqueue(frameTimelineValue, [this, retiredGraph]() {
+		VkDeviceMemory transientMemory = retiredGraph->getTransientBlock().memory;
+		retiredGraph->destroy(vulkanLogicalDevice);
+		if (transientMemory != VK_NULL_HANDLE) {
+			freeDeviceMemory(transientMemory);
+		}
+	});
+
+	renderGraph.reset();
+	sceneColorImage = VK_NULL_HANDLE;
+	sceneColorImageView = VK_NULL_HANDLE;
+}
+
+/// @brief Binds the scene state and records the draws of the objects in [firstObject, firstObject + objectCount).
+/// @brief Must be called inside the render pass (either inline in the Primary command buffer, or in a Secondary one).
+/// @brief 'lateDraws' selects the occlusion culling's late phase draws (GPU culling only).
+void Application::recordSceneDraws(VkCommandBuffer commandBuffer, uint32_t firstObject, uint32_t objectCount, bool lateDraws) {
+	// Bind the Graphics Pipeline (the generic variant until the scene's variant is compiled)
+	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineRegistry.getPipeline(scenePipelineKey));
+
+	// Bind the Vertex Buffer (binding 0) and this frame's Instance Buffer (binding 1)
+	VkBuffer vertexBuffers[] = { vertexBuffer, instanceBuffers.at(currentFrame) };
+	VkDeviceSize offsets[] = { 0, 0 };
+	vkCmdBindVertexBuffers(commandBuffer, 0, 2, vertexBuffers, offsets);
+
+	// Bind the Index Buffer
+	vkCmdBindIndexBuffer(commandBuffer, indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+
+
+	// We specified viewport and scissor state for this pipeline to be dynamic. 
+	// So we need to set them in the command buffer before issuing our draw command.
+	// (With dynamic resolution, both only cover the part of the scene color image rendered at the current scale.)
+	VkExtent2D sceneRenderExtent = getSceneRenderExtent();
+	VkViewport viewport{};
+	viewport.x = 0.0f;
+	viewport.y = 0.0f;
+	viewport.minDepth = 0.0f;
+	viewport.maxDepth = 1.0f;
+	viewport.width = static_cast<float>(sceneRenderExtent.width);
+	viewport.height = static_cast<float>(sceneRenderExtent.height);
+	vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+
+	VkRect2D scissor{};
+	scissor.offset = { 0,0 };
+	scissor.extent = sceneRenderExtent;
+	vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+	// Bind descriptor sets (bindless: bound once for the whole command buffer, see 'bindBindlessDescriptorSet')
+	if (!bindlessEnabled) {
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkanPipelineLayout, 0, 1, &vulkanDescriptorSets[currentFrame], 0, nullptr);
+	}
+
+	// Issue the Draw command(s) for the model
+	// Instanced: a single draw call for every object. Otherwise one draw call per object ('firstInstance' selects its transform).
+	//vkCmdDraw(commandBuffer, static_cast<uint32_t>(vertices.size()), 1, 0, 0);
+	uint32_t instanceCount = static_cast<uint32_t>(instances.size());  // (the GPU culled draws always cover every object)
+	VkDeviceSize drawCommandStride = sizeof(VkDrawIndexedIndirectCommand);
+	// (the late phase's draw commands start at the instance buffer capacity, and its draw count is the second counter)
+	VkDeviceSize drawCommandOffset = lateDraws ? drawCommandStride * instanceBufferCapacity : 0;
+	VkDeviceSize drawCountOffset = lateDraws ? sizeof(uint32_t) : 0;
+	if (gpuCullingEnabled && drawIndirectCountSupported) {
+		// The visible draws are packed at the front of the buffer, and the GPU knows how many there are
+		vkCmdDrawIndexedIndirectCount(commandBuffer, indirectDrawBuffers.at(currentFrame), drawCommandOffset, drawCountBuffers.at(currentFrame), drawCountOffset, instanceCount, static_cast<uint32_t>(drawCommandStride));
+	}
+	else if (gpuCullingEnabled && multiDrawIndirectSupported) {
+		// One draw per object, the culled ones have an instance count of 0
+		vkCmdDrawIndexedIndirect(commandBuffer, indirectDrawBuffers.at(currentFrame), drawCommandOffset, instanceCount, static_cast<uint32_t>(drawCommandStride));
+	}
+	else if (gpuCullingEnabled) {
+		for (uint32_t objectIndex{ 0 }; objectIndex < instanceCount; objectIndex++) {
+			vkCmdDrawIndexedIndirect(commandBuffer, indirectDrawBuffers.at(currentFrame), drawCommandOffset + objectIndex * drawCommandStride, 1, static_cast<uint32_t>(drawCommandStride));
+		}
+	}
+	else if (options.instancedRendering) {
+		vkCmdDrawIndexed(commandBuffer, static_cast<uint32_t>(indices.size()), objectCount, 0, 0, firstObject);
+	}
+	else {
+		for (uint32_t objectIndex{ firstObject }; objectIndex < firstObject + objectCount; objectIndex++) {
+			vkCmdDrawIndexed(commandBuffer, static_cast<uint32_t>(indices.size()), 1, 0, 0, objectIndex);
+		}
+	}
+}
+
+/// @brief Creates the worker threads, and a command pool (with one secondary command buffer) per worker slot and frame in flight.
+/// @brief Command pools are externally synchronized, so every slot needs its own to record in parallel.
+void Application::createRecordingThreadResources() {
+	// The benchmark needs enough slots for its largest thread count
+	recordingSlotCount = options.recordThreadCount;
+	if (options.recordingBenchmark) {
+		recordingSlotCount = std::max(recordingSlotCount, std::max(1u, std::thread::hardware_concurrency()));
+	}
+	activeRecordingSlotCount = std::max(1u, options.recordThreadCount);
+	activeRecordingSlotCount = std::min(activeRecordingSlotCount, recordingSlotCount);
+	recordingThreadPool = std::make_unique<ThreadPool>(recordingSlotCount);
+
+	QueueFamilyIndices queueFamilies = findQueueFamilies(vulkanPhysicalDevice);
+	VkCommandPoolCreateInfo commandPoolCreateInfo{};
+	commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+	// The whole pool is reset every time its frame comes around, instead of its individual command buffers
+	commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+	commandPoolCreateInfo.queueFamilyIndex = queueFamilies.graphicsFamily.value();
+
+	size_t slotCount = static_cast<size_t>(recordingSlotCount) * MAX_FRAMES_IN_FLIGHT;
+	recordingCommandPools.resize(slotCount);
+	recordingSecondaryCommandBuffers.resize(slotCount);
+	for (size_t i{ 0 }; i < slotCount; i++) {
+		if (vkCreateCommandPool(vulkanLogicalDevice, &commandPoolCreateInfo, nullptr, &recordingCommandPools.at(i)) != VK_SUCCESS) {
+			throw std::runtime_error("RUNTIME ERROR: Failed to create a recording thread command pool!");
+		}
+
+		VkCommandBufferAllocateInfo secondaryCommandBufferAllocateInfo{};
+		secondaryCommandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		secondaryCommandBufferAllocateInfo.commandPool = recordingCommandPools.at(i);
+		secondaryCommandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+		secondaryCommandBufferAllocateInfo.commandBufferCount = 1;
+		if (vkAllocateCommandBuffers(vulkanLogicalDevice, &secondaryCommandBufferAllocateInfo, &recordingSecondaryCommandBuffers.at(i)) != VK_SUCCESS) {
+			throw std::runtime_error("RUNTIME ERROR: Failed to allocate a recording thread secondary command buffer!");
+		}
+	}
+	std::cout << "> Created " << recordingSlotCount << " recording thread(s) with per-frame command pools successfully.\n";
+}
+
+void Application::destroyRecordingThreadResources() {
+	// Stop the workers first (joins the threads)
+	recordingThreadPool.reset();
+	for (VkCommandPool commandPool : recordingCommandPools) {
+		vkDestroyCommandPool(vulkanLogicalDevice, commandPool, nullptr);
+	}
+	recordingCommandPools.clear();
+	recordingSecondaryCommandBuffers.clear();
+}
+
+/// @brief Splits the draws into 'activeRecordingSlotCount' slices, and records each slice into a secondary command buffer on a worker thread.
+/// @brief The current frame slot must have been waited on (its command pools get reset).
+void Application::recordSecondaryCommandBuffers(uint32_t swapChainImageIndex) {
+	uint32_t objectCount = getDrawnObjectCount();
+	uint32_t slotCount = activeRecordingSlotCount;
+
+	recordingThreadPool->dispatch(slotCount, [this, swapChainImageIndex, objectCount, slotCount](uint32_t slot) {
+		TraceScope traceScope("recordSecondaryCommandBuffer");
+		size_t slotIndex = static_cast<size_t>(currentFrame) * recordingSlotCount + slot;
+		VkCommandBuffer secondaryCommandBuffer = recordingSecondaryCommandBuffers.at(slotIndex);
+		vkResetCommandPool(vulkanLogicalDevice, recordingCommandPools.at(slotIndex), 0);
+
+		// Secondary command buffers executed inside a render pass need to know which render pass & framebuffer they continue
+		// (with dynamic rendering, the formats of the attachments being rendered into)
+		VkCommandBufferInheritanceRenderingInfo inheritanceRenderingInfo{};
+		inheritanceRenderingInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO;
+		inheritanceRenderingInfo.colorAttachmentCount = 1;
+		inheritanceRenderingInfo.pColorAttachmentFormats = &vulkanSwapChainImageFormat;
+		inheritanceRenderingInfo.depthAttachmentFormat = sceneDepthFormat;
+		inheritanceRenderingInfo.stencilAttachmentFormat = VK_FORMAT_UNDEFINED;
+		inheritanceRenderingInfo.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+		VkCommandBufferInheritanceInfo inheritanceInfo{};
+		inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+		inheritanceInfo.renderPass = vulkanRenderPass;
+		inheritanceInfo.subpass = 0;
+		if (dynamicRenderingEnabled) {
+			inheritanceInfo.pNext = &inheritanceRenderingInfo;
+			inheritanceInfo.renderPass = VK_NULL_HANDLE;
+		}
+		else {
+			inheritanceInfo.framebuffer = vulkanSwapChainFramebuffers.at(swapChainImageIndex);
+		}
+		inheritanceInfo.pipelineStatistics = gpuProfiler.getInheritedPipelineStatistics();  // executed inside the pipeline statistics query
+
+		VkCommandBufferBeginInfo beginInfo{};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		beginInfo.pInheritanceInfo = &inheritanceInfo;
+		if (vkBeginCommandBuffer(secondaryCommandBuffer, &beginInfo) != VK_SUCCESS) {
+			throw std::runtime_error("RUNTIME ERROR: Failed to begin recording a secondary Command Buffer!");
+		}
+
+		// Even split of the draws (the first 'objectCount % slotCount' slices get one extra)
+		uint32_t sliceSize = objectCount / slotCount;
+		uint32_t remainder = objectCount % slotCount;
+		uint32_t firstObject = slot * sliceSize + std::min(slot, remainder);
+		uint32_t sliceObjectCount = sliceSize + (slot < remainder ? 1 : 0);
+		if (sliceObjectCount > 0) {
+			// (secondary command buffers don't inherit the primary's bindings)
+			if (bindlessEnabled) {
+				bindBindlessDescriptorSet(secondaryCommandBuffer);
+			}
+			recordSceneDraws(secondaryCommandBuffer, firstObject, sliceObjectCount);
+		}
+
+		if (vkEndCommandBuffer(secondaryCommandBuffer) != VK_SUCCESS) {
+			throw std::runtime_error("RUNTIME ERROR: Failed to record a secondary Command Buffer!");
+		}
+	});
+}
+
+/// @brief Records a synthetic scene (one draw per object) with an increasing number of recording threads,
+/// @brief and reports the average CPU time spent recording each frame.
+void Application::runRecordingBenchmark() {
+	std::vector<uint32_t> threadCounts{};
+	for (uint32_t threadCount{ 1 }; threadCount < recordingSlotCount; threadCount *= 2) {
+		threadCounts.push_back(threadCount);
+	}
+	threadCounts.push_back(recordingSlotCount);
+
+	std::cout << "\n> Recording benchmark (" << instances.size() << " draws, " << recordingSlotCount << " hardware threads):\n";
+	double singleThreadRecordingTimeMs{ 0.0 };
+	for (uint32_t threadCount : threadCounts) {
+		activeRecordingSlotCount = threadCount;
+
+		double recordingTimeMs{ 0.0 };
+		for (uint32_t frame{ 0 }; frame < RECORDING_BENCHMARK_WARMUP_FRAMES + RECORDING_BENCHMARK_MEASURED_FRAMES; frame++) {
+			if (isWindowCloseRequested()) {
+				std::cout << "> Recording benchmark interrupted.\n";
+				return;
+			}
+			pollInput();
+			drawFrame();
+			if (frame >= RECORDING_BENCHMARK_WARMUP_FRAMES) {
+				recordingTimeMs += lastFrameSample[FrameMetric::Record];
+			}
+		}
+		recordingTimeMs /= RECORDING_BENCHMARK_MEASURED_FRAMES;
+		if (threadCount == 1) {
+			singleThreadRecordingTimeMs = recordingTimeMs;
+		}
+
+		std::cout << std::fixed << std::setprecision(3)
+			<< "\t" << std::setw(3) << threadCount << " thread(s): " << recordingTimeMs << " ms/frame"
+			<< " (speedup x" << std::setprecision(2) << singleThreadRecordingTimeMs / recordingTimeMs << ")\n" << std::defaultfloat;
+	}
+	std::cout << "> Recording benchmark finished.\n";
+}
+
+/// @brief The render loop.
+void Application::drawFrame() {
+	TraceScope frameTraceScope("drawFrame");
+	auto frameStartTime = std::chrono::steady_clock::now();
+	FrameSample frameSample{};
+	frameSample.frameNumber = frameNumber;
+
+	// At the start of the frame, we want to wait until the previous frame has finished, 
+	// so that the command buffer and semaphores are available to use.
+	{
+		TraceScope traceScope("waitForFrameSlot");
+		frameSample[FrameMetric::FrameWait] = waitForFrameSlot(currentFrame);
+	}
+
+	// The previous submission of this frame has finished (frames-in-flight frames ago), so its GPU queries (and visible object count) are ready
+	if (gpuProfiler.collect(currentFrame) && Tracer::isEnabled()) {
+		traceGpuFrame(gpuProfiler.getLastResult());
+	}
+	readVisibleObjectCount(currentFrame);
+	updateResolutionScale();
+
+	// A pipeline variant finished compiling: the pre-recorded command buffers may still bind its fallback
+	uint64_t registryReadyGeneration = pipelineRegistry.getReadyGeneration();
+	if (registryReadyGeneration != pipelineReadyGeneration) {
+		pipelineReadyGeneration = registryReadyGeneration;
+		invalidateCommandBufferCache();
+	}
+
+	// Acquiring an image from the SwapChain (in headless mode, every frame slot renders into its own offscreen image)
+	uint32_t swapChainImageIndex{};
+	VkResult result{ VK_SUCCESS };
+	auto acquireStartTime = std::chrono::steady_clock::now();
+	if (options.headless) {
+		swapChainImageIndex = currentFrame;
+	}
+	else {
+		TraceScope traceScope("vkAcquireNextImageKHR");
+		result = vkAcquireNextImageKHR(vulkanLogicalDevice, vulkanSwapChain, UINT64_MAX, imageAvailableSemaphores.at(currentFrame), VK_NULL_HANDLE, &swapChainImageIndex);
+		if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+			// Nothing can be rendered to this swapchain anymore. While the window is still being resized,
+			// skip the frame rather than recreating the swapchain for every intermediate size.
+			frameBufferResized = true;
+			if (isResizeSettled()) {
+				frameBufferResized = false;
+				recreateSwapChain();
+			}
+			return;
+		}
+		else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
+			throw std::runtime_error("RUNTIME ERROR: Failed to acquire the next image from the swapchain!");
+		}
+	}
+
+	auto cpuFrameStartTime = std::chrono::steady_clock::now();
+	frameSample[FrameMetric::AcquireWait] = std::chrono::duration<double, std::milli>(cpuFrameStartTime - acquireStartTime).count();
+
+	// Updating the Uniform Buffers and the Instance Buffer
+	{
+		TraceScope traceScope("updateUniformBuffers");
+		updateUniformBuffers(currentFrame);
+	}
+	{
+		TraceScope traceScope("updateInstanceBuffer");
+		updateInstanceBuffer(currentFrame);
+	}
+
+	// Recording the Command Buffer (or fetching the pre-recorded one, which only changes on swapchain recreation / scene changes)
+	auto commandRecordingStartTime = std::chrono::steady_clock::now();
+	VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+	if (options.staticCommandBuffers) {
+		commandBuffer = getCachedGraphicsCommandBuffer(swapChainImageIndex);
+	}
+	else {
+		TraceScope traceScope("recordCommandBuffer");
+		commandBuffer = vulkanGraphicsCommandBuffers.at(currentFrame);
+		vkResetCommandBuffer(commandBuffer, 0);
+		recordCommandBuffer(commandBuffer, swapChainImageIndex);
+	}
+	frameSample[FrameMetric::Record] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - commandRecordingStartTime).count();
+
+	// Frame capture: a second command buffer copies the rendered image into the next readback slot
+	// (if that slot is still busy the frame isn't captured, the render loop never waits on readback)
+	std::array<VkCommandBuffer, 2> submittedCommandBuffers{ commandBuffer, VK_NULL_HANDLE };
+	uint32_t submittedCommandBufferCount{ 1 };
+	std::optional<uint32_t> captureSlot;
+	if (frameCapture.isRunning()) {
+		captureSlot = frameCapture.acquireSlot();
+		if (captureSlot.has_value()) {
+			VkCommandBuffer captureCommandBuffer = captureCommandBuffers.at(currentFrame);
+			vkResetCommandBuffer(captureCommandBuffer, 0);
+			recordCaptureCommands(captureCommandBuffer, swapChainImageIndex, captureSlot.value());
+			submittedCommandBuffers.at(submittedCommandBufferCount++) = captureCommandBuffer;
+		}
+	}
+
+	// Submit the command buffer:
+	// Signals the binary semaphore presentation waits on, and the next value of the frame timeline semaphore
+	VkSemaphore waitSemaphores[] = { imageAvailableSemaphores.at(currentFrame) };  // wait semaphores
+	VkSemaphore signalSemaphores[] = { renderFinishedSemaphores.at(currentFrame), frameTimelineSemaphore };  // signal semaphores
+	VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };  // pipeline wait stages
+	uint64_t frameSignalValue = frameTimelineValue + 1;
+	uint64_t signalValues[] = { 0, frameSignalValue };  // (the value of a binary semaphore is ignored)
+	// Headless frames have no image to wait for nor to present, so they only signal the timeline semaphore
+	uint32_t firstSignalSemaphore = options.headless ? 1 : 0;
+
+	VkTimelineSemaphoreSubmitInfo timelineSubmitInfo{};
+	timelineSubmitInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+	timelineSubmitInfo.pSignalSemaphoreValues = signalValues + firstSignalSemaphore;
+	timelineSubmitInfo.signalSemaphoreValueCount = 2 - firstSignalSemaphore;
+
+	VkSubmitInfo commandBufferSubmitInfo{};  // command submit info
+	commandBufferSubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	commandBufferSubmitInfo.pNext = &timelineSubmitInfo;
+	commandBufferSubmitInfo.waitSemaphoreCount = options.headless ? 0 : 1;
+	commandBufferSubmitInfo.signalSemaphoreCount = 2 - firstSignalSemaphore;
+	commandBufferSubmitInfo.pWaitSemaphores = waitSemaphores;
+	commandBufferSubmitInfo.pWaitDstStageMask = waitStages;
+	commandBufferSubmitInfo.pSignalSemaphores = signalSemaphores + firstSignalSemaphore;
+	commandBufferSubmitInfo.pCommandBuffers = submittedCommandBuffers.data();
+	commandBufferSubmitInfo.commandBufferCount = submittedCommandBufferCount;
+
+	{
+		TraceScope traceScope("vkQueueSubmit");
+		result = vkQueueSubmit(deviceGraphicsQueue, 1, &commandBufferSubmitInfo, VK_NULL_HANDLE);
+	}
+	if (result != VK_SUCCESS) {
+		throw std::runtime_error("RUNTIME ERROR: Failed to submit draw command buffer to graphics queue!");
+	}
+	frameTimelineValue = frameSignalValue;
+	frameSlotTimelineValues.at(currentFrame) = frameSignalValue;
+	frameSlotInputTimes.at(currentFrame) = lastInputPollTime;
+	frameSlotLatencyPending.at(currentFrame) = true;
+	gpuProfiler.markSubmitted(currentFrame, frameNumber);
+	if (captureSlot.has_value()) {
+		frameCapture.markSubmitted(captureSlot.value(), frameNumber, frameSignalValue);
+	}
+	if (gpuCullingEnabled) {
+		drawCountsSubmitted.at(currentFrame) = true;
+	}
+	frameSample[FrameMetric::CpuWork] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - cpuFrameStartTime).count();
+
+	// Presentation (nothing to present in headless mode)
+	if (!options.headless) {
+		VkSwapchainKHR swapChains[] = { vulkanSwapChain };
+
+		VkPresentInfoKHR presentationInfo{};
+		presentationInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+		presentationInfo.pWaitSemaphores = signalSemaphores;  // (only the binary one)
+		presentationInfo.waitSemaphoreCount = 1;
+		presentationInfo.pSwapchains = swapChains;
+		presentationInfo.swapchainCount = 1;  // Will almost always be only 1
+		presentationInfo.pImageIndices = &swapChainImageIndex;
+		presentationInfo.pResults = nullptr; // optional: Allows specifying a VkResult array to check for success of presentation in each swapchain
+
+		auto presentStartTime = std::chrono::steady_clock::now();
+		{
+			TraceScope traceScope("vkQueuePresentKHR");
+			result = vkQueuePresentKHR(devicePresentationQueue, &presentationInfo);
+		}
+		frameSample[FrameMetric::Present] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - presentStartTime).count();
+		if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || frameBufferResized) {
+			// Debounced: the swapchain is only recreated once the window size has settled
+			frameBufferResized = true;
+			if (isResizeSettled()) {
+				frameBufferResized = false;
+				recreateSwapChain();
+			}
+		}
+		else if (result != VK_SUCCESS) {
+			throw std::runtime_error("RUNTIME ERROR: Failed to present SwapChaim images to the Queue!");
+		}
+	}
+
+	// Increment the frame
+	currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+
+	// Frame statistics (the GPU time & input latency are those of the most recently completed frame)
+	frameSample[FrameMetric::GpuFrame] = gpuProfiler.getLastResult().frameTimeMs;
+	frameSample[FrameMetric::GpuRenderPass] = std::max(gpuProfiler.getLastScopeTimeMs("render pass"), 0.0);
+	frameSample[FrameMetric::InputLatency] = lastInputLatencyMs;
+	frameSample[FrameMetric::ResolutionScale] = dynamicResolutionEnabled ? resolutionScale : 1.0;
+	frameSample[FrameMetric::CpuFrame] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStartTime).count();
+	frameStats.record(frameSample);
+	lastFrameSample = frameSample;
+	frameNumber++;
+	if (FRAME_STATS_REPORT_INTERVAL_FRAMES > 0 && frameNumber % FRAME_STATS_REPORT_INTERVAL_FRAMES == 0) {
+		logFrameStats();
+	}
+}
+
+/// @brief Prints the frame configuration and the rolling frame statistics.
+void Application::logFrameStats() {
+	std::cout << "\n> Frame configuration: " << MAX_FRAMES_IN_FLIGHT << " frames in flight, " << (options.headless ? "headless" : getPresentModeName(vulkanSwapChainPresentMode)) << ", "
+		<< (options.staticCommandBuffers ? "static command buffers" : recordingThreadPool ? std::to_string(activeRecordingSlotCount) + " recording threads" : "re-recorded every frame") << ", "
+		<< instances.size() << " objects (" << (gpuCullingEnabled ? "GPU culled" : cpuCullingEnabled ? "CPU culled" : options.instancedRendering ? "instanced" : "one draw per object") << ")";
+	if (gpuCullingEnabled || cpuCullingEnabled) {
+		std::cout << ", " << lastVisibleObjectCount << " visible";
+	}
+	if (occlusionCullingEnabled) {
+		double occludedPercent = lastFrustumVisibleObjectCount > 0 ? 100.0 * lastOccludedObjectCount / lastFrustumVisibleObjectCount : 0.0;
+		std::cout << ", " << lastOccludedObjectCount << " occluded (" << occludedPercent << "% of the " << lastFrustumVisibleObjectCount << " in the frustum)";
+	}
+	if (dynamicResolutionEnabled) {
+		std::cout << ", dynamic resolution (scale " << resolutionScale << ", target " << options.targetGpuFrameMs << " ms)";
+	}
+	std::cout << ", " << getDescriptorSetBindsPerFrame() << " descriptor set bind(s) per frame" << (bindlessEnabled ? " (bindless, " + std::to_string(bindlessTextureCount) + " texture(s))" : "");
+	frameStats.logReport(std::cout);
+	gpuProfiler.logReport(std::cout);
+}
+
+/// @brief Adds the GPU frame and its scopes (as read back by the GPU profiler) to the trace.
+void Application::traceGpuFrame(const GpuFrameResult& result) {
+	if (result.frameBeginNs != 0) {
+		Tracer::addGpuEvent("frame", result.frameBeginNs, result.frameEndNs);
+	}
+	const std::vector<std::string>& scopeNames = gpuProfiler.getScopeNames();
+	if (gpuScopeTraceNames.size() != scopeNames.size()) {
+		gpuScopeTraceNames.clear();
+		for (const std::string& scopeName : scopeNames) {
+			gpuScopeTraceNames.push_back(Tracer::intern(scopeName));
+		}
+	}
+	for (size_t i{ 0 }; i < result.scopeBeginNs.size() && i < gpuScopeTraceNames.size(); i++) {
+		if (result.scopeBeginNs.at(i) != 0) {
+			Tracer::addGpuEvent(gpuScopeTraceNames.at(i), result.scopeBeginNs.at(i), result.scopeEndNs.at(i));
+		}
+	}
+}
+
+/// @brief Dumps the frames currently held by the frame statistics as CSV (on exit, or when 'F' is pressed).
+void Application::writeFrameStatsCsv() {
+	if (frameStats.getRecordedCount() == 0) {
+		return;
+	}
+	if (frameStats.writeCsv(FRAME_STATS_CSV_PATH)) {
+		std::cout << "> Wrote frame statistics to '" << FRAME_STATS_CSV_PATH << "'.\n";
+	}
+	else {
+		std::cerr << "WARNING: Failed to write frame statistics to '" << FRAME_STATS_CSV_PATH << "'!\n";
+	}
+}
+
+/// @brief Polls the window events (the input a frame is built from), and remembers when it happened for the latency measurement.
+void Application::pollInput() {
+	if (!options.headless) {
+		TraceScope traceScope("glfwPollEvents");
+		glfwPollEvents();
+	}
+	lastInputPollTime = std::chrono::steady_clock::now();
+	pollCompletedFrames();
+}
+
+/// @brief True once the user has asked to close the window (never in headless mode).
+bool Application::isWindowCloseRequested() const {
+	return !options.headless && glfwWindowShouldClose(window);
+}
+
+/// @brief Headless mode: renders a fixed number of frames offscreen, then reports the frame statistics.
+void Application::runHeadless() {
+	std::cout << "\n> Headless run: " << options.headlessFrameCount << " frames at " << vulkanSwapChainExtent.width << "x" << vulkanSwapChainExtent.height << ".\n";
+	auto runStartTime = std::chrono::steady_clock::now();
+	for (uint32_t frame{ 0 }; frame < options.headlessFrameCount; frame++) {
+		pollInput();
+		drawFrame();
+	}
+	vkDeviceWaitIdle(vulkanLogicalDevice);
+
+	// The capture is done once the last readbacks are written (that's part of its throughput)
+	if (frameCapture.isRunning()) {
+		pollCompletedFrames();
+		frameCapture.stop();
+	}
+
+	double runTimeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - runStartTime).count();
+	std::cout << "> Headless run finished: " << options.headlessFrameCount << " frames in " << runTimeSeconds << " s ("
+		<< (runTimeSeconds > 0.0 ? options.headlessFrameCount / runTimeSeconds : 0.0) << " FPS).\n";
+	if (!options.captureDirectory.empty()) {
+		frameCapture.logReport(std::cout, runTimeSeconds);
+	}
+	logFrameStats();
+}
+
+/// @brief Benchmark mode: renders the warmup frames, then the measured frames, and summarizes the measured ones into 'benchmarkResult'.
+/// @brief Run with a fixed timestep & a camera path, every run of a scenario renders exactly the same frames.
+void Application::runBenchmark() {
+	benchmarkResult = BenchmarkResult{};
+	VkPhysicalDeviceProperties physicalDeviceProperties{};
+	vkGetPhysicalDeviceProperties(vulkanPhysicalDevice, &physicalDeviceProperties);
+	benchmarkResult.deviceName = physicalDeviceProperties.deviceName;
+	benchmarkResult.apiVersion = std::to_string(VK_API_VERSION_MAJOR(physicalDeviceProperties.apiVersion)) + "." +
+		std::to_string(VK_API_VERSION_MINOR(physicalDeviceProperties.apiVersion)) + "." + std::to_string(VK_API_VERSION_PATCH(physicalDeviceProperties.apiVersion));
+	benchmarkResult.driverVersion = physicalDeviceProperties.driverVersion;
+
+	uint32_t warmupFrames = options.benchmarkWarmupFrames;
+	uint32_t measuredFrames = options.headlessFrameCount;
+	uint64_t firstMeasuredFrame{ 0 };
+	auto measureStartTime = std::chrono::steady_clock::now();
+	for (uint32_t frame{ 0 }; frame < warmupFrames + measuredFrames; frame++) {
+		if (isWindowCloseRequested()) {
+			std::cout << "> Benchmark interrupted.\n";
+			return;
+		}
+		if (frame == warmupFrames) {
+			firstMeasuredFrame = frameNumber;
+			measureStartTime = std::chrono::steady_clock::now();
+		}
+		pollInput();
+		drawFrame();
+	}
+	vkDeviceWaitIdle(vulkanLogicalDevice);
+	benchmarkResult.wallTimeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - measureStartTime).count();
+
+	std::vector<FrameSample> samples = frameStats.snapshot();
+	samples.erase(std::remove_if(samples.begin(), samples.end(), [firstMeasuredFrame](const FrameSample& sample) { return sample.frameNumber < firstMeasuredFrame; }), samples.end());
+	benchmarkResult.measuredFrames = static_cast<uint32_t>(samples.size());
+	benchmarkResult.cpuFrame = FrameStats::summarize(samples, FrameMetric::CpuFrame);
+	benchmarkResult.cpuWork = FrameStats::summarize(samples, FrameMetric::CpuWork);
+	benchmarkResult.gpuFrame = FrameStats::summarize(samples, FrameMetric::GpuFrame);
+
+	benchmarkResult.objectCount = static_cast<uint32_t>(instances.size());
+	benchmarkResult.drawCallsPerFrame = getDrawCallsPerFrame();
+	benchmarkResult.pipelineCreationMs = pipelineCache.getPipelineCreationMs();
+	benchmarkResult.pipelineCacheWarm = pipelineCache.isWarm();
+	benchmarkResult.trianglesPerFrame = static_cast<uint64_t>(indices.size() / 3) * instances.size();
+	benchmarkResult.visibleObjects = getDrawnObjectCount();
+	benchmarkResult.occludedObjects = occlusionCullingEnabled ? lastOccludedObjectCount : 0;
+	benchmarkResult.trackedMemoryBytes = memoryTelemetry.getTotalTrackedBytes();
+	for (uint32_t category{ 0 }; category < static_cast<uint32_t>(MemoryCategory::Count); category++) {
+		benchmarkResult.memoryCategoryBytes.at(category) = memoryTelemetry.getCategoryBytes(static_cast<MemoryCategory>(category));
+	}
+	benchmarkResult.completed = true;
+
+	std::cout << "> Benchmark scenario measured " << benchmarkResult.measuredFrames << " frames in " << benchmarkResult.wallTimeSeconds << " s.\n";
+	logFrameStats();
+}
+
+/// @brief Resize storm: resizes the window through a scripted list of sizes, a few frames apart, and compares the frames
+/// @brief that recreated the swapchain against the steady frames rendered before the storm (the hitch of a recreation).
+void Application::runResizeStorm() {
+	std::vector<FrameSample> steadyFrames;
+	std::vector<FrameSample> recreateFrames;
+	std::vector<FrameSample> recreateTimes;
+	// Times a whole 'drawFrame' (a frame that recreates on acquire returns early, without recording its frame sample)
+	auto drawTimedFrame = [this]() -> FrameSample {
+		FrameSample sample{};
+		sample.frameNumber = frameNumber;
+		pollInput();
+		auto frameStartTime = std::chrono::steady_clock::now();
+		drawFrame();
+		sample[FrameMetric::CpuFrame] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStartTime).count();
+		return sample;
+	};
+	auto drawStormFrame = [&]() {
+		uint32_t recreateCountBefore = swapChainRecreateCount;
+		FrameSample sample = drawTimedFrame();
+		if (swapChainRecreateCount != recreateCountBefore) {
+			recreateFrames.push_back(sample);
+			sample[FrameMetric::CpuFrame] = lastSwapChainRecreateMs;
+			recreateTimes.push_back(sample);
+		}
+	};
+
+	std::cout << "\n> Resize storm (" << getRenderPathName() << "): " << RESIZE_STORM_BASELINE_FRAMES << " steady frames, then " << options.resizeStormCount
+		<< " resizes " << RESIZE_STORM_FRAMES_PER_RESIZE << " frames apart.\n";
+	for (uint32_t frame{ 0 }; frame < RESIZE_STORM_BASELINE_FRAMES; frame++) {
+		if (isWindowCloseRequested()) {
+			std::cout << "> Resize storm interrupted.\n";
+			return;
+		}
+		steadyFrames.push_back(drawTimedFrame());
+	}
+
+	uint32_t firstRecreateCount = swapChainRecreateCount;
+	uint32_t firstDepthImageAllocationCount = depthImageAllocationCount;
+	for (uint32_t resize{ 0 }; resize < options.resizeStormCount; resize++) {
+		glm::vec2 sizeFactor = RESIZE_STORM_SIZE_FACTORS.at(resize % RESIZE_STORM_SIZE_FACTORS.size());
+		glfwSetWindowSize(window, std::max(1, static_cast<int>(WIDTH * sizeFactor.x)), std::max(1, static_cast<int>(HEIGHT * sizeFactor.y)));
+
+		for (uint32_t frame{ 0 }; frame < RESIZE_STORM_FRAMES_PER_RESIZE; frame++) {
+			if (isWindowCloseRequested()) {
+				std::cout << "> Resize storm interrupted.\n";
+				return;
+			}
+			drawStormFrame();
+		}
+	}
+	// Keep rendering until the last size has settled (the debounced recreation happens then)
+	while (frameBufferResized && !isWindowCloseRequested()) {
+		drawStormFrame();
+	}
+	vkDeviceWaitIdle(vulkanLogicalDevice);
+	pollCompletedFrames();
+
+	FrameMetricSummary steady = FrameStats::summarize(steadyFrames, FrameMetric::CpuFrame);
+	FrameMetricSummary recreating = FrameStats::summarize(recreateFrames, FrameMetric::CpuFrame);
+	FrameMetricSummary recreation = FrameStats::summarize(recreateTimes, FrameMetric::CpuFrame);
+	std::cout << std::fixed << std::setprecision(3)
+		<< "> Resize storm finished: " << swapChainRecreateCount - firstRecreateCount << " swapchain recreations for " << options.resizeStormCount << " resizes.\n"
+		<< "\tSteady frames:      p50 = " << steady.p50 << " ms, p99 = " << steady.p99 << " ms, max = " << steady.max << " ms\n"
+		<< "\tRecreating frames:  p50 = " << recreating.p50 << " ms, p99 = " << recreating.p99 << " ms, max = " << recreating.max << " ms\n"
+		<< "\tHitch (recreating p50 - steady p50) = " << recreating.p50 - steady.p50 << " ms, worst = " << recreating.max - steady.p50 << " ms\n"
+		<< "\tRecreation (CPU):   mean = " << recreation.mean << " ms, max = " << recreation.max << " ms (" << getRenderPathName() << ")\n"
+		<< "\tDepth image:        " << depthImageAllocationCount - firstDepthImageAllocationCount << " reallocations (capacity " << depthImageCapacity.width << "x" << depthImageCapacity.height << ")\n"
+		<< "\tDeferred deletions: max " << deferredDeletions.getMaxPendingCount() << " pending, " << deferredDeletions.getPendingCount() << " left\n"
+		<< std::defaultfloat;
+}
+
+/// @brief What a swapchain recreation rebuilds besides the image views, to tell the resize storms of both paths apart.
+const char* Application::getRenderPathName() const {
+	if (renderGraphEnabled) {
+		return "dynamic rendering + render graph";
+	}
+	return dynamicRenderingEnabled ? "dynamic rendering" : "render pass + framebuffers";
+}
+
+/// @brief Seconds the scene has been animated for: a fixed step per frame if a timestep was given (deterministic), else the wall clock.
+float Application::getAnimationTime() const {
+	if (options.fixedTimestep > 0.0f) {
+		return static_cast<float>(frameNumber) * options.fixedTimestep;
+	}
+	static auto startTime = std::chrono::high_resolution_clock::now();
+	auto currentTime = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration<float, std::chrono::seconds::period>(currentTime - startTime).count();
+}
+
+/// @brief Number of draw calls recorded per frame by 'recordSceneDraws' (an indirect draw counts as one).
+uint64_t Application::getDrawCallsPerFrame() const {
+	if (gpuCullingEnabled) {
+		// (occlusion culling draws twice: early & late)
+		return ((drawIndirectCountSupported || multiDrawIndirectSupported) ? 1 : instances.size()) * (occlusionCullingEnabled ? 2 : 1);
+	}
+	if (options.instancedRendering) {
+		return recordingThreadPool ? activeRecordingSlotCount : 1;
+	}
+	return getDrawnObjectCount();
+}
+
+/// @brief Number of descriptor sets bound per frame for the scene: one per scene draw recording without bindless descriptors,
+/// @brief one per command buffer with them.
+uint64_t Application::getDescriptorSetBindsPerFrame() const {
+	bool secondaryCommandBuffersUsed = recordingThreadPool && !gpuCullingEnabled;
+	uint64_t secondaryBinds = secondaryCommandBuffersUsed ? activeRecordingSlotCount : 0;
+	if (bindlessEnabled) {
+		return 1 + secondaryBinds;
+	}
+	return secondaryCommandBuffersUsed ? secondaryBinds : (occlusionCullingEnabled ? 2 : 1);
+}
+
+/// @brief Number of objects drawn from the instance buffer: the visible ones with CPU / GPU culling, else every object.
+uint32_t Application::getDrawnObjectCount() const {
+	return (cpuCullingEnabled || gpuCullingEnabled) ? lastVisibleObjectCount : static_cast<uint32_t>(instances.size());
+}
+
+/// @brief Creates the readback ring of the frame capture (host visible buffers, cached if possible since the CPU reads them),
+/// @brief a capture command buffer per frame in flight, and starts the capture's encoder thread.
+void Application::createFrameCaptureResources() {
+	VkDeviceSize captureBufferSize = static_cast<VkDeviceSize>(vulkanSwapChainExtent.width) * vulkanSwapChainExtent.height * 4;
+	VkMemoryPropertyFlags captureMemoryProperties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+	if (!isMemoryTypeAvailable(captureMemoryProperties)) {
+		captureMemoryProperties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+	}
+	// (cached memory may not be coherent, in which case it's invalidated before being read)
+	captureMemoryCoherent = (captureMemoryProperties & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+
+	uint32_t ringSize = std::max(1u, options.captureRingSize);
+	captureBuffers.resize(ringSize);
+	captureBuffersMemory.resize(ringSize);
+	captureBuffersMapped.resize(ringSize);
+	std::vector<const void*> slotPixels(ringSize);
+	for (size_t i{ 0 }; i < ringSize; i++) {
+		createBuffer(
+			vulkanLogicalDevice, captureBufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT, captureMemoryProperties, MemoryCategory::Staging,
+			captureBuffers.at(i), captureBuffersMemory.at(i)
+		);
+		vkMapMemory(vulkanLogicalDevice, captureBuffersMemory.at(i), 0, captureBufferSize, 0, &captureBuffersMapped.at(i));
+		slotPixels.at(i) = captureBuffersMapped.at(i);
+	}
+
+	captureCommandBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+	VkCommandBufferAllocateInfo allocateInfo{};
+	allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+	allocateInfo.commandPool = vulkanGraphicsCommandPool;
+	allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	allocateInfo.commandBufferCount = static_cast<uint32_t>(captureCommandBuffers.size());
+	if (vkAllocateCommandBuffers(vulkanLogicalDevice, &allocateInfo, captureCommandBuffers.data()) != VK_SUCCESS) {
+		throw std::runtime_error("RUNTIME ERROR: Failed to allocate the frame capture command buffers!");
+	}
+
+	bool bgraPixels = vulkanSwapChainImageFormat == VK_FORMAT_B8G8R8A8_SRGB || vulkanSwapChainImageFormat == VK_FORMAT_B8G8R8A8_UNORM;
+	frameCapture.start(options.captureDirectory, vulkanSwapChainExtent.width, vulkanSwapChainExtent.height, bgraPixels, slotPixels);
+	std::cout << "> Created " << ringSize << " frame readback buffers (" << (captureMemoryCoherent ? "host coherent" : "host cached")
+		<< ") successfully. Capturing to '" << options.captureDirectory << "'.\n";
+}
+
+void Application::destroyFrameCaptureResources() {
+	// The encoder thread reads the mapped buffers, so it has to finish first
+	frameCapture.stop();
+	for (size_t i{ 0 }; i < captureBuffers.size(); i++) {
+		vkDestroyBuffer(vulkanLogicalDevice, captureBuffers.at(i), nullptr);
+		freeDeviceMemory(captureBuffersMemory.at(i));
+		captureBuffersMapped.at(i) = nullptr;
+	}
+	captureBuffers.clear();
+	captureBuffersMemory.clear();
+	captureBuffersMapped.clear();
+}
+
+/// @brief Records the copy of a rendered (offscreen) image into a readback buffer of the capture ring.
+void Application::recordCaptureCommands(VkCommandBuffer commandBuffer, uint32_t swapChainImageIndex, uint32_t captureSlot) {
+	VkCommandBufferBeginInfo beginInfo{};
+	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
+		throw std::runtime_error("RUNTIME ERROR: Failed to begin recording the frame capture Command Buffer!");
+	}
+
+	// The render pass (or the dynamic resolution blit) leaves the image in TRANSFER_SRC_OPTIMAL: make its writes visible to the copy
+	VkImageMemoryBarrier imageBarrier{};
+	imageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	imageBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+	imageBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+	imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	imageBarrier.image = vulkanSwapChainImages.at(swapChainImageIndex);
+	imageBarrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+	imageBarrier.subresourceRange.baseMipLevel = 0;
+	imageBarrier.subresourceRange.levelCount = 1;
+	imageBarrier.subresourceRange.baseArrayLayer = 0;
+	imageBarrier.subresourceRange.layerCount = 1;
+	imageBarrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+	imageBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+	vkCmdPipelineBarrier(
+		commandBuffer,
+		VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+		0,
+		0, nullptr,
+		0, nullptr,
+		1, &imageBarrier
+	);
+
+	// Copy the whole image, tightly packed
+	VkBufferImageCopy copyRegion{};
+	copyRegion.bufferOffset = 0;
+	copyRegion.bufferRowLength = 0;
+	copyRegion.bufferImageHeight = 0;
+	copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+	copyRegion.imageSubresource.mipLevel = 0;
+	copyRegion.imageSubresource.baseArrayLayer = 0;
+	copyRegion.imageSubresource.layerCount = 1;
+	copyRegion.imageOffset = { 0, 0, 0 };
+	copyRegion.imageExtent = { vulkanSwapChainExtent.width, vulkanSwapChainExtent.height, 1 };
+	vkCmdCopyImageToBuffer(commandBuffer, vulkanSwapChainImages.at(swapChainImageIndex), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, captureBuffers.at(captureSlot), 1, &copyRegion);
+
+	// Make the copy visible to the host (the encoder thread reads the buffer once the frame's timeline value is reached)
+	VkBufferMemoryBarrier bufferBarrier{};
+	bufferBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+	bufferBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	bufferBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+	bufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	bufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	bufferBarrier.buffer = captureBuffers.at(captureSlot);
+	bufferBarrier.offset = 0;
+	bufferBarrier.size = VK_WHOLE_SIZE;
+	vkCmdPipelineBarrier(
+		commandBuffer,
+		VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+		0,
+		0, nullptr,
+		1, &bufferBarrier,
+		0, nullptr
+	);
+
+	if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+		throw std::runtime_error("RUNTIME ERROR: Failed to record the frame capture Command Buffer!");
+	}
+}
+
+/// @brief Blocks until the previous submission of the given frame slot has finished on the GPU. Returns how long the CPU waited (ms).
+double Application::waitForFrameSlot(uint32_t frameIndex) {
+	auto waitStartTime = std::chrono::steady_clock::now();
+
+	VkSemaphoreWaitInfo semaphoreWaitInfo{};
+	semaphoreWaitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+	semaphoreWaitInfo.pSemaphores = &frameTimelineSemaphore;
+	semaphoreWaitInfo.pValues = &frameSlotTimelineValues.at(frameIndex);
+	semaphoreWaitInfo.semaphoreCount = 1;
+	if (vkWaitSemaphores(vulkanLogicalDevice, &semaphoreWaitInfo, UINT64_MAX) != VK_SUCCESS) {
+		throw std::runtime_error("RUNTIME ERROR: Failed to wait on the frame timeline semaphore!");
+	}
+
+	double waitTimeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - waitStartTime).count();
+	pollCompletedFrames();
+	return waitTimeMs;
+}
+
+/// @brief Records the input latency of every frame the GPU has finished since the last call.
+/// @brief The completion time is when we notice it (here), so it's accurate to within one poll/wait of the main loop.
+void Application::pollCompletedFrames() {
+	if (frameTimelineSemaphore == VK_NULL_HANDLE) {
+		return;
+	}
+	uint64_t completedValue{ 0 };
+	vkGetSemaphoreCounterValue(vulkanLogicalDevice, frameTimelineSemaphore, &completedValue);
+	auto now = std::chrono::steady_clock::now();
+
+	for (uint32_t frameIndex{ 0 }; frameIndex < MAX_FRAMES_IN_FLIGHT; frameIndex++) {
+		if (frameSlotLatencyPending.at(frameIndex) && frameSlotTimelineValues.at(frameIndex) <= completedValue) {
+			lastInputLatencyMs = std::chrono::duration<double, std::milli>(now - frameSlotInputTimes.at(frameIndex)).count();
+			frameSlotLatencyPending.at(frameIndex) = false;
+		}
+	}
+
+	// Destroy what the finished frames were the last to use (eg: the resources of a recreated swapchain)
+	deferredDeletions.flush(completedValue);
+
+	// Hand the finished readbacks over to the capture's encoder thread
+	if (frameCapture.isRunning()) {
+		for (uint32_t slot : frameCapture.collectCompleted(completedValue)) {
+			if (!captureMemoryCoherent) {
+				VkMappedMemoryRange mappedRange{};
+				mappedRange.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+				mappedRange.memory = captureBuffersMemory.at(slot);
+				mappedRange.offset = 0;
+				mappedRange.size = VK_WHOLE_SIZE;
+				vkInvalidateMappedMemoryRanges(vulkanLogicalDevice, 1, &mappedRange);
+			}
+			frameCapture.encodeAsync(slot);
+		}
+	}
+}
+
+/// @brief Checks if the GPU has any memory type with all the given properties (eg: to prefer HOST_CACHED memory when available).
+bool Application::isMemoryTypeAvailable(VkMemoryPropertyFlags properties) {
+	VkPhysicalDeviceMemoryProperties memoryProperties{};
+	vkGetPhysicalDeviceMemoryProperties(vulkanPhysicalDevice, &memoryProperties);
+	for (uint32_t i{ 0 }; i < memoryProperties.memoryTypeCount; i++) {
+		if ((memoryProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+			return true;
+		}
+	}
+	return false;
+}
+
+uint32_t Application::findMemoryType(uint32_t typefilter, VkMemoryPropertyFlags properties) {
+	// Get the memory properties of the GPU
+	VkPhysicalDeviceMemoryProperties memoryProperties{};
+	vkGetPhysicalDeviceMemoryProperties(vulkanPhysicalDevice, &memoryProperties);
+
+	/*
 		NOTE:
 		Physical Device Memory properties contains 2 arrays: 
 		- memoryHeaps, and
@@ -1759,110 +4144,738 @@ uint32_t Application::findMemoryType(uint32_t typefilter, VkMemoryPropertyFlags
 		Each memoryHeap contains multiple memory types.
 	*/
 
-	// Try and find a memory-type that is suitable for the buffer
-	for (uint32_t i{ 0 }; i < memoryProperties.memoryTypeCount; i++) {
-		if ((typefilter & (1 << i)) && (memoryProperties.memoryTypes[i].propertyFlags & properties) == properties) {
-			// Found a suitable memory type for the vertex buffer
-			// Also found a suitable memory type to write our buffer data to
+	// Try and find a memory-type that is suitable for the buffer
+	for (uint32_t i{ 0 }; i < memoryProperties.memoryTypeCount; i++) {
+		if ((typefilter & (1 << i)) && (memoryProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+			// Found a suitable memory type for the vertex buffer
+			// Also found a suitable memory type to write our buffer data to
+
+#ifdef NDEBUG
+			// Release Mode
+#else
+			// Debug Mode
+			std::cout << "DEBUG LOG: Found suitable memory-type for Buffer Memory allocation.\n";
+			std::cout << "DEBUG LOG: Requested Memory Properties = ";
+			if (properties & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)
+				std::cout << "DEVICE_LOCAL  ";
+			if (properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+				std::cout << "HOST_VISIBLE  ";
+			if (properties & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+				std::cout << "HOST_COHERENT  ";
+			if (properties & VK_MEMORY_PROPERTY_HOST_CACHED_BIT)
+				std::cout << "HOST_CACHED  ";
+			if (properties & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT)
+				std::cout << "LAZILY_ALLOCATED  ";
+			if (properties & VK_MEMORY_PROPERTY_PROTECTED_BIT)
+				std::cout << "PROTECTED  ";
+			if (properties & VK_MEMORY_PROPERTY_DEVICE_COHERENT_BIT_AMD)
+				std::cout << "DEVICE_COHERENT_AMD  ";
+			if (properties & VK_MEMORY_PROPERTY_DEVICE_UNCACHED_BIT_AMD)
+				std::cout << "DEVICE_UNCACHED_AMD  ";
+			std::cout << "\n";
+			std::cout << "DEBUG LOG: Chosen Memory Type = " << i << " (Refer VHCV for more info)\n\n";
+#endif
+
+			return i;
+		}
+	}
+	throw std::runtime_error("RUNTIME ERROR: Failed to find suitable memory type!");
+
+	return 0;
+}
+
+/// @brief Load and image and upload it into a Vulkan image object
+/// @brief Loads & decodes the texture image file (no Vulkan object needed, so it runs alongside the device creation).
+void Application::decodeTextureImage() {
+	int textureWidth{};
+	int textureHeight{};
+	int textureChannels{};
+
+	// Load the texture image
+	stbi_uc* pixels = stbi_load(TEXTURE_PATH.c_str(), &textureWidth, &textureHeight, &textureChannels, STBI_rgb_alpha);
+	if (!pixels) {
+		throw std::runtime_error("RUNTIME ERROR: Failed to load texture image!");
+	}
+	StartupProfiler::recordFileRead(TEXTURE_PATH);
+	decodedTextureWidth = static_cast<uint32_t>(textureWidth);
+	decodedTextureHeight = static_cast<uint32_t>(textureHeight);
+	decodedTexturePixels.assign(pixels, pixels + static_cast<size_t>(textureWidth) * textureHeight * 4);
+	stbi_image_free(pixels);
+	std::cout << "> Loaded texture image successfully.\n";
+}
+
+void Application::createTextureImage() {
+	uint32_t textureWidth = decodedTextureWidth;
+	uint32_t textureHeight = decodedTextureHeight;
+
+	// Create staging buffer
+	VkDeviceSize imageSize = static_cast<VkDeviceSize>(textureWidth) * textureHeight * 4;
+	VkBuffer stagingBuffer;
+	VkDeviceMemory stagingBufferMemory;
+	createBuffer(
+		vulkanLogicalDevice,
+		imageSize,
+		VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+		MemoryCategory::Staging,
+		stagingBuffer,
+		stagingBufferMemory
+	);
+	
+	// Copy the data from the loaded image to the buffer
+	void* stagingBufferData{ nullptr };
+	vkMapMemory(vulkanLogicalDevice, stagingBufferMemory, 0, imageSize, 0, &stagingBufferData);
+	memcpy(stagingBufferData, decodedTexturePixels.data(), static_cast<size_t>(imageSize));
+	vkUnmapMemory(vulkanLogicalDevice, stagingBufferMemory);
+
+	// Clean up the decoded pixel data (no longer needed since its copied into staging buffer)
+	decodedTexturePixels.clear();
+	decodedTexturePixels.shrink_to_fit();
+
+
+	// Create the Vulkan Image that will contain the pixel data from the staging buffer, and will be read from by our shader
+	QueueFamilyIndices queueFamilies = findQueueFamilies(vulkanPhysicalDevice);
+	std::vector<uint32_t> queueFamilyIndices = { queueFamilies.graphicsFamily.value(), queueFamilies.transferFamily.value() };
+	create2DVulkanImage(
+		vulkanLogicalDevice,
+		textureWidth,
+		textureHeight,
+		VK_FORMAT_R8G8B8A8_SRGB,
+		VK_IMAGE_TILING_OPTIMAL,
+		VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+		MemoryCategory::Texture,
+		textureImage,
+		textureDeviceMemory,
+		queueFamilyIndices
+	);
+
+	transitionImageLayout(textureImage, RenderGraphAccess::None, RenderGraphAccess::TransferWrite);
+	copyBufferToImage(stagingBuffer, textureImage, textureWidth, textureHeight);
+	transitionImageLayout(textureImage, RenderGraphAccess::TransferWrite, RenderGraphAccess::FragmentSampledRead);
+
+	vkDestroyBuffer(vulkanLogicalDevice, stagingBuffer, nullptr);
+	freeDeviceMemory(stagingBufferMemory);
+}
+
+void Application::createTextureImageView() {
+	textureImageView = createImageView(textureImage, VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_ASPECT_COLOR_BIT);
+}
+
+/// @brief Creates the pipeline cache, warm if the cache file was written by this device & driver.
+void Application::createPipelineCache() {
+	pipelineCache.initialize(vulkanLogicalDevice, vulkanPhysicalDevice, options.pipelineCachePath);
+}
+
+/// @brief Creates the GPU profiler's query pools (one set per frame in flight).
+void Application::createGpuProfiler() {
+	QueueFamilyIndices queueFamilies = findQueueFamilies(vulkanPhysicalDevice);
+	gpuProfiler.initialize(vulkanLogicalDevice, vulkanPhysicalDevice, queueFamilies.graphicsFamily.value(), MAX_FRAMES_IN_FLIGHT, gpuPipelineStatisticsSupported);
+	if (!gpuProfiler.isTimestampSupported()) {
+		std::cout << "> GPU timestamps not supported on the graphics queue. GPU frame times won't be reported.\n";
+		if (dynamicResolutionEnabled) {
+			std::cerr << "WARNING: Dynamic resolution needs GPU timestamps, the resolution scale will stay at 1.\n";
+		}
+	}
+	if (!gpuProfiler.isPipelineStatisticsEnabled()) {
+		std::cout << "> Pipeline statistics queries not supported. GPU pipeline statistics won't be reported.\n";
+	}
+	if (gpuProfiler.isTimestampSupported() && !(calibratedTimestampsExtensionEnabled && gpuProfiler.enableCalibratedTimestamps(vulkanInstance, vulkanPhysicalDevice))) {
+		std::cout << "> Calibrated timestamps not available. The traced GPU frames start at their submission.\n";
+	}
+	std::cout << "> Created GPU profiler query pools successfully.\n";
+}
+
+/// @brief Renders the scene with an increasing number of instances and reports the average CPU & GPU frame times of each step.
+void Application::runInstanceBenchmark() {
+	struct BenchmarkResult {
+		uint32_t instanceCount;
+		double cpuFrameTimeMs;
+		double gpuFrameTimeMs;
+		double wallFrameTimeMs;
+	};
+	std::vector<BenchmarkResult> results{};
+
+	std::cout << "\n> Instance benchmark (" << (options.instancedRendering ? "instanced" : "one draw per object")
+		<< ", " << (options.staticCommandBuffers ? "static command buffers" : "re-recorded command buffers") << "):\n";
+
+	for (uint32_t instanceCount : INSTANCE_BENCHMARK_COUNTS) {
+		setInstanceCount(instanceCount);
+
+		BenchmarkResult result{ instanceCount, 0.0, 0.0, 0.0 };
+		for (uint32_t frame{ 0 }; frame < INSTANCE_BENCHMARK_WARMUP_FRAMES + INSTANCE_BENCHMARK_MEASURED_FRAMES; frame++) {
+			if (isWindowCloseRequested()) {
+				std::cout << "> Instance benchmark interrupted.\n";
+				return;
+			}
+			pollInput();
+
+			auto frameStartTime = std::chrono::steady_clock::now();
+			drawFrame();
+			double wallFrameTimeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStartTime).count();
+
+			// The warmup frames also flush out GPU timings that still belong to the previous instance count
+			if (frame >= INSTANCE_BENCHMARK_WARMUP_FRAMES) {
+				result.cpuFrameTimeMs += lastFrameSample[FrameMetric::CpuWork];
+				result.gpuFrameTimeMs += lastFrameSample[FrameMetric::GpuFrame];
+				result.wallFrameTimeMs += wallFrameTimeMs;
+			}
+		}
+		result.cpuFrameTimeMs /= INSTANCE_BENCHMARK_MEASURED_FRAMES;
+		result.gpuFrameTimeMs /= INSTANCE_BENCHMARK_MEASURED_FRAMES;
+		result.wallFrameTimeMs /= INSTANCE_BENCHMARK_MEASURED_FRAMES;
+		results.push_back(result);
+
+		std::cout << std::fixed << std::setprecision(3)
+			<< "\t" << std::setw(7) << result.instanceCount << " instances: CPU " << result.cpuFrameTimeMs << " ms"
+			<< ", GPU " << (gpuProfiler.isTimestampSupported() ? std::to_string(result.gpuFrameTimeMs) + " ms" : std::string("n/a"))
+			<< ", frame " << result.wallFrameTimeMs << " ms\n" << std::defaultfloat;
+	}
+	std::cout << "> Instance benchmark finished (frame time includes waiting for the GPU & presentation).\n";
+}
+
+/// @brief Creates the per-frame buffers, descriptor sets and compute pipeline of the GPU culling pass.
+void Application::createCullingResources() {
+	// The culling pass is recorded into the graphics command buffers, so the graphics queue must support compute too
+	uint32_t queueFamilyCount{ 0 };
+	vkGetPhysicalDeviceQueueFamilyProperties(vulkanPhysicalDevice, &queueFamilyCount, nullptr);
+	std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+	vkGetPhysicalDeviceQueueFamilyProperties(vulkanPhysicalDevice, &queueFamilyCount, queueFamilies.data());
+	if (!(queueFamilies.at(findQueueFamilies(vulkanPhysicalDevice).graphicsFamily.value()).queueFlags & VK_QUEUE_COMPUTE_BIT)) {
+		throw std::runtime_error("RUNTIME ERROR: GPU culling requires a graphics queue that supports compute!");
+	}
+
+	if (occlusionCullingEnabled) {
+		createOcclusionCullingPipeline();
+	}
+
+	// Per-frame buffers (with occlusion culling, the late phase's draws follow the early phase's in the indirect draw buffer)
+	VkDeviceSize indirectDrawBufferSize = sizeof(VkDrawIndexedIndirectCommand) * instanceBufferCapacity * (occlusionCullingEnabled ? 2 : 1);
+	VkDeviceSize drawCountBufferSize = sizeof(uint32_t) * CULL_COUNTER_COUNT;
+	cullUniformBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+	cullUniformBuffersMemory.resize(MAX_FRAMES_IN_FLIGHT);
+	cullUniformBuffersMapped.resize(MAX_FRAMES_IN_FLIGHT);
+	indirectDrawBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+	indirectDrawBuffersMemory.resize(MAX_FRAMES_IN_FLIGHT);
+	drawCountBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+	drawCountBuffersMemory.resize(MAX_FRAMES_IN_FLIGHT);
+	drawCountBuffersMapped.resize(MAX_FRAMES_IN_FLIGHT);
+	drawCountsSubmitted.assign(MAX_FRAMES_IN_FLIGHT, false);
+	if (occlusionCullingEnabled) {
+		occlusionStateBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+		occlusionStateBuffersMemory.resize(MAX_FRAMES_IN_FLIGHT);
+	}
+#ifndef NDEBUG
+	expectedVisibleObjectCounts.assign(MAX_FRAMES_IN_FLIGHT, 0);
+#endif
+
+	for (size_t i{ 0 }; i < MAX_FRAMES_IN_FLIGHT; i++) {
+		createBuffer(
+			vulkanLogicalDevice,
+			sizeof(CullUniforms),
+			VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			MemoryCategory::Uniform,
+			cullUniformBuffers.at(i),
+			cullUniformBuffersMemory.at(i)
+		);
+		vkMapMemory(vulkanLogicalDevice, cullUniformBuffersMemory.at(i), 0, sizeof(CullUniforms), 0, &cullUniformBuffersMapped.at(i));
+
+		// Only ever written and read by the GPU
+		createBuffer(
+			vulkanLogicalDevice,
+			indirectDrawBufferSize,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			MemoryCategory::Geometry,
+			indirectDrawBuffers.at(i),
+			indirectDrawBuffersMemory.at(i)
+		);
+
+		// Host visible, since the visible object counts are read back every frame
+		createBuffer(
+			vulkanLogicalDevice,
+			drawCountBufferSize,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			MemoryCategory::Geometry,
+			drawCountBuffers.at(i),
+			drawCountBuffersMemory.at(i)
+		);
+		vkMapMemory(vulkanLogicalDevice, drawCountBuffersMemory.at(i), 0, drawCountBufferSize, 0, &drawCountBuffersMapped.at(i));
+
+		if (occlusionCullingEnabled) {
+			createBuffer(
+				vulkanLogicalDevice,
+				sizeof(uint32_t) * instanceBufferCapacity,
+				VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+				VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+				MemoryCategory::Geometry,
+				occlusionStateBuffers.at(i),
+				occlusionStateBuffersMemory.at(i)
+			);
+		}
+	}
+
+	// Descriptor set layout: cull uniforms, instance transforms, indirect draw commands, draw counts (and the re-test flags with occlusion culling)
+	uint32_t bindingCount = occlusionCullingEnabled ? 5 : 4;
+	std::array<VkDescriptorSetLayoutBinding, 5> layoutBindings{};
+	for (uint32_t binding{ 0 }; binding < bindingCount; binding++) {
+		layoutBindings.at(binding).binding = binding;
+		layoutBindings.at(binding).descriptorType = (binding == 0) ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		layoutBindings.at(binding).descriptorCount = 1;
+		layoutBindings.at(binding).stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+	}
+	VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{};
+	descriptorSetLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	descriptorSetLayoutCreateInfo.pBindings = layoutBindings.data();
+	descriptorSetLayoutCreateInfo.bindingCount = bindingCount;
+	if (vkCreateDescriptorSetLayout(vulkanLogicalDevice, &descriptorSetLayoutCreateInfo, nullptr, &cullDescriptorSetLayout) != VK_SUCCESS) {
+		throw std::runtime_error("RUNTIME ERROR: Failed to create the GPU culling descriptor set layout!");
+	}
+
+	// Descriptor pool & sets (one per frame in flight)
+	std::array<VkDescriptorPoolSize, 2> poolSizes{};
+	poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+	poolSizes[0].descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
+	poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	poolSizes[1].descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT) * (bindingCount - 1);
+	VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+	descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	descriptorPoolCreateInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+	descriptorPoolCreateInfo.pPoolSizes = poolSizes.data();
+	descriptorPoolCreateInfo.maxSets = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
+	if (vkCreateDescriptorPool(vulkanLogicalDevice, &descriptorPoolCreateInfo, nullptr, &cullDescriptorPool) != VK_SUCCESS) {
+		throw std::runtime_error("RUNTIME ERROR: Failed to create the GPU culling descriptor pool!");
+	}
+
+	std::vector<VkDescriptorSetLayout> descriptorSetLayouts(MAX_FRAMES_IN_FLIGHT, cullDescriptorSetLayout);
+	VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+	descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	descriptorSetAllocateInfo.descriptorPool = cullDescriptorPool;
+	descriptorSetAllocateInfo.pSetLayouts = descriptorSetLayouts.data();
+	descriptorSetAllocateInfo.descriptorSetCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
+	cullDescriptorSets.resize(MAX_FRAMES_IN_FLIGHT);
+	if (vkAllocateDescriptorSets(vulkanLogicalDevice, &descriptorSetAllocateInfo, cullDescriptorSets.data()) != VK_SUCCESS) {
+		throw std::runtime_error("RUNTIME ERROR: Failed to allocate the GPU culling descriptor sets!");
+	}
 
-#ifdef NDEBUG
-			// Release Mode
-#else
-			// Debug Mode
-			std::cout << "DEBUG LOG: Found suitable memory-type for Buffer Memory allocation.\n";
-			std::cout << "DEBUG LOG: Requested Memory Properties = ";
-			if (properties & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)
-				std::cout << "DEVICE_LOCAL  ";
-			if (properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
-				std::cout << "HOST_VISIBLE  ";
-			if (properties & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
-				std::cout << "HOST_COHERENT  ";
-			if (properties & VK_MEMORY_PROPERTY_HOST_CACHED_BIT)
-				std::cout << "HOST_CACHED  ";
-			if (properties & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT)
-				std::cout << "LAZILY_ALLOCATED  ";
-			if (properties & VK_MEMORY_PROPERTY_PROTECTED_BIT)
-				std::cout << "PROTECTED  ";
-			if (properties & VK_MEMORY_PROPERTY_DEVICE_COHERENT_BIT_AMD)
-				std::cout << "DEVICE_COHERENT_AMD  ";
-			if (properties & VK_MEMORY_PROPERTY_DEVICE_UNCACHED_BIT_AMD)
-				std::cout << "DEVICE_UNCACHED_AMD  ";
-			std::cout << "\n";
-			std::cout << "DEBUG LOG: Chosen Memory Type = " << i << " (Refer VHCV for more info)\n\n";
-#endif
+	for (size_t i{ 0 }; i < MAX_FRAMES_IN_FLIGHT; i++) {
+		std::array<VkDescriptorBufferInfo, 5> bufferInfos{};
+		bufferInfos[0] = { cullUniformBuffers.at(i), 0, sizeof(CullUniforms) };
+		bufferInfos[1] = { instanceBuffers.at(i), 0, VK_WHOLE_SIZE };
+		bufferInfos[2] = { indirectDrawBuffers.at(i), 0, VK_WHOLE_SIZE };
+		bufferInfos[3] = { drawCountBuffers.at(i), 0, VK_WHOLE_SIZE };
+		if (occlusionCullingEnabled) {
+			bufferInfos[4] = { occlusionStateBuffers.at(i), 0, VK_WHOLE_SIZE };
+		}
 
-			return i;
+		std::array<VkWriteDescriptorSet, 5> descriptorWrites{};
+		for (uint32_t binding{ 0 }; binding < bindingCount; binding++) {
+			descriptorWrites.at(binding).sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			descriptorWrites.at(binding).dstSet = cullDescriptorSets.at(i);
+			descriptorWrites.at(binding).dstBinding = binding;
+			descriptorWrites.at(binding).dstArrayElement = 0;
+			descriptorWrites.at(binding).descriptorType = layoutBindings.at(binding).descriptorType;
+			descriptorWrites.at(binding).descriptorCount = 1;
+			descriptorWrites.at(binding).pBufferInfo = &bufferInfos.at(binding);
 		}
+		vkUpdateDescriptorSets(vulkanLogicalDevice, bindingCount, descriptorWrites.data(), 0, nullptr);
 	}
-	throw std::runtime_error("RUNTIME ERROR: Failed to find suitable memory type!");
 
-	return 0;
+	// Compute pipeline (occlusion culling adds the Hi-Z pyramid as set 1, and the phase as a push constant)
+	std::array<VkDescriptorSetLayout, 2> pipelineSetLayouts = { cullDescriptorSetLayout, hiZSampleDescriptorSetLayout };
+	VkPushConstantRange phasePushConstantRange{};
+	phasePushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+	phasePushConstantRange.offset = 0;
+	phasePushConstantRange.size = sizeof(uint32_t);
+	VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+	pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+	pipelineLayoutCreateInfo.setLayoutCount = occlusionCullingEnabled ? 2 : 1;
+	pipelineLayoutCreateInfo.pSetLayouts = pipelineSetLayouts.data();
+	pipelineLayoutCreateInfo.pushConstantRangeCount = occlusionCullingEnabled ? 1 : 0;
+	pipelineLayoutCreateInfo.pPushConstantRanges = &phasePushConstantRange;
+	if (vkCreatePipelineLayout(vulkanLogicalDevice, &pipelineLayoutCreateInfo, nullptr, &cullPipelineLayout) != VK_SUCCESS) {
+		throw std::runtime_error("RUNTIME ERROR: Failed to create the GPU culling pipeline layout!");
+	}
+
+	auto cullShaderCode = readFile(occlusionCullingEnabled ? "shaders/cull_occlusion.spv" : "shaders/cull.spv");
+	VkShaderModule cullShaderModule = createShaderModule(cullShaderCode);
+
+	VkComputePipelineCreateInfo computePipelineCreateInfo{};
+	computePipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+	computePipelineCreateInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	computePipelineCreateInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+	computePipelineCreateInfo.stage.module = cullShaderModule;
+	computePipelineCreateInfo.stage.pName = "main";
+	computePipelineCreateInfo.layout = cullPipelineLayout;
+	auto pipelineStartTime = std::chrono::steady_clock::now();
+	VkResult result = vkCreateComputePipelines(vulkanLogicalDevice, pipelineCache.getHandle(), 1, &computePipelineCreateInfo, nullptr, &cullPipeline);
+	pipelineCache.recordPipelineCreation(std::chrono::steady_clock::now() - pipelineStartTime);
+	vkDestroyShaderModule(vulkanLogicalDevice, cullShaderModule, nullptr);
+	if (result != VK_SUCCESS) {
+		throw std::runtime_error("RUNTIME ERROR: Failed to create the GPU culling compute pipeline!");
+	}
+	if (occlusionCullingEnabled) {
+		createHiZResources();
+	}
+	std::cout << "> Created GPU culling resources successfully.\n";
 }
 
-/// @brief Load and image and upload it into a Vulkan image object
-void Application::createTextureImage() {
-	int textureWidth{};
-	int textureHeight{};
-	int textureChannels{};
+/// @brief Creates what the occlusion culling keeps for the whole run: the Hi-Z downsample pipeline, its sampler, and the descriptor set
+/// @brief layouts of the pyramid (the pyramid itself follows the depth image, see 'createHiZResources').
+void Application::createOcclusionCullingPipeline() {
+	VkSamplerCreateInfo samplerInfo{};
+	samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+	samplerInfo.magFilter = VK_FILTER_NEAREST;
+	samplerInfo.minFilter = VK_FILTER_NEAREST;
+	samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+	samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+	samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+	samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+	samplerInfo.minLod = 0.0f;
+	samplerInfo.maxLod = VK_LOD_CLAMP_NONE;
+	if (vkCreateSampler(vulkanLogicalDevice, &samplerInfo, nullptr, &hiZSampler) != VK_SUCCESS) {
+		throw std::runtime_error("RUNTIME ERROR: Failed to create the Hi-Z sampler!");
+	}
 
-	const char* imagePath = "textures/Vulkan_Texture.png";
+	// Downsample: the source (depth image or the level above) and the destination level
+	std::array<VkDescriptorSetLayoutBinding, 2> layoutBindings{};
+	layoutBindings[0].binding = 0;
+	layoutBindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	layoutBindings[0].descriptorCount = 1;
+	layoutBindings[0].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+	layoutBindings[1].binding = 1;
+	layoutBindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+	layoutBindings[1].descriptorCount = 1;
+	layoutBindings[1].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+	VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{};
+	descriptorSetLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	descriptorSetLayoutCreateInfo.pBindings = layoutBindings.data();
+	descriptorSetLayoutCreateInfo.bindingCount = static_cast<uint32_t>(layoutBindings.size());
+	if (vkCreateDescriptorSetLayout(vulkanLogicalDevice, &descriptorSetLayoutCreateInfo, nullptr, &hiZDescriptorSetLayout) != VK_SUCCESS) {
+		throw std::runtime_error("RUNTIME ERROR: Failed to create the Hi-Z descriptor set layout!");
+	}
+	// Culling: the whole pyramid
+	descriptorSetLayoutCreateInfo.bindingCount = 1;
+	if (vkCreateDescriptorSetLayout(vulkanLogicalDevice, &descriptorSetLayoutCreateInfo, nullptr, &hiZSampleDescriptorSetLayout) != VK_SUCCESS) {
+		throw std::runtime_error("RUNTIME ERROR: Failed to create the Hi-Z sampling descriptor set layout!");
+	}
 
-	// Load the texture image
-	stbi_uc* pixels = stbi_load(TEXTURE_PATH.c_str(), &textureWidth, &textureHeight, &textureChannels, STBI_rgb_alpha);
-	if (!pixels) {
-		throw std::runtime_error("RUNTIME ERROR: Failed to load texture image!");
+	// Source & destination sizes
+	VkPushConstantRange pushConstantRange{};
+	pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+	pushConstantRange.offset = 0;
+	pushConstantRange.size = sizeof(int32_t) * 4;
+	VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+	pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+	pipelineLayoutCreateInfo.setLayoutCount = 1;
+	pipelineLayoutCreateInfo.pSetLayouts = &hiZDescriptorSetLayout;
+	pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+	pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+	if (vkCreatePipelineLayout(vulkanLogicalDevice, &pipelineLayoutCreateInfo, nullptr, &hiZPipelineLayout) != VK_SUCCESS) {
+		throw std::runtime_error("RUNTIME ERROR: Failed to create the Hi-Z pipeline layout!");
 	}
-	std::cout << "> Loaded texture image successfully.\n";
 
-	// Create staging buffer
-	VkDeviceSize imageSize = textureWidth * textureHeight * 4;
-	VkBuffer stagingBuffer;
-	VkDeviceMemory stagingBufferMemory;
-	createBuffer(
-		vulkanLogicalDevice,
-		imageSize,
-		VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-		stagingBuffer,
-		stagingBufferMemory
-	);
-	
-	// Copy the data from the loaded image to the buffer
-	void* stagingBufferData{ nullptr };
-	vkMapMemory(vulkanLogicalDevice, stagingBufferMemory, 0, imageSize, 0, &stagingBufferData);
-	memcpy(stagingBufferData, pixels, static_cast<size_t>(imageSize));
-	vkUnmapMemory(vulkanLogicalDevice, stagingBufferMemory);
+	auto hiZShaderCode = readFile("shaders/hiz.spv");
+	VkShaderModule hiZShaderModule = createShaderModule(hiZShaderCode);
+
+	VkComputePipelineCreateInfo computePipelineCreateInfo{};
+	computePipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+	computePipelineCreateInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	computePipelineCreateInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+	computePipelineCreateInfo.stage.module = hiZShaderModule;
+	computePipelineCreateInfo.stage.pName = "main";
+	computePipelineCreateInfo.layout = hiZPipelineLayout;
+	auto pipelineStartTime = std::chrono::steady_clock::now();
+	VkResult result = vkCreateComputePipelines(vulkanLogicalDevice, pipelineCache.getHandle(), 1, &computePipelineCreateInfo, nullptr, &hiZPipeline);
+	pipelineCache.recordPipelineCreation(std::chrono::steady_clock::now() - pipelineStartTime);
+	vkDestroyShaderModule(vulkanLogicalDevice, hiZShaderModule, nullptr);
+	if (result != VK_SUCCESS) {
+		throw std::runtime_error("RUNTIME ERROR: Failed to create the Hi-Z compute pipeline!");
+	}
+}
 
-	// Clean up the retrieved pixel data (no longer needed since its copied into staging buffer)
-	stbi_image_free(pixels);
+/// @brief Creates the Hi-Z pyramid for the current depth image, and the descriptor sets reading & writing its levels.
+/// @brief Level 0 is half the depth image (rounded up to a power of two), so every level halves the one above exactly, and a level 0 texel
+/// @brief covers at most 2x2 depth texels of any render extent. Only recreated with the depth image; the previous pyramid and descriptor
+/// @brief pool are retired into the deferred deletion queue (the frames in flight may still use them).
+void Application::createHiZResources() {
+	if (hiZImage != VK_NULL_HANDLE) {
+		if (hiZSourceDepthImageView == depthImageView) {
+			return;
+		}
+		std::vector<VkImageView> retiredLevelViews;
+		retiredLevelViews.swap(hiZLevelViews);
+		VkDescriptorPool retiredDescriptorPool = hiZDescriptorPool;
+		deferredDeletions.enqueue(frameTimelineValue, [this, retiredLevelViews, retiredDescriptorPool]() {
+			for (VkImageView levelView : retiredLevelViews) {
+				vkDestroyImageView(vulkanLogicalDevice, levelView, nullptr);
+			}
+			vkDestroyDescriptorPool(vulkanLogicalDevice, retiredDescriptorPool, nullptr);
+		});
+		retireImage(hiZImage, hiZImageView, hiZImageMemory);
+		hiZDescriptorPool = VK_NULL_HANDLE;
+	}
 
+	hiZExtent.width = std::max(1u, roundUpToPowerOfTwo(depthImageCapacity.width) / 2);
+	hiZExtent.height = std::max(1u, roundUpToPowerOfTwo(depthImageCapacity.height) / 2);
+	uint32_t levelCount{ 1 };
+	while ((hiZExtent.width >> levelCount) > 0 || (hiZExtent.height >> levelCount) > 0) {
+		levelCount++;
+	}
 
-	// Create the Vulkan Image that will contain the pixel data from the staging buffer, and will be read from by our shader
-	QueueFamilyIndices queueFamilies = findQueueFamilies(vulkanPhysicalDevice);
-	std::vector<uint32_t> queueFamilyIndices = { queueFamilies.graphicsFamily.value(), queueFamilies.transferFamily.value() };
 	create2DVulkanImage(
-		vulkanLogicalDevice,
-		textureWidth,
-		textureHeight,
-		VK_FORMAT_R8G8B8A8_SRGB,
-		VK_IMAGE_TILING_OPTIMAL,
-		VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-		textureImage,
-		textureDeviceMemory,
-		queueFamilyIndices
+		vulkanLogicalDevice, hiZExtent.width, hiZExtent.height, VK_FORMAT_R32_SFLOAT, VK_IMAGE_TILING_OPTIMAL,
+		VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+		MemoryCategory::Attachment, hiZImage, hiZImageMemory, {}, levelCount
 	);
+	hiZImageView = createImageView(hiZImage, VK_FORMAT_R32_SFLOAT, VK_IMAGE_ASPECT_COLOR_BIT, 0, levelCount);
+	hiZLevelViews.resize(levelCount);
+	for (uint32_t level{ 0 }; level < levelCount; level++) {
+		hiZLevelViews.at(level) = createImageView(hiZImage, VK_FORMAT_R32_SFLOAT, VK_IMAGE_ASPECT_COLOR_BIT, level, 1);
+	}
+
+	// One set per level, plus the culling's
+	std::array<VkDescriptorPoolSize, 2> poolSizes{};
+	poolSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	poolSizes[0].descriptorCount = levelCount + 1;
+	poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+	poolSizes[1].descriptorCount = levelCount;
+	VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+	descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	descriptorPoolCreateInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+	descriptorPoolCreateInfo.pPoolSizes = poolSizes.data();
+	descriptorPoolCreateInfo.maxSets = levelCount + 1;
+	if (vkCreateDescriptorPool(vulkanLogicalDevice, &descriptorPoolCreateInfo, nullptr, &hiZDescriptorPool) != VK_SUCCESS) {
+		throw std::runtime_error("RUNTIME ERROR: Failed to create the Hi-Z descriptor pool!");
+	}
 
-	transitionImageLayout(textureImage, VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-	copyBufferToImage(stagingBuffer, textureImage, static_cast<uint32_t>(textureWidth), static_cast<uint32_t>(textureHeight));
-	transitionImageLayout(textureImage, VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+	std::vector<VkDescriptorSetLayout> descriptorSetLayouts(levelCount, hiZDescriptorSetLayout);
+	descriptorSetLayouts.push_back(hiZSampleDescriptorSetLayout);
+	std::vector<VkDescriptorSet> descriptorSets(descriptorSetLayouts.size());
+	VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+	descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	descriptorSetAllocateInfo.descriptorPool = hiZDescriptorPool;
+	descriptorSetAllocateInfo.pSetLayouts = descriptorSetLayouts.data();
+	descriptorSetAllocateInfo.descriptorSetCount = static_cast<uint32_t>(descriptorSetLayouts.size());
+	if (vkAllocateDescriptorSets(vulkanLogicalDevice, &descriptorSetAllocateInfo, descriptorSets.data()) != VK_SUCCESS) {
+		throw std::runtime_error("RUNTIME ERROR: Failed to allocate the Hi-Z descriptor sets!");
+	}
+	hiZSampleDescriptorSet = descriptorSets.back();
+	descriptorSets.pop_back();
+	hiZLevelDescriptorSets = descriptorSets;
+
+	// Level 0 reads the depth image (as the early render pass leaves it), the others the level above (the pyramid stays in GENERAL)
+	std::vector<VkDescriptorImageInfo> sourceInfos(levelCount);
+	std::vector<VkDescriptorImageInfo> destinationInfos(levelCount);
+	std::vector<VkWriteDescriptorSet> descriptorWrites{};
+	for (uint32_t level{ 0 }; level < levelCount; level++) {
+		sourceInfos.at(level).sampler = hiZSampler;
+		sourceInfos.at(level).imageView = (level == 0) ? depthImageView : hiZLevelViews.at(level - 1);
+		sourceInfos.at(level).imageLayout = (level == 0) ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_GENERAL;
+		destinationInfos.at(level).imageView = hiZLevelViews.at(level);
+		destinationInfos.at(level).imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+		VkWriteDescriptorSet sourceWrite{};
+		sourceWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		sourceWrite.dstSet = hiZLevelDescriptorSets.at(level);
+		sourceWrite.dstBinding = 0;
+		sourceWrite.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		sourceWrite.descriptorCount = 1;
+		sourceWrite.pImageInfo = &sourceInfos.at(level);
+		descriptorWrites.push_back(sourceWrite);
+
+		VkWriteDescriptorSet destinationWrite = sourceWrite;
+		destinationWrite.dstBinding = 1;
+		destinationWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+		destinationWrite.pImageInfo = &destinationInfos.at(level);
+		descriptorWrites.push_back(destinationWrite);
+	}
+	VkDescriptorImageInfo pyramidInfo{ hiZSampler, hiZImageView, VK_IMAGE_LAYOUT_GENERAL };
+	VkWriteDescriptorSet pyramidWrite{};
+	pyramidWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	pyramidWrite.dstSet = hiZSampleDescriptorSet;
+	pyramidWrite.dstBinding = 0;
+	pyramidWrite.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	pyramidWrite.descriptorCount = 1;
+	pyramidWrite.pImageInfo = &pyramidInfo;
+	descriptorWrites.push_back(pyramidWrite);
+	vkUpdateDescriptorSets(vulkanLogicalDevice, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+
+	hiZSourceDepthImageView = depthImageView;
+	hiZHistoryValid = false;  // (its contents are undefined until the next build)
+	hiZInitialized = false;  // (created UNDEFINED, the next recorded frame moves it to GENERAL)
+	std::cout << "> Created Hi-Z pyramid (" << hiZExtent.width << "x" << hiZExtent.height << ", " << levelCount << " levels) successfully.\n";
+}
 
-	vkDestroyBuffer(vulkanLogicalDevice, stagingBuffer, nullptr);
-	vkFreeMemory(vulkanLogicalDevice, stagingBufferMemory, nullptr);
+/// @brief Moves a newly created Hi-Z pyramid from UNDEFINED to the GENERAL layout its descriptors name, before the early culling phase binds it.
+/// @brief Only recorded into the first frame after the pyramid's creation (a pre-recorded command buffer gets re-recorded without it).
+void Application::recordHiZInitialTransition(VkCommandBuffer commandBuffer) {
+	VkImageMemoryBarrier initialBarrier{};
+	initialBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	initialBarrier.srcAccessMask = 0;
+	initialBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+	initialBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	initialBarrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+	initialBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	initialBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	initialBarrier.image = hiZImage;
+	initialBarrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, static_cast<uint32_t>(hiZLevelViews.size()), 0, 1 };
+	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &initialBarrier);
+
+	hiZInitialized = true;
+	if (options.staticCommandBuffers) {
+		invalidateCommandBufferCache();
+	}
 }
 
-void Application::createTextureImageView() {
-	textureImageView = createImageView(textureImage, VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_ASPECT_COLOR_BIT);
+/// @brief Rebuilds the whole Hi-Z pyramid from the depth the early render pass left, one dispatch per level.
+void Application::recordHiZBuild(VkCommandBuffer commandBuffer) {
+	// Every level is rewritten, so the previous pyramid can be discarded once the early culling phase is done reading it
+	VkImageMemoryBarrier discardBarrier{};
+	discardBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	discardBarrier.srcAccessMask = 0;
+	discardBarrier.dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+	discardBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	discardBarrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+	discardBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	discardBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	discardBarrier.image = hiZImage;
+	discardBarrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, static_cast<uint32_t>(hiZLevelViews.size()), 0, 1 };
+	if (!renderGraphEnabled) {
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &discardBarrier);
+	}
+
+	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, hiZPipeline);
+	VkExtent2D sourceExtent = getSceneRenderExtent();  // (only the rendered part of the depth image)
+	for (uint32_t level{ 0 }; level < hiZLevelViews.size(); level++) {
+		VkExtent2D levelExtent = { std::max(1u, hiZExtent.width >> level), std::max(1u, hiZExtent.height >> level) };
+		std::array<int32_t, 4> sizes = {
+			static_cast<int32_t>(sourceExtent.width), static_cast<int32_t>(sourceExtent.height),
+			static_cast<int32_t>(levelExtent.width), static_cast<int32_t>(levelExtent.height)
+		};
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, hiZPipelineLayout, 0, 1, &hiZLevelDescriptorSets.at(level), 0, nullptr);
+		vkCmdPushConstants(commandBuffer, hiZPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(sizes), sizes.data());
+		vkCmdDispatch(commandBuffer, (levelExtent.width + HIZ_WORKGROUP_SIZE - 1) / HIZ_WORKGROUP_SIZE, (levelExtent.height + HIZ_WORKGROUP_SIZE - 1) / HIZ_WORKGROUP_SIZE, 1);
+
+		// The level is read by the next one, and by the culling (this frame's late phase & the next frame's early phase)
+		VkImageMemoryBarrier levelBarrier = discardBarrier;
+		levelBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		levelBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+		levelBarrier.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+		levelBarrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, level, 1, 0, 1 };
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &levelBarrier);
+		sourceExtent = levelExtent;
+	}
+}
+
+/// @brief Writes this frame's frustum planes and bounding sphere for the culling compute shader.
+void Application::updateCullUniforms(uint32_t currentImage, const UniformBufferObject& ubo) {
+	CullUniforms cullUniforms{};
+	std::array<glm::vec4, 6> frustumPlanes = SceneObjects::extractFrustumPlanes(ubo.proj * ubo.view);
+	std::copy(frustumPlanes.begin(), frustumPlanes.end(), cullUniforms.frustumPlanes);
+	// The (animated) model matrix is applied before the instance transform, so move the bounding sphere center along with it
+	cullUniforms.boundingSphere = glm::vec4(glm::vec3(ubo.model * glm::vec4(modelBoundsCenter, 1.0f)), modelBoundsRadius);
+	cullUniforms.objectCount = static_cast<uint32_t>(instances.size());
+	cullUniforms.indexCount = static_cast<uint32_t>(indices.size());
+	cullUniforms.compactDraws = drawIndirectCountSupported ? 1 : 0;
+	cullUniforms.drawCommandCapacity = instanceBufferCapacity;
+	// The early phase tests against the pyramid the previous frame built, so with that frame's camera
+	cullUniforms.viewProjection = ubo.proj * ubo.view;
+	cullUniforms.previousViewProjection = previousViewProjection;
+	cullUniforms.previousHiZValid = hiZHistoryValid ? 1 : 0;
+	memcpy(cullUniformBuffersMapped.at(currentImage), &cullUniforms, sizeof(cullUniforms));
+	previousViewProjection = cullUniforms.viewProjection;
+	hiZHistoryValid = occlusionCullingEnabled;  // (this frame builds one)
+
+#ifndef NDEBUG
+	// Same test on the CPU, compared against the GPU's count once the frame has finished
+	uint32_t expectedVisibleObjectCount{ 0 };
+	for (const InstanceData& instance : instances) {
+		glm::vec3 center = glm::vec3(instance.model * glm::vec4(glm::vec3(cullUniforms.boundingSphere), 1.0f));
+		bool visible{ true };
+		for (const glm::vec4& plane : frustumPlanes) {
+			visible = visible && (glm::dot(glm::vec3(plane), center) + plane.w >= -modelBoundsRadius);
+		}
+		expectedVisibleObjectCount += visible ? 1 : 0;
+	}
+	expectedVisibleObjectCounts.at(currentImage) = expectedVisibleObjectCount;
+#endif
+}
+
+/// @brief Records a culling compute pass: resets the draw counts (except for the late phase, which adds to the early phase's),
+/// @brief dispatches one invocation per object, then makes the indirect draw commands visible to the draw and the draw counts visible to the host.
+void Application::recordCullingPass(VkCommandBuffer commandBuffer, CullPhase phase) {
+	if (phase != CullPhase::Late) {
+		vkCmdFillBuffer(commandBuffer, drawCountBuffers.at(currentFrame), 0, sizeof(uint32_t) * CULL_COUNTER_COUNT, 0);
+
+		VkMemoryBarrier fillToComputeBarrier{};
+		fillToComputeBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		fillToComputeBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		fillToComputeBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+		vkCmdPipelineBarrier(
+			commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+			1, &fillToComputeBarrier, 0, nullptr, 0, nullptr
+		);
+	}
+	else if (!renderGraphEnabled) {
+		// The late phase reads the early phase's re-test flags and counters
+		VkMemoryBarrier earlyToLateBarrier{};
+		earlyToLateBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		earlyToLateBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		earlyToLateBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+		vkCmdPipelineBarrier(
+			commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+			1, &earlyToLateBarrier, 0, nullptr, 0, nullptr
+		);
+	}
+
+	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, cullPipeline);
+	std::array<VkDescriptorSet, 2> descriptorSets = { cullDescriptorSets.at(currentFrame), hiZSampleDescriptorSet };
+	vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, cullPipelineLayout, 0, occlusionCullingEnabled ? 2 : 1, descriptorSets.data(), 0, nullptr);
+	if (occlusionCullingEnabled) {
+		uint32_t phaseValue = static_cast<uint32_t>(phase);
+		vkCmdPushConstants(commandBuffer, cullPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(phaseValue), &phaseValue);
+	}
+	uint32_t workgroupCount = (static_cast<uint32_t>(instances.size()) + CULL_WORKGROUP_SIZE - 1) / CULL_WORKGROUP_SIZE;
+	vkCmdDispatch(commandBuffer, workgroupCount, 1, 1);
+	if (renderGraphEnabled) {
+		return;  // (the render graph makes the writes visible to the draws, and to the host at the end of the frame)
+	}
+
+	// The host read is needed because waiting on the frame's semaphore alone doesn't make device writes visible to the host
+	VkMemoryBarrier computeToDrawBarrier{};
+	computeToDrawBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+	computeToDrawBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+	computeToDrawBarrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_HOST_READ_BIT;
+	vkCmdPipelineBarrier(
+		commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_HOST_BIT, 0,
+		1, &computeToDrawBarrier, 0, nullptr, 0, nullptr
+	);
+}
+
+/// @brief Reads back the visible object counts of the last submission of the given frame in flight (it must have been waited on).
+void Application::readVisibleObjectCount(uint32_t frameIndex) {
+	if (!gpuCullingEnabled || !drawCountsSubmitted.at(frameIndex)) {
+		return;
+	}
+	std::array<uint32_t, 4> counters{};  // (CULL_COUNTER_COUNT)
+	memcpy(counters.data(), drawCountBuffersMapped.at(frameIndex), sizeof(uint32_t) * CULL_COUNTER_COUNT);
+	lastVisibleObjectCount = counters[0] + counters[1];
+	lastFrustumVisibleObjectCount = counters[2];
+	lastOccludedObjectCount = counters[3];
+	drawCountsSubmitted.at(frameIndex) = false;
+
+#ifndef NDEBUG
+	// Objects right on a frustum plane may go either way due to floating point differences, so only report real disagreements
+	uint32_t expectedVisibleObjectCount = expectedVisibleObjectCounts.at(frameIndex);
+	uint32_t tolerance = std::max(1u, expectedVisibleObjectCount / 1000);
+	uint32_t difference = std::max(lastFrustumVisibleObjectCount, expectedVisibleObjectCount) - std::min(lastFrustumVisibleObjectCount, expectedVisibleObjectCount);
+	if (difference > tolerance) {
+		std::cerr << "WARNING: GPU culling found " << lastFrustumVisibleObjectCount << " objects in the frustum, the CPU expected " << expectedVisibleObjectCount << "!\n";
+	}
+#endif
 }
 
 /// @brief Load a 3D Model using tinyobjloader library
@@ -1875,6 +4888,7 @@ void Application::load3DModel() {
 	if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, MODEL_PATH.c_str())) {
 		throw std::runtime_error(warn + err);
 	}
+	StartupProfiler::recordFileRead(MODEL_PATH);
 
 	std::unordered_map<Vertex, uint32_t> uniqueVertices{};
 
@@ -1909,20 +4923,52 @@ void Application::load3DModel() {
 		}
 	}
 
+	// Bounding sphere of the model (centered on its axis aligned bounding box), used to lay out and frame the instances
+	glm::vec3 boundsMin{ std::numeric_limits<float>::max() };
+	glm::vec3 boundsMax{ std::numeric_limits<float>::lowest() };
+	for (const Vertex& vertex : vertices) {
+		boundsMin = glm::min(boundsMin, vertex.position);
+		boundsMax = glm::max(boundsMax, vertex.position);
+	}
+	modelBoundsCenter = 0.5f * (boundsMin + boundsMax);
+	modelBoundsRadius = 0.0f;
+	for (const Vertex& vertex : vertices) {
+		modelBoundsRadius = std::max(modelBoundsRadius, glm::length(vertex.position - modelBoundsCenter));
+	}
+
+	// Bounds of the model spinning around its z axis (the animation): a z aligned cylinder, boxed
+	float spinRadius{ 0.0f };
+	for (const Vertex& vertex : vertices) {
+		spinRadius = std::max(spinRadius, glm::length(glm::vec2(vertex.position.x, vertex.position.y)));
+	}
+	modelSpinBoundsMin = glm::vec3(-spinRadius, -spinRadius, boundsMin.z);
+	modelSpinBoundsMax = glm::vec3(spinRadius, spinRadius, boundsMax.z);
+
 }
 
 void Application::createSynchronizationObjects() {
 
 	imageAvailableSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
 	renderFinishedSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
-	inFlightFences.resize(MAX_FRAMES_IN_FLIGHT);
+	// Value 0 is already reached, so the first wait on every frame slot returns immediately
+	frameSlotTimelineValues.assign(MAX_FRAMES_IN_FLIGHT, 0);
+	frameSlotInputTimes.assign(MAX_FRAMES_IN_FLIGHT, std::chrono::steady_clock::now());
+	frameSlotLatencyPending.assign(MAX_FRAMES_IN_FLIGHT, false);
 
 	VkSemaphoreCreateInfo semaphoreCreateInfo{};
 	semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 
-	VkFenceCreateInfo fenceCreateInfo{};
-	fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-	fenceCreateInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;  // Creates the fence initialized to the signaled state (for the first drawFrame call)
+	// The frame timeline semaphore (starts at 0, incremented by every submitted frame)
+	VkSemaphoreTypeCreateInfo semaphoreTypeCreateInfo{};
+	semaphoreTypeCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+	semaphoreTypeCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+	semaphoreTypeCreateInfo.initialValue = 0;
+	VkSemaphoreCreateInfo timelineSemaphoreCreateInfo{};
+	timelineSemaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+	timelineSemaphoreCreateInfo.pNext = &semaphoreTypeCreateInfo;
+	if (vkCreateSemaphore(vulkanLogicalDevice, &timelineSemaphoreCreateInfo, nullptr, &frameTimelineSemaphore) != VK_SUCCESS) {
+		throw std::runtime_error("RUNTIME ERROR: Failed to create the frame timeline semaphore!");
+	}
 
 	// Create the Synchronization Objects per frame
 	for (size_t i{ 0 }; i < MAX_FRAMES_IN_FLIGHT; i++) {
@@ -1932,9 +4978,6 @@ void Application::createSynchronizationObjects() {
 		if (vkCreateSemaphore(vulkanLogicalDevice, &semaphoreCreateInfo, nullptr, &renderFinishedSemaphores.at(i)) != VK_SUCCESS) {
 			throw std::runtime_error("RUNTIME ERROR: Failed to create 'renderFinishedSemaphore' for frame: " + i);
 		}
-		if (vkCreateFence(vulkanLogicalDevice, &fenceCreateInfo, nullptr, &inFlightFences.at(i)) != VK_SUCCESS) {
-			throw std::runtime_error("RUNTIME ERROR: Failed to create 'inFlightFence' for frame: " + i);
-		}
 	}
 
 	std::cout << "> Created Vulkan synchronization objects successfully.\n";
@@ -1945,6 +4988,55 @@ void Application::createSynchronizationObjects() {
 void Application::framebufferResizeCallback(GLFWwindow* window, int width, int height) {
 	auto application = reinterpret_cast<Application*>(glfwGetWindowUserPointer(window));
 	application->frameBufferResized = true;
+	application->lastResizeEventTime = std::chrono::steady_clock::now();
+}
+
+/// @brief Callback used by GLFW when a key is pressed (see 'initWindow' method).
+void Application::keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
+	auto application = reinterpret_cast<Application*>(glfwGetWindowUserPointer(window));
+	if (action != GLFW_PRESS) {
+		return;
+	}
+	// 'M' prints an on-demand memory telemetry report
+	if (key == GLFW_KEY_M) {
+		application->logMemoryTelemetry();
+	}
+	// 'F' prints the frame statistics and dumps them as CSV
+	if (key == GLFW_KEY_F) {
+		application->logFrameStats();
+		application->writeFrameStatsCsv();
+	}
+	// 'V' switches to the next shading mode (its pipeline variant is compiled in the background the first time)
+	if (key == GLFW_KEY_V) {
+		application->cycleShadingMode();
+	}
+}
+
+/// @brief Draws the scene with the next shading mode. Until its pipeline variant is compiled, the generic variant keeps drawing.
+void Application::cycleShadingMode() {
+	uint32_t shadingMode = (scenePipelineKey.specializationConstants[0] + 1) % static_cast<uint32_t>(ShadingMode::Count);
+	scenePipelineKey.specializationConstants[0] = shadingMode;
+	std::cout << "> Shading mode " << shadingMode << (pipelineRegistry.isReady(scenePipelineKey) ? "" : " (compiling its pipeline variant)") << ".\n";
+	invalidateCommandBufferCache();
+}
+
+/// @brief Smallest power of two >= value (value must be at most 2^31).
+uint32_t Application::roundUpToPowerOfTwo(uint32_t value) {
+	uint32_t powerOfTwo{ 1 };
+	while (powerOfTwo < value) {
+		powerOfTwo <<= 1;
+	}
+	return powerOfTwo;
+}
+
+const char* Application::getPresentModeName(VkPresentModeKHR presentMode) {
+	switch (presentMode) {
+	case VK_PRESENT_MODE_FIFO_KHR:         return "FIFO";
+	case VK_PRESENT_MODE_FIFO_RELAXED_KHR: return "FIFO_RELAXED";
+	case VK_PRESENT_MODE_MAILBOX_KHR:      return "MAILBOX";
+	case VK_PRESENT_MODE_IMMEDIATE_KHR:    return "IMMEDIATE";
+	default:                               return "Unknown";
+	}
 }
 
 /// @brief Reads all the bytes from a specified file and return them in a byte array (vector).
@@ -1964,8 +5056,296 @@ std::vector<char> Application::readFile(const std::string& fileName) {
 	// Read the contents of the whole file at once, into the buffer
 	file.seekg(0);
 	file.read(buffer.data(), fileSize);
+	StartupProfiler::recordBytesRead(fileSize);
 
 	// Close the file
 	file.close();
 	return buffer;
-}
\ No newline at end of file
+}
+
+/// @brief Parses the command line flags into the launch options (unknown flags throw).
+ApplicationOptions ApplicationOptions::fromCommandLine(int argc, char* argv[]) {
+	ApplicationOptions options{};
+
+	for (int i{ 1 }; i < argc; i++) {
+		std::string argument{ argv[i] };
+		// Fetches the value that follows a flag (eg: '--objects 5000')
+		auto nextValue = [&]() -> std::string {
+			if (i + 1 >= argc) {
+				throw std::runtime_error("RUNTIME ERROR: Missing value for command line argument '" + argument + "'.");
+			}
+			return std::string{ argv[++i] };
+		};
+
+		if (argument == "--static-command-buffers") {
+			options.staticCommandBuffers = true;
+		}
+		else if (argument == "--no-static-command-buffers") {
+			options.staticCommandBuffers = false;
+		}
+		else if (argument == "--objects") {
+			options.objectCount = static_cast<uint32_t>(std::max(1UL, std::stoul(nextValue())));
+		}
+		else if (argument == "--no-instancing") {
+			options.instancedRendering = false;
+		}
+		else if (argument == "--instance-benchmark") {
+			options.instanceBenchmark = true;
+		}
+		else if (argument == "--gpu-culling") {
+			options.gpuCulling = true;
+		}
+		else if (argument == "--occlusion-culling") {
+			options.occlusionCulling = true;
+		}
+		else if (argument == "--cpu-culling") {
+			options.cpuCulling = true;
+		}
+		else if (argument == "--culling-benchmark") {
+			options.cullingBenchmark = true;
+		}
+		else if (argument == "--cull-mode") {
+			std::string cullMode = nextValue();
+			if (cullMode == "none") {
+				options.cullMode = VK_CULL_MODE_NONE;
+			}
+			else if (cullMode == "back") {
+				options.cullMode = VK_CULL_MODE_BACK_BIT;
+			}
+			else if (cullMode == "front") {
+				options.cullMode = VK_CULL_MODE_FRONT_BIT;
+			}
+			else {
+				throw std::runtime_error("RUNTIME ERROR: Unknown cull mode '" + cullMode + "' (expected none, back or front).");
+			}
+		}
+		else if (argument == "--shading") {
+			std::string shadingMode = nextValue();
+			if (shadingMode == "textured") {
+				options.shadingMode = ShadingMode::Textured;
+			}
+			else if (shadingMode == "tinted") {
+				options.shadingMode = ShadingMode::Tinted;
+			}
+			else if (shadingMode == "vertex-color") {
+				options.shadingMode = ShadingMode::VertexColor;
+			}
+			else if (shadingMode == "uv") {
+				options.shadingMode = ShadingMode::TextureCoordinates;
+			}
+			else {
+				throw std::runtime_error("RUNTIME ERROR: Unknown shading mode '" + shadingMode + "' (expected textured, tinted, vertex-color or uv).");
+			}
+		}
+		else if (argument == "--record-threads") {
+			options.recordThreadCount = static_cast<uint32_t>(std::stoul(nextValue()));
+		}
+		else if (argument == "--recording-benchmark") {
+			options.recordingBenchmark = true;
+		}
+		else if (argument == "--frames-in-flight") {
+			options.framesInFlight = static_cast<uint32_t>(std::stoul(nextValue()));
+			if (options.framesInFlight < 1 || options.framesInFlight > 4) {
+				throw std::runtime_error("RUNTIME ERROR: '--frames-in-flight' must be between 1 and 4.");
+			}
+		}
+		else if (argument == "--present-mode") {
+			std::string presentMode = nextValue();
+			if (presentMode == "fifo") {
+				options.presentMode = VK_PRESENT_MODE_FIFO_KHR;
+			}
+			else if (presentMode == "mailbox") {
+				options.presentMode = VK_PRESENT_MODE_MAILBOX_KHR;
+			}
+			else if (presentMode == "immediate") {
+				options.presentMode = VK_PRESENT_MODE_IMMEDIATE_KHR;
+			}
+			else {
+				throw std::runtime_error("RUNTIME ERROR: Unknown present mode '" + presentMode + "' (expected fifo, mailbox or immediate).");
+			}
+		}
+		else if (argument == "--headless") {
+			options.headless = true;
+		}
+		else if (argument == "--frames") {
+			options.headlessFrameCount = static_cast<uint32_t>(std::max(1UL, std::stoul(nextValue())));
+		}
+		else if (argument == "--width") {
+			options.width = static_cast<uint32_t>(std::max(1UL, std::stoul(nextValue())));
+		}
+		else if (argument == "--height") {
+			options.height = static_cast<uint32_t>(std::max(1UL, std::stoul(nextValue())));
+		}
+		else if (argument == "--capture") {
+			options.captureDirectory = nextValue();
+		}
+		else if (argument == "--model") {
+			std::string model = nextValue();
+			if (model == "room") {
+				options.modelPath = viking_room_model_path;
+				options.texturePath = viking_room_texture_path;
+			}
+			else if (model == "house") {
+				options.modelPath = viking_house_model_path;
+				options.texturePath = viking_house_texture_path;
+			}
+			else {
+				throw std::runtime_error("RUNTIME ERROR: Unknown model '" + model + "' (expected room or house).");
+			}
+		}
+		else if (argument == "--fixed-timestep") {
+			options.fixedTimestep = std::max(0.0f, std::stof(nextValue()));
+		}
+		else if (argument == "--camera-path") {
+			options.cameraPathFile = nextValue();
+		}
+		else if (argument == "--benchmark") {
+			options.benchmark = true;
+		}
+		else if (argument == "--benchmark-warmup") {
+			options.benchmarkWarmupFrames = static_cast<uint32_t>(std::stoul(nextValue()));
+		}
+		else if (argument == "--benchmark-report") {
+			options.benchmarkReportPath = nextValue();
+		}
+		else if (argument == "--dynamic-rendering") {
+			options.dynamicRendering = true;
+		}
+		else if (argument == "--transient-depth") {
+			options.transientDepth = true;
+		}
+		else if (argument == "--render-graph") {
+			options.renderGraph = true;
+			options.dynamicRendering = true;
+		}
+		else if (argument == "--render-graph-dump") {
+			options.renderGraphDumpPath = nextValue();
+		}
+		else if (argument == "--bindless") {
+			options.bindless = true;
+		}
+		else if (argument == "--dynamic-resolution") {
+			options.dynamicResolution = true;
+		}
+		else if (argument == "--target-gpu-ms") {
+			options.targetGpuFrameMs = std::max(0.1, std::stod(nextValue()));
+		}
+		else if (argument == "--min-resolution-scale") {
+			options.minResolutionScale = std::clamp(std::stof(nextValue()), 0.25f, 1.0f);
+		}
+		else if (argument == "--pipeline-cache") {
+			options.pipelineCachePath = nextValue();
+		}
+		else if (argument == "--no-pipeline-cache") {
+			options.pipelineCachePath.clear();
+		}
+		else if (argument == "--serial-init") {
+			options.serialInit = true;
+		}
+		else if (argument == "--init-graph") {
+			options.initGraphPath = nextValue();
+		}
+		else if (argument == "--startup-report") {
+			options.startupReportPath = nextValue();
+		}
+		else if (argument == "--trace") {
+			options.tracePath = nextValue();
+		}
+		else if (argument == "--resize-storm") {
+			options.resizeStormCount = static_cast<uint32_t>(std::stoul(nextValue()));
+		}
+		else if (argument == "--capture-ring") {
+			options.captureRingSize = static_cast<uint32_t>(std::max(1UL, std::stoul(nextValue())));
+		}
+		else if (argument == "--help" || argument == "-h") {
+			printUsage();
+			std::exit(EXIT_SUCCESS);
+		}
+		else {
+			printUsage();
+			throw std::runtime_error("RUNTIME ERROR: Unknown command line argument '" + argument + "'.");
+		}
+	}
+
+	// The benchmark records a synthetic scene with one draw per object
+	if (options.recordingBenchmark) {
+		options.instancedRendering = false;
+		options.recordThreadCount = std::max(1u, options.recordThreadCount);
+		if (options.objectCount == 1) {
+			options.objectCount = RECORDING_BENCHMARK_DRAW_COUNT;
+		}
+	}
+	// The benchmark must render the same frames on every run
+	if (options.benchmark) {
+		if (options.fixedTimestep <= 0.0f) {
+			options.fixedTimestep = DEFAULT_BENCHMARK_TIMESTEP;
+		}
+		if (options.cameraPathFile.empty()) {
+			options.cameraPathFile = DEFAULT_BENCHMARK_CAMERA_PATH;
+		}
+	}
+	// Occlusion culling runs in the GPU culling's compute passes
+	if (options.occlusionCulling) {
+		options.gpuCulling = true;
+	}
+	// Readback copies the offscreen images (swapchain images are owned by the presentation engine)
+	if (!options.captureDirectory.empty() && !options.headless) {
+		throw std::runtime_error("RUNTIME ERROR: '--capture' requires '--headless'.");
+	}
+	// There's no window to resize
+	if (options.resizeStormCount > 0 && options.headless) {
+		throw std::runtime_error("RUNTIME ERROR: '--resize-storm' requires a window (not '--headless').");
+	}
+	// Secondary command buffers are recorded every frame (one time submit), so there's nothing to cache
+	if (options.recordThreadCount > 0 && options.staticCommandBuffers) {
+		std::cout << "> Multi-threaded recording re-records every frame, disabling static command buffers.\n";
+		options.staticCommandBuffers = false;
+	}
+	return options;
+}
+
+void ApplicationOptions::printUsage() {
+	std::cout << "Usage: <application> [options]\n"
+		<< "\t--static-command-buffers       Pre-record command buffers, re-record only on swapchain/scene changes (default)\n"
+		<< "\t--no-static-command-buffers    Re-record the command buffer every frame\n"
+		<< "\t--objects <count>              Number of objects (copies of the model) in the scene (default: 1)\n"
+		<< "\t--no-instancing                Issue one draw call per object instead of a single instanced draw\n"
+		<< "\t--instance-benchmark           Sweep the object count from 1 to 100k, report CPU/GPU frame times and exit\n"
+		<< "\t--gpu-culling                  Frustum cull the objects in a compute shader and draw them with indirect draws\n"
+		<< "\t--occlusion-culling            GPU culling plus two phase Hi-Z occlusion culling against the previous frame's depth\n"
+		<< "\t--cpu-culling                  Frustum cull the objects on the CPU (SIMD) and only upload & draw the visible ones\n"
+		<< "\t--culling-benchmark            Time the scalar/SSE/AVX2 CPU frustum tests on 1k to 1M objects and exit\n"
+		<< "\t--cull-mode <none|back|front>  Face culling of the scene's pipeline variant (default: none)\n"
+		<< "\t--shading <mode>               textured, tinted, vertex-color or uv (default: textured, 'V' cycles them at runtime)\n"
+		<< "\t--record-threads <count>       Record the draws on <count> worker threads into secondary command buffers (default: 0, inline)\n"
+		<< "\t--recording-benchmark          Record a 50k draw scene with 1 to N threads, report the recording times and exit\n"
+		<< "\t--frames-in-flight <1-4>       Number of frames the CPU may record ahead of the GPU (default: 2)\n"
+		<< "\t--present-mode <mode>          fifo, mailbox or immediate (default: mailbox if supported, else fifo)\n"
+		<< "\t--headless                     Render offscreen without a window (works on software drivers like lavapipe)\n"
+		<< "\t--frames <count>               Number of frames rendered by a headless run (default: 300)\n"
+		<< "\t--width <pixels>               Width of the window / offscreen images (default: 800)\n"
+		<< "\t--height <pixels>              Height of the window / offscreen images (default: 600)\n"
+		<< "\t--capture <directory>          Headless only: write every rendered frame to <directory> as PPM, without stalling the render loop\n"
+		<< "\t--capture-ring <count>         Number of readback buffers of the capture (default: 4, frames are dropped when all are busy)\n"
+		<< "\t--model <room|house>           Model to render (default: room)\n"
+		<< "\t--fixed-timestep <seconds>     Advance the animation by a fixed step every frame instead of the wall clock\n"
+		<< "\t--camera-path <file>           Follow a scripted camera path (see benchmarks/camera_path.txt for the format)\n"
+		<< "\t--benchmark                    Run the benchmark scenarios (fixed timestep & camera path), write a JSON report and exit\n"
+		<< "\t--benchmark-warmup <frames>    Frames rendered before measuring each scenario (default: 60, measured frames: --frames)\n"
+		<< "\t--benchmark-report <file>      Path of the JSON benchmark report (default: benchmark_report.json)\n"
+		<< "\t--dynamic-rendering            Render without render pass & framebuffer objects (vkCmdBeginRendering on the image views)\n"
+		<< "\t--transient-depth              Transient depth attachment in lazily allocated memory (ignored with --occlusion-culling)\n"
+		<< "\t--render-graph                 Record the frame through the render graph, barriers compiled once (implies --dynamic-rendering)\n"
+		<< "\t--render-graph-dump <file>     Write the compiled render graph schedule (passes, barriers, transient images) to a file\n"
+		<< "\t--bindless                     One descriptor set per frame: a texture array & per-object data indexed in the shaders\n"
+		<< "\t--dynamic-resolution           Render the scene at a scale that holds the GPU frame time target, upscaled onto the swapchain\n"
+		<< "\t--target-gpu-ms <ms>           GPU frame time held by the dynamic resolution (default: 16)\n"
+		<< "\t--min-resolution-scale <scale> Lowest resolution scale (0.25 to 1) the dynamic resolution may use (default: 0.5)\n"
+		<< "\t--pipeline-cache <file>        Pipeline cache loaded at startup and saved on exit (default: pipeline_cache.bin)\n"
+		<< "\t--no-pipeline-cache            Start with an empty pipeline cache and don't save it (cold pipeline creation)\n"
+		<< "\t--serial-init                  Run the initialization steps one after the other instead of on several threads\n"
+		<< "\t--init-graph <file>            Write the executed initialization graph (per-task threads & timings) as JSON\n"
+		<< "\t--startup-report <file>        Write the startup phases (wall & CPU time, bytes read, heap & device memory) as JSON\n"
+		<< "\t--trace <file>                 Write a timeline of the CPU & GPU scopes as Chrome trace JSON (chrome://tracing, Perfetto)\n"
+		<< "\t--resize-storm <count>         Resize the window <count> times, report the swapchain recreation hitches and exit\n";
+}
@@ -9,6 +9,21 @@
 #include <glm/gtx/hash.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <GLFW/glfw3.h>
+#include "MemoryTelemetry.h"
+#include "ThreadPool.h"
+#include "FrameStats.h"
+#include "GpuProfiler.h"
+#include "FrameCapture.h"
+#include "CameraPath.h"
+#include "DeferredDeletionQueue.h"
+#include "SceneObjects.h"
+#include "PipelineCache.h"
+#include "PipelineRegistry.h"
+#include "TaskGraph.h"
+#include "StartupProfiler.h"
+#include "Tracer.h"
+#include "TransientAllocator.h"
+#include "RenderGraph.h"
 #include <unordered_map>
 #include <stdexcept>
 #include <algorithm>
@@ -22,6 +37,8 @@
 #include <vector>
 #include <bitset>
 #include <chrono>
+#include <memory>
+#include <thread>
 #include <array>
 #include <set>
 
@@ -33,29 +50,171 @@ const std::string viking_room_texture_path{ "models/viking-room/viking_room.png"
 const std::string viking_house_model_path{ "models/viking-house/source/final/viking-house.obj" };
 const std::string viking_house_texture_path{ "models/viking-house/textures/123_Material_color.png" };
 
+/// @brief What the fragment shader outputs ('SHADING_MODE' specialization constant of shader.frag).
+enum class ShadingMode : uint32_t {
+	Textured = 0,       // the model's texture (the generic pipeline variant)
+	Tinted,             // texture modulated by the vertex colors
+	VertexColor,        // vertex colors only
+	TextureCoordinates, // texture coordinates as red & green
+	Count
+};
+
+/// @brief Options chosen at launch (see 'ApplicationOptions::fromCommandLine' for the command line flags).
+struct ApplicationOptions {
+	/// @brief Pre-record one command buffer per (swapchain image, frame in flight) pair and only re-record it when invalidated.
+	bool staticCommandBuffers{ true };
+	/// @brief Number of objects (placed copies of the model, laid out on a grid) in the scene.
+	uint32_t objectCount{ 1 };
+	/// @brief Draw every object with a single instanced draw call. If false, one draw call is issued per object.
+	bool instancedRendering{ true };
+	/// @brief Sweep the object count from 1 to 100k, report CPU & GPU frame times for each step and exit.
+	bool instanceBenchmark{ false };
+	/// @brief Frustum cull the objects in a compute shader and draw the visible ones with a single indirect (count) draw.
+	bool gpuCulling{ false };
+	/// @brief Two phase Hi-Z occlusion culling on top of GPU culling (implies it): the objects hidden behind the previous frame's depth
+	/// @brief are skipped, then re-tested against the current frame's early depth so the disoccluded ones are still drawn.
+	bool occlusionCulling{ false };
+	/// @brief Frustum cull the objects on the CPU (SIMD, see 'SceneObjects') and only upload & draw the visible ones. Ignored with GPU culling.
+	bool cpuCulling{ false };
+	/// @brief Time the scalar, SSE & AVX2 CPU frustum tests on 1k to 1M objects, check they agree and exit (no Vulkan needed).
+	bool cullingBenchmark{ false };
+	/// @brief Face culling and shading of the scene's graphics pipeline variant (compiled in the background, see 'PipelineRegistry').
+	VkCullModeFlags cullMode{ VK_CULL_MODE_NONE };
+	ShadingMode shadingMode{ ShadingMode::Textured };
+	/// @brief Number of worker threads recording the draws into secondary command buffers (0 records everything inline).
+	uint32_t recordThreadCount{ 0 };
+	/// @brief Record a 50k draw scene with 1 to N worker threads, report the recording time for each and exit.
+	bool recordingBenchmark{ false };
+
+	/// @brief Number of frames the CPU may record ahead of the GPU (1 to 4). Fewer frames means lower latency, more means higher throughput.
+	uint32_t framesInFlight{ 2 };
+	/// @brief Requested swapchain present mode (FIFO, MAILBOX or IMMEDIATE). If not set (or not supported) MAILBOX is preferred, then FIFO.
+	std::optional<VkPresentModeKHR> presentMode;
+
+	/// @brief Render offscreen without a window, surface or swapchain (eg: on a software driver like lavapipe), then exit.
+	bool headless{ false };
+	/// @brief Number of frames rendered by a headless run.
+	uint32_t headlessFrameCount{ DEFAULT_HEADLESS_FRAME_COUNT };
+	/// @brief Size of the window (or of the offscreen images in headless mode).
+	uint32_t width{ 800 };
+	uint32_t height{ 600 };
+	/// @brief Headless mode: directory the rendered frames are captured to (as PPM files). Empty disables the capture.
+	std::string captureDirectory;
+	/// @brief Number of readback buffers in the capture ring. Frames are dropped (not captured) when all of them are busy.
+	uint32_t captureRingSize{ FrameCapture::DEFAULT_RING_SIZE };
+
+	/// @brief The model (and its texture) rendered.
+	std::string modelPath{ viking_room_model_path };
+	std::string texturePath{ viking_room_texture_path };
+	/// @brief Seconds the animation advances every frame. 0 animates with the wall clock.
+	float fixedTimestep{ 0.0f };
+	/// @brief Scripted camera path file (see 'CameraPath'). Empty keeps the default camera.
+	std::string cameraPathFile;
+	/// @brief Run the deterministic benchmark scenarios (see 'Benchmark'), write the JSON report and exit.
+	bool benchmark{ false };
+	/// @brief Frames rendered before the benchmark starts measuring (the measured frames are 'headlessFrameCount').
+	uint32_t benchmarkWarmupFrames{ DEFAULT_BENCHMARK_WARMUP_FRAMES };
+	std::string benchmarkReportPath{ "benchmark_report.json" };
+	/// @brief Render the scene into an offscreen target whose resolution adapts to the GPU frame time, and upscale it into the swapchain image.
+	bool dynamicResolution{ false };
+	/// @brief Render with vkCmdBeginRendering on the image views (no render pass & framebuffer objects), if the GPU supports dynamic rendering.
+	bool dynamicRendering{ false };
+	/// @brief Create the depth attachment as a transient attachment in lazily allocated memory (when the GPU has it), since it's never read after the frame.
+	bool transientDepth{ false };
+	/// @brief Record the frame through the render graph (passes declaring their reads & writes, barriers compiled once). Needs dynamic rendering.
+	bool renderGraph{ false };
+	/// @brief File the compiled render graph schedule (passes, barriers, transient placements) is written to. Empty disables it.
+	std::string renderGraphDumpPath;
+	/// @brief Bind a single descriptor set per frame: every texture in one partially bound, update after bind array, and the per-object data
+	/// @brief in a storage buffer, both selected by index in the shaders. Needs descriptor indexing (core in Vulkan 1.2).
+	bool bindless{ false };
+	/// @brief GPU frame time (ms) the dynamic resolution holds, and the lowest resolution scale it may go down to.
+	double targetGpuFrameMs{ 16.0 };
+	float minResolutionScale{ 0.5f };
+	/// @brief File the pipeline cache is loaded from at startup and saved to on exit (see 'PipelineCache'). Empty keeps it in memory only.
+	std::string pipelineCachePath{ "pipeline_cache.bin" };
+	/// @brief Run the initialization steps one after the other on the main thread (instead of the task graph's threads).
+	bool serialInit{ false };
+	/// @brief File the executed initialization graph (tasks, dependencies, threads & timings) is written to as JSON. Empty disables it.
+	std::string initGraphPath;
+	/// @brief File the startup phases (wall & CPU time, bytes read, heap & device memory allocated per step) are written to as JSON. Empty disables it.
+	std::string startupReportPath;
+	/// @brief File the timeline of the run (CPU scopes of every thread & GPU scopes) is written to as Chrome trace-event JSON. Empty disables tracing.
+	std::string tracePath;
+	/// @brief Resize the window this many times in a scripted storm, report the swapchain recreation hitches and exit (0 disables).
+	uint32_t resizeStormCount{ 0 };
+
+	/// @brief Default object count of the recording benchmark.
+	static constexpr uint32_t RECORDING_BENCHMARK_DRAW_COUNT{ 50000 };
+	/// @brief Default number of frames rendered by a headless run.
+	static constexpr uint32_t DEFAULT_HEADLESS_FRAME_COUNT{ 300 };
+	/// @brief Benchmark defaults: warmup frames, timestep (60 Hz) and camera path.
+	static constexpr uint32_t DEFAULT_BENCHMARK_WARMUP_FRAMES{ 60 };
+	static constexpr float DEFAULT_BENCHMARK_TIMESTEP{ 1.0f / 60.0f };
+	static constexpr const char* DEFAULT_BENCHMARK_CAMERA_PATH{ "benchmarks/camera_path.txt" };
+
+	static ApplicationOptions fromCommandLine(int argc, char* argv[]);
+	static void printUsage();
+};
+
+/// @brief What a benchmark run of the application measured (over the measured frames only).
+struct BenchmarkResult {
+	bool completed{ false };
+	std::string deviceName;
+	std::string apiVersion;
+	uint32_t driverVersion{ 0 };
+	uint32_t objectCount{ 0 };
+	uint32_t measuredFrames{ 0 };
+	double wallTimeSeconds{ 0.0 };
+	FrameMetricSummary cpuFrame;
+	FrameMetricSummary cpuWork;
+	FrameMetricSummary gpuFrame;
+	uint64_t drawCallsPerFrame{ 0 };
+	uint64_t trianglesPerFrame{ 0 };  // submitted triangles (before GPU culling)
+	uint32_t visibleObjects{ 0 };  // objects left after GPU / CPU culling (every object without it)
+	uint32_t occludedObjects{ 0 };  // objects in the frustum skipped by occlusion culling
+	double pipelineCreationMs{ 0.0 };  // startup time spent creating pipelines
+	bool pipelineCacheWarm{ false };  // the pipeline cache was loaded from disk
+	VkDeviceSize trackedMemoryBytes{ 0 };
+	std::array<VkDeviceSize, static_cast<size_t>(MemoryCategory::Count)> memoryCategoryBytes{};
+};
+
 // Forward declarations
 struct QueueFamilyIndices;
 struct SwapChainSupportDetails;
 struct Vertex;
+struct InstanceData;
+struct ObjectData;
 struct UniformBufferObject;
+struct CullUniforms;
+
+/// @brief Dispatch of the GPU culling compute shader (the value is its 'phase' push constant with occlusion culling).
+enum class CullPhase : uint32_t {
+	Frustum = 0,  // frustum test only (no occlusion culling)
+	Early,        // frustum & previous frame's Hi-Z pyramid, before the early render pass
+	Late          // re-test of what the early phase occluded against the current pyramid, before the late render pass
+};
 
 // APPLICATION CLASS
 class Application {
 public:
+	explicit Application(const ApplicationOptions& options = {});
 	void run();
+	const BenchmarkResult& getBenchmarkResult() const { return benchmarkResult; }
 
 private:
 	// Members:
-	GLFWwindow* window;
+	const ApplicationOptions options;
+	GLFWwindow* window = nullptr;  // stays null in headless mode
 	const char* APPLICATION_NAME = "Vulkan Application";
-	const uint32_t WIDTH{ 800 };
-	const uint32_t HEIGHT{ 600 };
+	const uint32_t WIDTH{ options.width };
+	const uint32_t HEIGHT{ options.height };
 	VkCullModeFlags RASTERIZER_CULL_MODE = VK_CULL_MODE_NONE;
-	const std::string MODEL_PATH{ viking_room_model_path };
-	const std::string TEXTURE_PATH{ viking_room_texture_path };
+	const std::string MODEL_PATH{ options.modelPath };
+	const std::string TEXTURE_PATH{ options.texturePath };
 
 	VkInstance vulkanInstance = VK_NULL_HANDLE;
-	const int MAX_FRAMES_IN_FLIGHT{ 2 };
+	const uint32_t MAX_FRAMES_IN_FLIGHT{ options.framesInFlight };  // chosen at launch
 	uint32_t currentFrame{ 0 };
 	VkPhysicalDevice vulkanPhysicalDevice = VK_NULL_HANDLE;
 	VkDevice vulkanLogicalDevice = VK_NULL_HANDLE;
@@ -68,13 +227,26 @@ private:
 	VkColorSpaceKHR vulkanSwapChainImageColorspace;
 	VkExtent2D vulkanSwapChainExtent;
 	VkRenderPass vulkanRenderPass = VK_NULL_HANDLE;	
+	bool dynamicRenderingEnabled{ false };  // requested and supported: no render pass nor framebuffers, only the attachment formats
+	VkFormat sceneDepthFormat{ VK_FORMAT_UNDEFINED };
+	// Render graph (see 'buildRenderGraph'): the frame's passes and the barriers between them, compiled once per set of resources
+	bool renderGraphEnabled{ false };  // requested and dynamic rendering enabled
+	std::shared_ptr<RenderGraph> renderGraph;  // (shared with the deferred deletion of a retired graph)
+	RenderGraph::ResourceId renderGraphSwapChainImage{ 0 };
+	uint32_t renderGraphImageIndex{ 0 };  // swapchain image the graph is being recorded for
+	VkExtent2D renderGraphExtent{ 0, 0 };  // depth image capacity the graph was built for
+	bool renderGraphHiZInitialized{ false };  // whether the graph was built to keep the Hi-Z pyramid (rather than discard it)
 	VkPipelineLayout vulkanPipelineLayout = VK_NULL_HANDLE;
-	VkPipeline vulkanGraphicsPipeline = VK_NULL_HANDLE;
 	VkCommandPool vulkanGraphicsCommandPool = VK_NULL_HANDLE;  // graphics command pool
 	std::vector<VkCommandBuffer> vulkanGraphicsCommandBuffers;  // graphics command buffers (size based on frames in flight)
+	std::vector<VkCommandBuffer> cachedGraphicsCommandBuffers;  // pre-recorded command buffers (one per swapchain image & frame in flight pair)
+	std::vector<uint64_t> cachedGraphicsCommandBufferGenerations;  // cache generation each pre-recorded command buffer was recorded at
+	uint64_t commandBufferCacheGeneration{ 1 };  // bumped to invalidate every pre-recorded command buffer
 	VkCommandPool vulkanTransferCommandPool = VK_NULL_HANDLE;  // transfer command pool
 	VkCommandBuffer vulkanTransferCommandBuffer = VK_NULL_HANDLE; // transfer command buffer
-	std::vector<VkImage> vulkanSwapChainImages;
+	std::vector<VkImage> vulkanSwapChainImages;  // the offscreen color images in headless mode (one per frame in flight)
+	std::vector<VkDeviceMemory> offscreenImagesMemory;  // headless mode only
+	const VkFormat OFFSCREEN_IMAGE_FORMAT{ VK_FORMAT_B8G8R8A8_SRGB };  // same as the preferred swapchain format
 	std::vector<VkImageView> vulkanSwapChainImageViews;
 	std::vector<VkFramebuffer> vulkanSwapChainFramebuffers;
 	VkBuffer vertexBuffer = VK_NULL_HANDLE;  // vertex buffer
@@ -87,27 +259,222 @@ private:
 	VkDescriptorSetLayout vulkanDescriptorSetLayout = VK_NULL_HANDLE;  // descriptor set layout
 	VkDescriptorPool vulkanDescriptorPool = VK_NULL_HANDLE;  // descriptor pool
 	std::vector<VkDescriptorSet> vulkanDescriptorSets;  // descriptor sets
+	// Bindless descriptors: a single set holding every frame's uniform & object buffers (arrays indexed by the 'frameIndex' push constant)
+	// and the texture array (indexed by each object's 'textureIndex'), bound once per command buffer
+	bool bindlessEnabled{ false };  // requested and descriptor indexing supported
+	const uint32_t MAX_BINDLESS_TEXTURES{ 4096 };
+	const uint32_t BINDLESS_SCENE_TEXTURE_SLOT{ 0 };  // the model's texture
+	uint32_t bindlessTextureCapacity{ 0 };  // size of the texture array (within the GPU's update after bind limits)
+	uint32_t bindlessTextureCount{ 0 };  // slots written so far (the others are left unbound)
+	VkDescriptorSet bindlessDescriptorSet = VK_NULL_HANDLE;
+
+	// Memory telemetry (every allocation made through createBuffer/create2DVulkanImage is tagged and tracked)
+	MemoryTelemetry memoryTelemetry;
+	bool memoryBudgetExtensionEnabled{ false };
+	bool calibratedTimestampsExtensionEnabled{ false };  // aligns the GPU timestamps of the trace to the CPU clock
+	const double MEMORY_TELEMETRY_LOG_INTERVAL_SECONDS{ 30.0 };  // 0 disables the periodic log (press 'M' for an on-demand report)
+	std::chrono::steady_clock::time_point lastMemoryTelemetryLogTime;
 
 	// Texture properties
 	VkImage textureImage = VK_NULL_HANDLE;
 	VkImageView textureImageView = VK_NULL_HANDLE;
 	VkSampler textureSampler = VK_NULL_HANDLE;
 	VkDeviceMemory textureDeviceMemory = VK_NULL_HANDLE;
+	std::vector<uint8_t> decodedTexturePixels;  // RGBA8, decoded ahead of 'createTextureImage' (released by it)
+	uint32_t decodedTextureWidth{ 0 };
+	uint32_t decodedTextureHeight{ 0 };
+
+	// Initialization (task graph, see 'initVulkan')
+	const uint32_t MAX_INIT_THREAD_COUNT{ 4 };
+	StartupProfiler startupProfiler;
 
 	// Depth properties
-	VkImage depthImage;
-	VkDeviceMemory depthImageMemory;
-	VkImageView depthImageView;
+	VkImage depthImage = VK_NULL_HANDLE;
+	VkDeviceMemory depthImageMemory = VK_NULL_HANDLE;
+	VkImageView depthImageView = VK_NULL_HANDLE;
+	VkExtent2D depthImageCapacity{ 0, 0 };  // allocated size, at least the swapchain extent (grow-only power-of-two buckets with a window)
+	uint32_t depthImageAllocationCount{ 0 };
+	bool transientDepthEnabled{ false };  // requested and the depth isn't read after the frame (no occlusion culling)
+	TransientAllocator transientAllocator;
+	TransientBlock transientDepthBlock{};  // the depth image's memory when transient
+
+	// Dynamic resolution: the scene is rendered into the top-left 'getSceneRenderExtent()' of the scene color image,
+	// then blitted (linear filter) onto the whole swapchain image. The scale follows the GPU frame time.
+	bool dynamicResolutionEnabled{ false };  // requested and supported (blits of the swapchain format)
+	VkImage sceneColorImage = VK_NULL_HANDLE;  // same size as the depth image
+	VkDeviceMemory sceneColorImageMemory = VK_NULL_HANDLE;
+	VkImageView sceneColorImageView = VK_NULL_HANDLE;
+	VkExtent2D sceneColorImageCapacity{ 0, 0 };
+	float resolutionScale{ 1.0f };  // of the swapchain extent, per axis
+	uint64_t resolutionScaleChangeFrame{ 0 };  // first frame rendered at the current scale
+	uint64_t lastResolutionScaleGpuFrame{ 0 };  // GPU result the controller last looked at
+	uint32_t resolutionScaleHeadroomFrames{ 0 };  // consecutive GPU results well below the target
+	const float RESOLUTION_SCALE_STEP{ 0.05f };  // scales are multiples of the step (so the cached command buffers rarely change)
+	const double RESOLUTION_SCALE_DROP_MARGIN{ 0.9 };  // when over the target, aim for this fraction of it
+	const double RESOLUTION_SCALE_RAISE_THRESHOLD{ 0.8 };  // only raise when under this fraction of the target...
+	const uint32_t RESOLUTION_SCALE_RAISE_FRAMES{ 30 };  // ...for this many consecutive frames
 
 	// 3D Model properties
 	std::vector<Vertex> vertices;
 	std::vector<uint32_t> indices;
+	glm::vec3 modelBoundsCenter{ 0.0f };  // bounding sphere of the model (in model space)
+	float modelBoundsRadius{ 1.0f };
+	glm::vec3 modelSpinBoundsMin{ 0.0f };  // AABB enclosing the model at every angle of its animation (spin around the z axis)
+	glm::vec3 modelSpinBoundsMax{ 0.0f };
+
+	// Instancing properties (every object in the scene is one instance of the model)
+	const float INSTANCE_GRID_SPACING_FACTOR{ 2.5f };  // spacing between grid cells, in model bounding sphere radii
+	std::vector<InstanceData> instances;  // CPU instance list (copied into the current frame's instance buffer every frame)
+	float sceneBoundsRadius{ 1.0f };  // radius of the sphere (centered at the origin) enclosing every instance
+	uint32_t instanceBufferCapacity{ 0 };  // max number of instances the instance buffers can hold
+	std::vector<VkBuffer> instanceBuffers;  // per-instance vertex buffers (size based on frames in flight)
+	std::vector<VkDeviceMemory> instanceBuffersMemory;
+	std::vector<void*> instanceBuffersMapped;
+	std::vector<ObjectData> objects;  // per-object data (bindless only), copied next to the instances every frame
+	std::vector<VkBuffer> objectBuffers;  // per-object storage buffers, in the instance buffer's order (size based on frames in flight)
+	std::vector<VkDeviceMemory> objectBuffersMemory;
+	std::vector<void*> objectBuffersMapped;
+
+	// Pipeline cache, persisted across launches (every pipeline is created through it)
+	PipelineCache pipelineCache;
+	// Graphics pipeline variants: the scene is drawn with its variant once it's compiled, with the generic variant until then
+	PipelineRegistry pipelineRegistry;
+	const uint32_t PIPELINE_COMPILER_THREAD_COUNT{ 1 };
+	std::vector<char> sceneVertexShaderCode;  // loaded ahead of 'createGraphicsPipeline' (released by it)
+	std::vector<char> sceneFragmentShaderCode;
+	std::vector<char> bindlessVertexShaderCode;  // (only loaded with '--bindless', used if descriptor indexing is supported)
+	std::vector<char> bindlessFragmentShaderCode;
+	VkShaderModule sceneVertexShaderModule = VK_NULL_HANDLE;
+	VkShaderModule sceneFragmentShaderModule = VK_NULL_HANDLE;
+	GraphicsPipelineKey scenePipelineKey{};  // (changed on the render loop thread only)
+	uint64_t pipelineReadyGeneration{ 0 };  // registry generation the pre-recorded command buffers were invalidated at
+
+	// GPU profiling (timestamps around the frame & named scopes, pipeline statistics around the render pass)
+	GpuProfiler gpuProfiler;
+	std::vector<const char*> gpuScopeTraceNames;  // the GPU profiler's scope names, interned for the trace
+	bool gpuPipelineStatisticsSupported{ false };  // set in 'createLogicalDevice'
+
+	// CPU culling: world space bounds of every instance, tested against the frustum every frame.
+	// The visible instances are packed at the front of the instance buffer, so the draws only cover them.
+	bool cpuCullingEnabled{ false };  // requested, and GPU culling isn't enabled
+	SceneObjects sceneObjects;
+	std::vector<uint64_t> objectVisibilityMask;  // bit per instance, from the last 'SceneObjects::cull'
+
+	// GPU-driven culling (compute shader frustum test writing the indirect draw commands)
+	bool gpuCullingEnabled{ false };  // requested and supported by the GPU
+	bool drawIndirectCountSupported{ false };  // vkCmdDrawIndexedIndirectCount (else the draws aren't compacted)
+	bool multiDrawIndirectSupported{ false };  // more than one draw per vkCmdDrawIndexedIndirect call
+	const uint32_t CULL_WORKGROUP_SIZE{ 64 };  // must match 'local_size_x' in cull.comp
+	VkDescriptorSetLayout cullDescriptorSetLayout = VK_NULL_HANDLE;
+	VkPipelineLayout cullPipelineLayout = VK_NULL_HANDLE;
+	VkPipeline cullPipeline = VK_NULL_HANDLE;
+	VkDescriptorPool cullDescriptorPool = VK_NULL_HANDLE;
+	std::vector<VkDescriptorSet> cullDescriptorSets;  // (size based on frames in flight)
+	std::vector<VkBuffer> cullUniformBuffers;  // frustum planes & object count (size based on frames in flight)
+	std::vector<VkDeviceMemory> cullUniformBuffersMemory;
+	std::vector<void*> cullUniformBuffersMapped;
+	std::vector<VkBuffer> indirectDrawBuffers;  // one VkDrawIndexedIndirectCommand per object (size based on frames in flight)
+	std::vector<VkDeviceMemory> indirectDrawBuffersMemory;
+	std::vector<VkBuffer> drawCountBuffers;  // number of visible objects, also read back for stats (size based on frames in flight)
+	std::vector<VkDeviceMemory> drawCountBuffersMemory;
+	std::vector<void*> drawCountBuffersMapped;
+	std::vector<bool> drawCountsSubmitted;
+	uint32_t lastVisibleObjectCount{ 0 };  // (also the CPU culling result, when it's enabled instead)
+	const uint32_t CULL_COUNTER_COUNT{ 4 };  // early draws, late draws, in frustum, occluded (see 'DrawCountBuffer' in cull.comp)
+	uint32_t lastFrustumVisibleObjectCount{ 0 };
+	uint32_t lastOccludedObjectCount{ 0 };
+
+	// Hi-Z occlusion culling (on top of GPU culling). The scene is drawn in two render passes: the early one draws what the previous
+	// frame's Hi-Z pyramid doesn't occlude, the pyramid is then rebuilt from its depth, and the late one draws what the re-test against
+	// the new pyramid finds disoccluded. The next frame's early phase tests against that pyramid.
+	bool occlusionCullingEnabled{ false };  // requested and GPU culling enabled
+	const uint32_t HIZ_WORKGROUP_SIZE{ 8 };  // must match 'local_size_x/y' in hiz.comp
+	VkRenderPass vulkanLateRenderPass = VK_NULL_HANDLE;  // loads what the early render pass drew (compatible with it)
+	VkImage hiZImage = VK_NULL_HANDLE;  // max depth pyramid (R32 float), level 0 is about half the depth image
+	VkDeviceMemory hiZImageMemory = VK_NULL_HANDLE;
+	VkImageView hiZImageView = VK_NULL_HANDLE;  // every level (read by the culling)
+	std::vector<VkImageView> hiZLevelViews;  // one per level (written by the downsample)
+	VkExtent2D hiZExtent{ 0, 0 };
+	VkImageView hiZSourceDepthImageView = VK_NULL_HANDLE;  // depth image view the pyramid's descriptors were written for
+	VkSampler hiZSampler = VK_NULL_HANDLE;  // nearest (only read with texelFetch)
+	VkDescriptorSetLayout hiZDescriptorSetLayout = VK_NULL_HANDLE;  // downsample: source & destination level
+	VkDescriptorSetLayout hiZSampleDescriptorSetLayout = VK_NULL_HANDLE;  // culling: the whole pyramid (set 1)
+	VkPipelineLayout hiZPipelineLayout = VK_NULL_HANDLE;
+	VkPipeline hiZPipeline = VK_NULL_HANDLE;
+	VkDescriptorPool hiZDescriptorPool = VK_NULL_HANDLE;  // recreated (and the old one retired) along with the pyramid
+	std::vector<VkDescriptorSet> hiZLevelDescriptorSets;
+	VkDescriptorSet hiZSampleDescriptorSet = VK_NULL_HANDLE;
+	std::vector<VkBuffer> occlusionStateBuffers;  // re-test flag per object, early to late phase (size based on frames in flight)
+	std::vector<VkDeviceMemory> occlusionStateBuffersMemory;
+	bool hiZHistoryValid{ false };  // a pyramid was built since it was (re)created
+	bool hiZInitialized{ false };  // the pyramid was moved out of its initial UNDEFINED layout (by a recorded frame)
+	glm::mat4 previousViewProjection{ 1.0f };  // of the frame the current pyramid is built by
+#ifndef NDEBUG
+	std::vector<uint32_t> expectedVisibleObjectCounts;  // CPU frustum test results, cross-checked against the GPU's
+#endif
+
+	// Multi-threaded command recording (each worker records a slice of the draws into its own secondary command buffer)
+	std::unique_ptr<ThreadPool> recordingThreadPool;
+	uint32_t recordingSlotCount{ 0 };  // command pools / secondary command buffers per frame in flight
+	uint32_t activeRecordingSlotCount{ 0 };  // how many of them are used (the draws are split into this many slices)
+	std::vector<VkCommandPool> recordingCommandPools;  // one per (frame in flight, slot): [frame * recordingSlotCount + slot]
+	std::vector<VkCommandBuffer> recordingSecondaryCommandBuffers;  // allocated from the command pool with the same index
+	const uint32_t RECORDING_BENCHMARK_WARMUP_FRAMES{ 30 };
+	const uint32_t RECORDING_BENCHMARK_MEASURED_FRAMES{ 200 };
+
+	// Instance benchmark
+	const std::vector<uint32_t> INSTANCE_BENCHMARK_COUNTS{ 1, 10, 100, 1000, 10000, 100000 };
+	const uint32_t INSTANCE_BENCHMARK_WARMUP_FRAMES{ 30 };
+	const uint32_t INSTANCE_BENCHMARK_MEASURED_FRAMES{ 300 };
 
 	// Synchronization objects:
 	std::vector<VkSemaphore> imageAvailableSemaphores;
 	std::vector <VkSemaphore> renderFinishedSemaphores;
-	std::vector<VkFence> inFlightFences;
-	bool frameBufferResized{ false };
+	// Frame scheduling: one timeline semaphore counts submitted frames. Frame slot 'i' can be reused
+	// once the semaphore reaches the value its last submission signals (replaces one fence per frame).
+	VkSemaphore frameTimelineSemaphore = VK_NULL_HANDLE;
+	uint64_t frameTimelineValue{ 0 };  // value signalled by the most recently submitted frame
+	std::vector<uint64_t> frameSlotTimelineValues;  // value signalled by the last submission of each frame slot
+	VkPresentModeKHR vulkanSwapChainPresentMode = VK_PRESENT_MODE_FIFO_KHR;
+	bool frameBufferResized{ false };  // a resize is pending (applied once the window size has settled)
+	std::chrono::steady_clock::time_point lastResizeEventTime;
+	const double RESIZE_DEBOUNCE_MS{ 50.0 };  // the window size must be stable this long before the swapchain is recreated
+
+	// Swapchain recreation never waits for the device to go idle: the resources of the old swapchain are
+	// destroyed through this queue once the frames submitted before the recreation have finished
+	DeferredDeletionQueue deferredDeletions;
+	uint32_t swapChainRecreateCount{ 0 };
+	double lastSwapChainRecreateMs{ 0.0 };  // CPU time of the most recent recreation
+	const uint32_t RESIZE_STORM_BASELINE_FRAMES{ 60 };  // steady frames measured before the storm
+	const uint32_t RESIZE_STORM_FRAMES_PER_RESIZE{ 3 };
+	const std::vector<glm::vec2> RESIZE_STORM_SIZE_FACTORS{ { 0.75f, 0.75f }, { 0.5f, 0.8f }, { 1.25f, 0.6f }, { 1.0f, 1.0f } };  // of the initial window size, cycled through
+
+	// Input latency: from polling input to the GPU finishing the frame built from it
+	std::chrono::steady_clock::time_point lastInputPollTime;
+	std::vector<std::chrono::steady_clock::time_point> frameSlotInputTimes;  // input poll time of each frame slot's last submission
+	std::vector<bool> frameSlotLatencyPending;
+	double lastInputLatencyMs{ 0.0 };
+
+	// Frame statistics (every 'drawFrame' records its timings, press 'F' to dump them as CSV)
+	FrameStats frameStats;
+	FrameSample lastFrameSample;  // timings of the most recent frame
+	uint64_t frameNumber{ 0 };
+	const uint32_t FRAME_STATS_REPORT_INTERVAL_FRAMES{ 1000 };  // 0 disables the periodic report
+	const std::string FRAME_STATS_CSV_PATH{ "frame_stats.csv" };
+
+	// Scripted camera & benchmark mode
+	CameraPath cameraPath;  // empty unless a camera path file was given
+	BenchmarkResult benchmarkResult;
+
+	// Frame capture (headless mode): every frame is copied into the next buffer of a readback ring,
+	// which is encoded to disk on the capture's own thread once the GPU is done with it
+	FrameCapture frameCapture;
+	std::vector<VkBuffer> captureBuffers;  // (size based on the capture ring size)
+	std::vector<VkDeviceMemory> captureBuffersMemory;
+	std::vector<void*> captureBuffersMapped;
+	bool captureMemoryCoherent{ true };
+	std::vector<VkCommandBuffer> captureCommandBuffers;  // (size based on frames in flight)
+
 	// Validation layers are now common for instance and devices:
 	const std::vector<const char*> vulkanValidationLayers = {
 		"VK_LAYER_KHRONOS_validation"
@@ -117,6 +484,12 @@ private:
 	const std::vector<const char*> deviceExtensions = {
 		VK_KHR_SWAPCHAIN_EXTENSION_NAME
 	};
+	// List of physical device extensions that are enabled only if the GPU supports them:
+	const std::vector<const char*> optionalDeviceExtensions = {
+		VK_EXT_MEMORY_BUDGET_EXTENSION_NAME,
+		VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME
+	};
+	std::vector<const char*> enabledDeviceExtensions;
 
 #ifdef NDEBUG 
 	// Release Mode:
@@ -139,12 +512,18 @@ private:
 	void pickVulkanPhysicalDevice();
 	void createLogicalDevice();
 	void recreateSwapChain();
+	void retireSwapChainResources();
+	bool isResizeSettled() const;
 	void cleanupSwapChain();
 	void createSwapChain();
+	void createOffscreenImages();
 	void createSwapChainImageViews();
 	void createRenderPass();
 	void createDescriptorSetLayout();
+	void loadShaderCode();
 	void createGraphicsPipeline();
+	VkPipeline createGraphicsPipelineVariant(const GraphicsPipelineKey& key, VkPipelineCache cache);
+	void cycleShadingMode();
 	void createFramebuffers();
 	VkShaderModule createShaderModule(const std::vector<char>& compiledShaderCode);
 	void createGraphicsCommandPool();
@@ -152,28 +531,91 @@ private:
 	void createVertexBuffer();
 	void createIndexBuffer();
 	void createUniformBuffers();
+	void createInstanceBuffers();
+	void setInstanceCount(uint32_t instanceCount);
+	void updateInstanceBuffer(uint32_t currentImage);
+	void createGpuProfiler();
+	void createPipelineCache();
+	void runInstanceBenchmark();
+	void createCullingResources();
+	void updateCullUniforms(uint32_t currentImage, const UniformBufferObject& ubo);
+	void recordCullingPass(VkCommandBuffer commandBuffer, CullPhase phase);
+	void readVisibleObjectCount(uint32_t frameIndex);
+	void createOcclusionCullingPipeline();
+	void createHiZResources();
+	void recordHiZInitialTransition(VkCommandBuffer commandBuffer);
+	void recordHiZBuild(VkCommandBuffer commandBuffer);
 	void createDescriptorPool();
 	void createDescriptorSets();
+	void createBindlessDescriptorSet();
+	void writeBindlessTexture(uint32_t slot, VkImageView imageView, VkSampler sampler);
+	void bindBindlessDescriptorSet(VkCommandBuffer commandBuffer);
 	void updateUniformBuffers(uint32_t currentImage);
 	void createGraphicsCommandBuffers();
 	void createTransferCommandBuffer();
+	void createCachedGraphicsCommandBuffers();
+	void freeCachedGraphicsCommandBuffers();
+	void invalidateCommandBufferCache();
+	VkCommandBuffer getCachedGraphicsCommandBuffer(uint32_t swapChainImageIndex);
 	void recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t swapChainImageIndex);
+	void recordSceneDraws(VkCommandBuffer commandBuffer, uint32_t firstObject, uint32_t objectCount, bool lateDraws = false);
+	void recordFramePasses(VkCommandBuffer commandBuffer, uint32_t swapChainImageIndex);
+	void recordScenePass(VkCommandBuffer commandBuffer, uint32_t swapChainImageIndex, bool latePass);
+	void beginSceneRendering(VkCommandBuffer commandBuffer, uint32_t swapChainImageIndex, bool latePass, bool secondaryContents);
+	void buildRenderGraph();
+	void retireRenderGraph();
+	void endSceneRendering(VkCommandBuffer commandBuffer, uint32_t swapChainImageIndex, bool latePass);
+	void createRecordingThreadResources();
+	void destroyRecordingThreadResources();
+	void recordSecondaryCommandBuffers(uint32_t swapChainImageIndex);
+	void runRecordingBenchmark();
 	void createSynchronizationObjects();
 	void drawFrame();
-
-	void createBuffer(VkDevice logicalDevice, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags memoryProperties, VkBuffer& outVkBuffer, VkDeviceMemory& outBufferMemory, const std::vector<uint32_t>& queueFamilyIndices = {});
-	void create2DVulkanImage(VkDevice logicalDevice, uint32_t width, uint32_t height, VkFormat imageFormat, VkImageTiling imageTiling, VkImageUsageFlags usageFlags, VkMemoryPropertyFlags memoryProperties, VkImage& outImage, VkDeviceMemory& outImageDeviceMemory, const std::vector<uint32_t>& queueFamilyIndices = {});
+	void pollInput();
+	bool isWindowCloseRequested() const;
+	void runHeadless();
+	void runBenchmark();
+	void runResizeStorm();
+	const char* getRenderPathName() const;
+	float getAnimationTime() const;
+	uint64_t getDrawCallsPerFrame() const;
+	uint64_t getDescriptorSetBindsPerFrame() const;
+	uint32_t getDrawnObjectCount() const;
+	void createFrameCaptureResources();
+	void destroyFrameCaptureResources();
+	void recordCaptureCommands(VkCommandBuffer commandBuffer, uint32_t swapChainImageIndex, uint32_t captureSlot);
+	bool isMemoryTypeAvailable(VkMemoryPropertyFlags properties);
+	std::vector<const char*> getRequiredDeviceExtensions() const;
+	double waitForFrameSlot(uint32_t frameIndex);
+	void pollCompletedFrames();
+	void logFrameStats();
+	void traceGpuFrame(const GpuFrameResult& result);
+	void writeFrameStatsCsv();
+
+	void createBuffer(VkDevice logicalDevice, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags memoryProperties, MemoryCategory memoryCategory, VkBuffer& outVkBuffer, VkDeviceMemory& outBufferMemory, const std::vector<uint32_t>& queueFamilyIndices = {});
+	void create2DVulkanImage(VkDevice logicalDevice, uint32_t width, uint32_t height, VkFormat imageFormat, VkImageTiling imageTiling, VkImageUsageFlags usageFlags, VkMemoryPropertyFlags memoryProperties, MemoryCategory memoryCategory, VkImage& outImage, VkDeviceMemory& outImageDeviceMemory, const std::vector<uint32_t>& queueFamilyIndices = {}, uint32_t mipLevels = 1);
+	void freeDeviceMemory(VkDeviceMemory& memory);
+	void logMemoryTelemetry();
+	void logStartupReport();
 	VkFormat findSupportedFormat(const std::vector<VkFormat>& candidates, VkImageTiling tiling, VkFormatFeatureFlags features);
 	VkFormat findDepthFormat();
 	bool hasStencilComponent(VkFormat format);
 	void createDepthResources();
-	VkImageView createImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags);
+	void createTransientDepthImage(VkExtent2D extent, VkFormat format);
+	void logTransientDepthReport();
+	void retireImage(VkImage& image, VkImageView& imageView, VkDeviceMemory& imageMemory);
+	void checkDynamicResolutionSupport();
+	void createSceneColorResources();
+	VkExtent2D getSceneRenderExtent() const;
+	void updateResolutionScale();
+	void recordUpscale(VkCommandBuffer commandBuffer, uint32_t swapChainImageIndex);
+	VkImageView createImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags, uint32_t baseMipLevel = 0, uint32_t levelCount = 1);
 	void createTextureSampler();
 	void beginSingleTimeTransferCommands();
 	void submitAndEndSingleTimeTransferCommands();
 	void copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size);
 	void copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height);
-	void transitionImageLayout(VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout);
+	void transitionImageLayout(VkImage image, RenderGraphAccess oldAccess, RenderGraphAccess newAccess);
 	bool isPhysicalDeviceSuitable(VkPhysicalDevice physicalDevice);
 	QueueFamilyIndices findQueueFamilies(VkPhysicalDevice physicalDevice);
 	SwapChainSupportDetails querySwapChainSupport(VkPhysicalDevice physicalDevice);
@@ -182,14 +624,19 @@ private:
 	VkExtent2D chooseSwapExtent(const VkSurfaceCapabilitiesKHR& surfaceCapabilities);
 	bool checkValidationLayersSupport();
 	bool checkPhysicalDeviceExtensionsSupport(VkPhysicalDevice physicalDevice);
+	bool isPhysicalDeviceExtensionSupported(VkPhysicalDevice physicalDevice, const char* extensionName);
 	uint32_t findMemoryType(uint32_t typefilter, VkMemoryPropertyFlags properties);
+	void decodeTextureImage();
 	void createTextureImage();
 	void createTextureImageView();
 	void load3DModel();
 
 	// static methods:
 	static void framebufferResizeCallback(GLFWwindow* window, int width, int height);
+	static void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
 	static std::vector<char> readFile(const std::string& fileName);
+	static const char* getPresentModeName(VkPresentModeKHR presentMode);
+	static uint32_t roundUpToPowerOfTwo(uint32_t value);
 
 };
 
@@ -266,6 +713,34 @@ struct Vertex {
 	}
 };
 
+/// @brief Per-instance vertex data (the transform placing one copy of the model in the world).
+struct InstanceData {
+	glm::mat4 model;
+
+	/// @brief Instance data is read from binding 1, advancing once per instance instead of once per vertex.
+	static VkVertexInputBindingDescription getBindingDescription() {
+		VkVertexInputBindingDescription bindingInputDescription{};
+		bindingInputDescription.binding = 1;
+		bindingInputDescription.stride = sizeof(InstanceData);
+		bindingInputDescription.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+		return bindingInputDescription;
+	}
+
+	/// @brief A mat4 attribute takes up 4 consecutive locations (one vec4 column each), following the Vertex attributes.
+	static std::array<VkVertexInputAttributeDescription, 4> getAttributeDescriptions() {
+		std::array<VkVertexInputAttributeDescription, 4> inputAttributeDescriptions{};
+
+		for (uint32_t column{ 0 }; column < 4; column++) {
+			inputAttributeDescriptions.at(column).binding = 1;
+			inputAttributeDescriptions.at(column).location = 3 + column;  // The corresponding shader layout location for: inInstanceModel
+			inputAttributeDescriptions.at(column).format = VK_FORMAT_R32G32B32A32_SFLOAT;  // vec4 of floats
+			inputAttributeDescriptions.at(column).offset = offsetof(InstanceData, model) + sizeof(glm::vec4) * column;
+		}
+
+		return inputAttributeDescriptions;
+	}
+};
+
 namespace std {
 	template<> struct hash<Vertex> {
 		size_t operator()(Vertex const& vertex) const {
@@ -276,6 +751,16 @@ namespace std {
 	};
 }
 
+/// @brief Per-object data of the bindless path, read by the vertex shader from the storage buffer (std430, indexed by the instance index).
+struct ObjectData {
+	uint32_t textureIndex;  // slot in the bindless texture array
+};
+
+/// @brief Push constants of the bindless scene pipeline layout (vertex stage).
+struct ScenePushConstants {
+	uint32_t frameIndex;  // selects this frame's uniform & object buffers in their descriptor arrays
+};
+
 // UBO definition
 struct UniformBufferObject {
 	alignas(16) glm::mat4 model;
@@ -283,4 +768,15 @@ struct UniformBufferObject {
 	alignas(16) glm::mat4 proj;
 };
 
-
+// Parameters of the GPU culling compute shader (see 'shaders/cull.comp')
+struct CullUniforms {
+	alignas(16) glm::vec4 frustumPlanes[6];  // xyz = inward facing normal, w = distance
+	alignas(16) glm::vec4 boundingSphere;  // xyz = center, w = radius
+	uint32_t objectCount;
+	uint32_t indexCount;
+	uint32_t compactDraws;
+	uint32_t drawCommandCapacity;  // first draw command of the late phase
+	alignas(16) glm::mat4 viewProjection;  // occlusion culling only (from here on)
+	alignas(16) glm::mat4 previousViewProjection;
+	uint32_t previousHiZValid;
+};
@@ -0,0 +1,269 @@
+
+#include "Benchmark.h"
+#include <filesystem>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <cctype>
+#include <random>
+
+
+std::vector<BenchmarkScenario> Benchmark::getDefaultScenarios() {
+	return {
+		// Bundled models
+		{ "viking-room", viking_room_model_path, viking_room_texture_path, 1, false, false },
+		{ "viking-house", viking_house_model_path, viking_house_texture_path, 1, false, false },
+		// Synthetic scaled scenes (grids of the same model)
+		{ "viking-room-grid-1k", viking_room_model_path, viking_room_texture_path, 1000, false, false },
+		{ "viking-room-grid-10k", viking_room_model_path, viking_room_texture_path, 10000, false, false },
+		{ "viking-room-grid-10k-gpu-culled", viking_room_model_path, viking_room_texture_path, 10000, true, false },
+		{ "viking-room-grid-10k-cpu-culled", viking_room_model_path, viking_room_texture_path, 10000, false, true },
+		{ "viking-room-grid-10k-occlusion-culled", viking_room_model_path, viking_room_texture_path, 10000, true, false, true },
+	};
+}
+
+/// @brief Runs every default scenario and writes the report to 'options.benchmarkReportPath'.
+/// @return The process exit code (failure if no scenario completed or the report couldn't be written).
+int Benchmark::run(const ApplicationOptions& options) {
+	std::vector<BenchmarkScenarioOutcome> outcomes{};
+	for (const BenchmarkScenario& scenario : getDefaultScenarios()) {
+		std::cout << "\n> Benchmark scenario '" << scenario.name << "' (" << scenario.objectCount << " objects"
+			<< (scenario.gpuCulling ? ", GPU culled" : "") << (scenario.cpuCulling ? ", CPU culled" : "")
+			<< (scenario.occlusionCulling ? ", occlusion culled" : "") << "):\n";
+
+		BenchmarkScenarioOutcome outcome{};
+		outcome.scenario = scenario;
+		if (!std::filesystem::exists(scenario.modelPath)) {
+			outcome.error = "missing model '" + scenario.modelPath + "'";
+		}
+		else if (!std::filesystem::exists(scenario.texturePath)) {
+			outcome.error = "missing texture '" + scenario.texturePath + "'";
+		}
+		else {
+			ApplicationOptions scenarioOptions = options;
+			scenarioOptions.modelPath = scenario.modelPath;
+			scenarioOptions.texturePath = scenario.texturePath;
+			scenarioOptions.objectCount = scenario.objectCount;
+			scenarioOptions.gpuCulling = scenario.gpuCulling;
+			scenarioOptions.cpuCulling = scenario.cpuCulling;
+			scenarioOptions.occlusionCulling = scenario.occlusionCulling;
+			try {
+				Application application(scenarioOptions);
+				application.run();
+				outcome.result = application.getBenchmarkResult();
+				if (!outcome.result.completed) {
+					outcome.error = "interrupted";
+				}
+			}
+			catch (const std::exception& e) {
+				// (a scenario failing half way through its initialization leaks its Vulkan objects until the process exits)
+				outcome.error = e.what();
+			}
+		}
+		if (!outcome.error.empty()) {
+			std::cerr << "WARNING: Benchmark scenario '" << scenario.name << "' did not complete: " << outcome.error << "\n";
+		}
+		outcomes.push_back(outcome);
+	}
+
+	// Summary
+	std::cout << "\n> Benchmark summary (" << options.headlessFrameCount << " measured frames per scenario):\n" << std::fixed << std::setprecision(3);
+	size_t completedCount{ 0 };
+	for (const BenchmarkScenarioOutcome& outcome : outcomes) {
+		std::cout << "\t" << std::left << std::setw(34) << outcome.scenario.name << std::right;
+		if (outcome.error.empty()) {
+			completedCount++;
+			std::cout << "CPU p50 " << outcome.result.cpuFrame.p50 << " ms, p99 " << outcome.result.cpuFrame.p99 << " ms, "
+				<< "GPU p50 " << outcome.result.gpuFrame.p50 << " ms, " << outcome.result.drawCallsPerFrame << " draws";
+			if (outcome.scenario.occlusionCulling) {
+				// Compared with frustum culling alone on the GPU, for the same object count
+				std::cout << ", " << outcome.result.occludedObjects << " occluded";
+				for (const BenchmarkScenarioOutcome& baseline : outcomes) {
+					if (baseline.error.empty() && baseline.scenario.gpuCulling && !baseline.scenario.occlusionCulling
+						&& baseline.scenario.modelPath == outcome.scenario.modelPath && baseline.scenario.objectCount == outcome.scenario.objectCount) {
+						std::cout << ", GPU p50 " << (baseline.result.gpuFrame.p50 - outcome.result.gpuFrame.p50) << " ms saved vs '" << baseline.scenario.name << "'";
+						break;
+					}
+				}
+			}
+			std::cout << "\n";
+		}
+		else {
+			std::cout << "FAILED (" << outcome.error << ")\n";
+		}
+	}
+	std::cout << std::defaultfloat;
+
+	std::ofstream reportFile(options.benchmarkReportPath);
+	if (!reportFile.is_open()) {
+		std::cerr << "WARNING: Failed to write the benchmark report to '" << options.benchmarkReportPath << "'!\n";
+		return EXIT_FAILURE;
+	}
+	writeJsonReport(reportFile, options, outcomes);
+	std::cout << "> Wrote the benchmark report to '" << options.benchmarkReportPath << "'.\n";
+	return completedCount > 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/// @brief Culls random objects (a fixed seed, so every run tests the same scene) spread around a camera, with every supported path.
+/// @return The process exit code (failure if a path disagrees with the scalar reference).
+int Benchmark::runCulling() {
+	// Camera at the center of the object cube, looking along +x (about a tenth of the objects end up in the frustum)
+	const float sceneHalfExtent{ 1000.0f };
+	glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+	glm::mat4 proj = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, sceneHalfExtent);
+	proj[1][1] *= -1;
+	std::array<glm::vec4, 6> frustumPlanes = SceneObjects::extractFrustumPlanes(proj * view);
+
+	std::cout << "\n> CPU culling benchmark (best supported path: " << SceneObjects::getPathName(SceneObjects::getBestSupportedPath())
+		<< ", " << CULLING_BENCHMARK_PASSES << " passes per measurement):\n" << std::fixed << std::setprecision(4);
+	bool pathsAgree{ true };
+	for (uint32_t objectCount : CULLING_BENCHMARK_OBJECT_COUNTS) {
+		std::mt19937 random(objectCount);
+		std::uniform_real_distribution<float> position(-sceneHalfExtent, sceneHalfExtent);
+		std::uniform_real_distribution<float> halfSize(0.5f, 5.0f);
+		SceneObjects sceneObjects;
+		sceneObjects.reserve(objectCount);
+		for (uint32_t i{ 0 }; i < objectCount; i++) {
+			glm::vec3 center{ position(random), position(random), position(random) };
+			glm::vec3 halfExtent{ halfSize(random), halfSize(random), halfSize(random) };
+			sceneObjects.add(center, glm::length(halfExtent), center - halfExtent, center + halfExtent);
+		}
+
+		std::vector<uint64_t> referenceMask{};
+		uint32_t visibleCount = sceneObjects.cull(frustumPlanes, referenceMask, CullingPath::Scalar);
+		double scalarMs{ 0.0 };
+		std::cout << "\t" << std::setw(7) << objectCount << " objects (" << visibleCount << " visible):";
+		for (CullingPath path : { CullingPath::Scalar, CullingPath::Sse, CullingPath::Avx2 }) {
+			if (!SceneObjects::isPathSupported(path)) {
+				std::cout << "  " << SceneObjects::getPathName(path) << " unsupported";
+				continue;
+			}
+			std::vector<uint64_t> visibilityMask{};
+			auto startTime = std::chrono::steady_clock::now();
+			for (uint32_t pass{ 0 }; pass < CULLING_BENCHMARK_PASSES; pass++) {
+				sceneObjects.cull(frustumPlanes, visibilityMask, path);
+			}
+			double cullMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count() / CULLING_BENCHMARK_PASSES;
+			if (path == CullingPath::Scalar) {
+				scalarMs = cullMs;
+			}
+			std::cout << "  " << SceneObjects::getPathName(path) << " " << cullMs << " ms (" << std::setprecision(0) << objectCount / std::max(cullMs, 1e-6)
+				<< " objects/ms, x" << std::setprecision(2) << scalarMs / std::max(cullMs, 1e-6) << ")" << std::setprecision(4);
+			if (visibilityMask != referenceMask) {
+				std::cout << " MISMATCH";
+				pathsAgree = false;
+			}
+		}
+		std::cout << "\n";
+	}
+	std::cout << std::defaultfloat;
+
+	if (!pathsAgree) {
+		std::cerr << "WARNING: The SIMD culling paths disagree with the scalar reference!\n";
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+/// @brief Writes the configuration, the device and every scenario outcome as JSON.
+void Benchmark::writeJsonReport(std::ostream& out, const ApplicationOptions& options, const std::vector<BenchmarkScenarioOutcome>& outcomes) {
+	auto writeSummary = [&out](const char* name, const FrameMetricSummary& summary) {
+		out << "\t\t\t\"" << name << "\": { \"mean\": " << summary.mean << ", \"p50\": " << summary.p50 << ", \"p95\": " << summary.p95
+			<< ", \"p99\": " << summary.p99 << ", \"max\": " << summary.max << " },\n";
+	};
+
+	// The device is the same for every scenario (take it from the first one that got that far)
+	const BenchmarkResult* deviceResult = nullptr;
+	for (const BenchmarkScenarioOutcome& outcome : outcomes) {
+		if (!outcome.result.deviceName.empty()) {
+			deviceResult = &outcome.result;
+			break;
+		}
+	}
+
+	out << std::fixed << std::setprecision(4);
+	out << "{\n";
+	out << "\t\"reportVersion\": " << REPORT_VERSION << ",\n";
+	out << "\t\"configuration\": {\n"
+		<< "\t\t\"headless\": " << (options.headless ? "true" : "false") << ",\n"
+		<< "\t\t\"width\": " << options.width << ",\n"
+		<< "\t\t\"height\": " << options.height << ",\n"
+		<< "\t\t\"framesInFlight\": " << options.framesInFlight << ",\n"
+		<< "\t\t\"warmupFrames\": " << options.benchmarkWarmupFrames << ",\n"
+		<< "\t\t\"measuredFrames\": " << options.headlessFrameCount << ",\n"
+		<< "\t\t\"fixedTimestepSeconds\": " << options.fixedTimestep << ",\n"
+		<< "\t\t\"cameraPath\": \"" << escapeJson(options.cameraPathFile) << "\",\n"
+		<< "\t\t\"staticCommandBuffers\": " << (options.staticCommandBuffers ? "true" : "false") << ",\n"
+		<< "\t\t\"instancedRendering\": " << (options.instancedRendering ? "true" : "false") << ",\n"
+		<< "\t\t\"recordThreads\": " << options.recordThreadCount << "\n"
+		<< "\t},\n";
+	out << "\t\"device\": {\n"
+		<< "\t\t\"name\": \"" << (deviceResult ? escapeJson(deviceResult->deviceName) : std::string{}) << "\",\n"
+		<< "\t\t\"apiVersion\": \"" << (deviceResult ? deviceResult->apiVersion : std::string{}) << "\",\n"
+		<< "\t\t\"driverVersion\": " << (deviceResult ? deviceResult->driverVersion : 0) << "\n"
+		<< "\t},\n";
+
+	out << "\t\"scenarios\": [\n";
+	for (size_t i{ 0 }; i < outcomes.size(); i++) {
+		const BenchmarkScenarioOutcome& outcome = outcomes.at(i);
+		const BenchmarkResult& result = outcome.result;
+		out << "\t\t{\n"
+			<< "\t\t\t\"name\": \"" << escapeJson(outcome.scenario.name) << "\",\n"
+			<< "\t\t\t\"model\": \"" << escapeJson(outcome.scenario.modelPath) << "\",\n"
+			<< "\t\t\t\"objectCount\": " << outcome.scenario.objectCount << ",\n"
+			<< "\t\t\t\"gpuCulling\": " << (outcome.scenario.gpuCulling ? "true" : "false") << ",\n"
+			<< "\t\t\t\"cpuCulling\": " << (outcome.scenario.cpuCulling ? "true" : "false") << ",\n"
+			<< "\t\t\t\"occlusionCulling\": " << (outcome.scenario.occlusionCulling ? "true" : "false") << ",\n";
+		if (!outcome.error.empty()) {
+			out << "\t\t\t\"status\": \"error\",\n"
+				<< "\t\t\t\"error\": \"" << escapeJson(outcome.error) << "\"\n";
+		}
+		else {
+			out << "\t\t\t\"status\": \"ok\",\n";
+			writeSummary("cpuFrameMs", result.cpuFrame);
+			writeSummary("cpuWorkMs", result.cpuWork);
+			writeSummary("gpuFrameMs", result.gpuFrame);
+			out << "\t\t\t\"wallTimeSeconds\": " << result.wallTimeSeconds << ",\n"
+				<< "\t\t\t\"framesPerSecond\": " << (result.wallTimeSeconds > 0.0 ? result.measuredFrames / result.wallTimeSeconds : 0.0) << ",\n"
+				<< "\t\t\t\"drawCallsPerFrame\": " << result.drawCallsPerFrame << ",\n"
+				<< "\t\t\t\"trianglesPerFrame\": " << result.trianglesPerFrame << ",\n"
+				<< "\t\t\t\"visibleObjects\": " << result.visibleObjects << ",\n"
+				<< "\t\t\t\"occludedObjects\": " << result.occludedObjects << ",\n"
+				<< "\t\t\t\"pipelineCreationMs\": " << result.pipelineCreationMs << ",\n"
+				<< "\t\t\t\"pipelineCacheWarm\": " << (result.pipelineCacheWarm ? "true" : "false") << ",\n"
+				<< "\t\t\t\"memory\": {\n"
+				<< "\t\t\t\t\"trackedBytes\": " << result.trackedMemoryBytes;
+			for (uint32_t category{ 0 }; category < static_cast<uint32_t>(MemoryCategory::Count); category++) {
+				std::string categoryName = MemoryTelemetry::getCategoryName(static_cast<MemoryCategory>(category));
+				categoryName.front() = static_cast<char>(std::tolower(static_cast<unsigned char>(categoryName.front())));
+				out << ",\n\t\t\t\t\"" << categoryName << "Bytes\": " << result.memoryCategoryBytes.at(category);
+			}
+			out << "\n\t\t\t}\n";
+		}
+		out << "\t\t}" << (i + 1 < outcomes.size() ? "," : "") << "\n";
+	}
+	out << "\t]\n";
+	out << "}\n";
+	out << std::defaultfloat;
+}
+
+std::string Benchmark::escapeJson(const std::string& text) {
+	std::ostringstream escaped;
+	for (char c : text) {
+		switch (c) {
+		case '"':  escaped << "\\\""; break;
+		case '\\': escaped << "\\\\"; break;
+		case '\n': escaped << "\\n"; break;
+		case '\r': escaped << "\\r"; break;
+		case '\t': escaped << "\\t"; break;
+		default:
+			if (static_cast<unsigned char>(c) < 0x20) {
+				escaped << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+			}
+			else {
+				escaped << c;
+			}
+		}
+	}
+	return escaped.str();
+}
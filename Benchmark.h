@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Application.h"
+#include <ostream>
+#include <string>
+#include <array>
+#include <vector>
+
+/// @brief One scene rendered by the benchmark.
+struct BenchmarkScenario {
+	std::string name;
+	std::string modelPath;
+	std::string texturePath;
+	uint32_t objectCount{ 1 };
+	bool gpuCulling{ false };
+	bool cpuCulling{ false };
+	bool occlusionCulling{ false };  // (on top of GPU culling)
+};
+
+/// @brief Outcome of one scenario: the measurements, or why it didn't complete.
+struct BenchmarkScenarioOutcome {
+	BenchmarkScenario scenario;
+	BenchmarkResult result;
+	std::string error;  // empty if the scenario completed
+};
+
+/// @brief Deterministic frame benchmark ('--benchmark'): renders every scenario in its own Application with a fixed timestep
+/// @brief and a scripted camera path (warmup phase, then measured phase), and writes a JSON report comparable across commits.
+class Benchmark {
+public:
+	/// @brief Bumped whenever the layout of the JSON report changes.
+	static constexpr uint32_t REPORT_VERSION{ 4 };  // 2: scenarios report 'cpuCulling', 3: 'occlusionCulling' & 'occludedObjects', 4: 'pipelineCreationMs' & 'pipelineCacheWarm'
+	/// @brief Object counts of the CPU culling benchmark, and the passes timed for each path.
+	static constexpr std::array<uint32_t, 4> CULLING_BENCHMARK_OBJECT_COUNTS{ 1000, 10000, 100000, 1000000 };
+	static constexpr uint32_t CULLING_BENCHMARK_PASSES{ 50 };
+
+	static std::vector<BenchmarkScenario> getDefaultScenarios();
+	static int run(const ApplicationOptions& options);
+	/// @brief CPU frustum culling benchmark ('--culling-benchmark'): times every 'CullingPath' on random objects and checks them against the scalar path.
+	static int runCulling();
+
+	static void writeJsonReport(std::ostream& out, const ApplicationOptions& options, const std::vector<BenchmarkScenarioOutcome>& outcomes);
+
+private:
+	static std::string escapeJson(const std::string& text);
+};
@@ -0,0 +1,65 @@
+
+#include "CameraPath.h"
+#include <stdexcept>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <cmath>
+
+
+CameraPath CameraPath::loadFromFile(const std::string& filePath) {
+	std::ifstream file(filePath);
+	if (!file.is_open()) {
+		throw std::runtime_error("RUNTIME ERROR: Failed to open camera path file '" + filePath + "'!");
+	}
+
+	CameraPath path{};
+	std::string line{};
+	uint32_t lineNumber{ 0 };
+	while (std::getline(file, line)) {
+		lineNumber++;
+		line = line.substr(0, line.find('#'));
+		if (line.find_first_not_of(" \t\r") == std::string::npos) {
+			continue;
+		}
+		std::istringstream lineStream(line);
+		CameraKeyframe keyframe{};
+		if (!(lineStream >> keyframe.time >> keyframe.eye.x >> keyframe.eye.y >> keyframe.eye.z >> keyframe.target.x >> keyframe.target.y >> keyframe.target.z)) {
+			throw std::runtime_error("RUNTIME ERROR: Malformed keyframe on line " + std::to_string(lineNumber) + " of camera path file '" + filePath + "'!");
+		}
+		path.keyframes.push_back(keyframe);
+	}
+	if (path.keyframes.empty()) {
+		throw std::runtime_error("RUNTIME ERROR: Camera path file '" + filePath + "' has no keyframes!");
+	}
+
+	std::stable_sort(path.keyframes.begin(), path.keyframes.end(), [](const CameraKeyframe& a, const CameraKeyframe& b) { return a.time < b.time; });
+	return path;
+}
+
+/// @brief Returns the interpolated camera at the given time (wrapped around the duration of the path).
+void CameraPath::sample(float time, glm::vec3& outEye, glm::vec3& outTarget) const {
+	if (keyframes.empty()) {
+		return;
+	}
+	float duration = getDuration();
+	if (keyframes.size() == 1 || duration <= 0.0f) {
+		outEye = keyframes.front().eye;
+		outTarget = keyframes.front().target;
+		return;
+	}
+	float pathTime = std::fmod(std::max(time, 0.0f), duration);
+
+	// First keyframe after 'pathTime' (there always is one, since pathTime < duration)
+	auto next = std::upper_bound(keyframes.begin(), keyframes.end(), pathTime, [](float t, const CameraKeyframe& keyframe) { return t < keyframe.time; });
+	if (next == keyframes.begin()) {
+		outEye = next->eye;
+		outTarget = next->target;
+		return;
+	}
+	auto previous = next - 1;
+	float span = next->time - previous->time;
+	float blend = span > 0.0f ? (pathTime - previous->time) / span : 0.0f;
+	outEye = glm::mix(previous->eye, next->eye, blend);
+	outTarget = glm::mix(previous->target, next->target, blend);
+}
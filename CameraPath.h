@@ -0,0 +1,33 @@
+#pragma once
+
+// (same GLM configuration as Application.h: it must match in every translation unit that uses GLM types)
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#define GLM_FORCE_DEFAULT_ALIGNED_GENTYPES
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+
+/// @brief A camera position & look-at target at a point in time of a scripted camera path.
+struct CameraKeyframe {
+	float time{ 0.0f };  // seconds since the start of the path
+	glm::vec3 eye{ 0.0f };
+	glm::vec3 target{ 0.0f };
+};
+
+/// @brief Scripted camera path: keyframes linearly interpolated over time, looping once the last keyframe is reached.
+/// @brief Positions are in units of the scene's bounding radius, so one path fits both a single model and a large grid of them.
+/// @brief File format: one keyframe per line as "time eyeX eyeY eyeZ targetX targetY targetZ" ('#' starts a comment).
+class CameraPath {
+public:
+	static CameraPath loadFromFile(const std::string& filePath);
+
+	bool isEmpty() const { return keyframes.empty(); }
+	size_t getKeyframeCount() const { return keyframes.size(); }
+	float getDuration() const { return keyframes.empty() ? 0.0f : keyframes.back().time; }
+
+	void sample(float time, glm::vec3& outEye, glm::vec3& outTarget) const;
+
+private:
+	std::vector<CameraKeyframe> keyframes;  // sorted by time
+};
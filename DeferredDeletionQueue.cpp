@@ -0,0 +1,29 @@
+
+#include "DeferredDeletionQueue.h"
+#include <algorithm>
+
+
+void DeferredDeletionQueue::enqueue(uint64_t timelineValue, std::function<void()> deleter) {
+	// Frames are submitted in order, so keeping the queue sorted only needs the value to not go backwards
+	if (!pending.empty()) {
+		timelineValue = std::max(timelineValue, pending.back().timelineValue);
+	}
+	pending.push_back(PendingDeletion{ timelineValue, std::move(deleter) });
+	maxPendingCount = std::max(maxPendingCount, pending.size());
+}
+
+uint32_t DeferredDeletionQueue::flush(uint64_t completedTimelineValue) {
+	uint32_t deletedCount{ 0 };
+	while (!pending.empty() && pending.front().timelineValue <= completedTimelineValue) {
+		// Pop before running, so a deleter can safely enqueue further deletions
+		std::function<void()> deleter = std::move(pending.front().deleter);
+		pending.pop_front();
+		deleter();
+		deletedCount++;
+	}
+	return deletedCount;
+}
+
+uint32_t DeferredDeletionQueue::flushAll() {
+	return flush(UINT64_MAX);
+}
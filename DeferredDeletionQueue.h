@@ -0,0 +1,37 @@
+#pragma once
+
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+
+/// @brief Destroys GPU resources once the GPU is done with them, instead of waiting for the whole device to go idle.
+/// @brief Every deletion is keyed on the frame timeline value of the last submission that may still use the resource,
+/// @brief and runs once the frame timeline semaphore has reached that value. Used from the render loop thread only.
+class DeferredDeletionQueue {
+public:
+	DeferredDeletionQueue() = default;
+	~DeferredDeletionQueue() = default;
+
+	DeferredDeletionQueue(const DeferredDeletionQueue&) = delete;
+	DeferredDeletionQueue& operator=(const DeferredDeletionQueue&) = delete;
+
+	/// @brief Queues 'deleter' to run once the frame timeline semaphore reaches 'timelineValue'.
+	void enqueue(uint64_t timelineValue, std::function<void()> deleter);
+	/// @brief Runs (in queue order) every deletion whose timeline value has been reached. Returns how many ran.
+	uint32_t flush(uint64_t completedTimelineValue);
+	/// @brief Runs every pending deletion. The caller must make sure the GPU is idle.
+	uint32_t flushAll();
+
+	size_t getPendingCount() const { return pending.size(); }
+	size_t getMaxPendingCount() const { return maxPendingCount; }
+
+private:
+	struct PendingDeletion {
+		uint64_t timelineValue{ 0 };
+		std::function<void()> deleter;
+	};
+
+	std::deque<PendingDeletion> pending;  // timeline values never decrease from front to back
+	size_t maxPendingCount{ 0 };
+};
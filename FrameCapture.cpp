@@ -0,0 +1,150 @@
+
+#include "FrameCapture.h"
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+#include <fstream>
+#include <chrono>
+
+
+FrameCapture::~FrameCapture() {
+	stop();
+}
+
+void FrameCapture::start(const std::string& outputDirectory, uint32_t width, uint32_t height, bool bgraPixels, const std::vector<const void*>& slotPixels) {
+	this->outputDirectory = outputDirectory;
+	this->width = width;
+	this->height = height;
+	this->bgraPixels = bgraPixels;
+	std::filesystem::create_directories(outputDirectory);
+
+	slots = std::vector<Slot>(slotPixels.size());
+	for (size_t i{ 0 }; i < slotPixels.size(); i++) {
+		slots.at(i).pixels = static_cast<const uint8_t*>(slotPixels.at(i));
+	}
+	nextSlot = 0;
+	stopping = false;
+	worker = std::thread(&FrameCapture::workerLoop, this);
+}
+
+void FrameCapture::stop() {
+	if (!worker.joinable()) {
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	queueChanged.notify_all();
+	worker.join();
+}
+
+/// @brief Returns the next slot of the ring if it's free. Otherwise the frame is counted as dropped (never waits).
+std::optional<uint32_t> FrameCapture::acquireSlot() {
+	if (slots.empty()) {
+		return std::nullopt;
+	}
+	uint32_t slot = nextSlot;
+	if (slots.at(slot).state.load(std::memory_order_acquire) != SlotState::Free) {
+		droppedCount++;
+		return std::nullopt;
+	}
+	nextSlot = (nextSlot + 1) % static_cast<uint32_t>(slots.size());
+	return slot;
+}
+
+/// @brief The copy into the slot was submitted, and is done once the frame timeline semaphore reaches 'timelineValue'.
+void FrameCapture::markSubmitted(uint32_t slot, uint64_t frameNumber, uint64_t timelineValue) {
+	Slot& captureSlot = slots.at(slot);
+	captureSlot.frameNumber = frameNumber;
+	captureSlot.timelineValue = timelineValue;
+	captureSlot.state.store(SlotState::Submitted, std::memory_order_release);
+}
+
+/// @brief Returns the submitted slots whose copy the GPU has finished. They must then be handed to 'encodeAsync'
+/// @brief (after invalidating their mapped memory if it isn't host coherent).
+std::vector<uint32_t> FrameCapture::collectCompleted(uint64_t completedTimelineValue) {
+	std::vector<uint32_t> completedSlots{};
+	for (uint32_t i{ 0 }; i < static_cast<uint32_t>(slots.size()); i++) {
+		Slot& captureSlot = slots.at(i);
+		if (captureSlot.state.load(std::memory_order_acquire) == SlotState::Submitted && captureSlot.timelineValue <= completedTimelineValue) {
+			captureSlot.state.store(SlotState::Encoding, std::memory_order_release);
+			completedSlots.push_back(i);
+		}
+	}
+	return completedSlots;
+}
+
+void FrameCapture::encodeAsync(uint32_t slot) {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		encodeQueue.push_back(slot);
+	}
+	queueChanged.notify_one();
+}
+
+/// @brief Writes the capture counters and the throughput (captured frames per second) over the given run time.
+void FrameCapture::logReport(std::ostream& out, double elapsedSeconds) const {
+	uint64_t captured = capturedCount.load();
+	out << std::fixed << std::setprecision(2)
+		<< "> Frame capture (" << width << "x" << height << ", " << slots.size() << " readback slots, '" << outputDirectory << "'): "
+		<< captured << " captured, " << droppedCount.load() << " dropped (ring full), " << failedCount.load() << " failed, "
+		<< (elapsedSeconds > 0.0 ? captured / elapsedSeconds : 0.0) << " captured frames/s, "
+		<< (captured > 0 ? encodeTimeMicroseconds.load() / 1000.0 / captured : 0.0) << " ms encode/frame\n"
+		<< std::defaultfloat;
+}
+
+/// @brief Writes 8 bit RGBA or BGRA pixels (tightly packed, top row first) as a binary PPM (P6) file.
+bool FrameCapture::writePpm(const std::string& filePath, uint32_t width, uint32_t height, bool bgraPixels, const uint8_t* pixels) {
+	std::ofstream file(filePath, std::ios::binary);
+	if (!file.is_open()) {
+		return false;
+	}
+	file << "P6\n" << width << " " << height << "\n255\n";
+
+	// Convert a row at a time (drops the alpha channel & swizzles BGR to RGB)
+	std::vector<char> row(static_cast<size_t>(width) * 3);
+	size_t redOffset = bgraPixels ? 2 : 0;
+	size_t blueOffset = bgraPixels ? 0 : 2;
+	for (uint32_t y{ 0 }; y < height; y++) {
+		const uint8_t* sourceRow = pixels + static_cast<size_t>(y) * width * 4;
+		for (uint32_t x{ 0 }; x < width; x++) {
+			row[x * 3 + 0] = static_cast<char>(sourceRow[x * 4 + redOffset]);
+			row[x * 3 + 1] = static_cast<char>(sourceRow[x * 4 + 1]);
+			row[x * 3 + 2] = static_cast<char>(sourceRow[x * 4 + blueOffset]);
+		}
+		file.write(row.data(), static_cast<std::streamsize>(row.size()));
+	}
+	return file.good();
+}
+
+void FrameCapture::workerLoop() {
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true) {
+		queueChanged.wait(lock, [this]() { return stopping || !encodeQueue.empty(); });
+		// Drain the queue before stopping, so every completed copy gets written
+		if (encodeQueue.empty()) {
+			return;
+		}
+		uint32_t slot = encodeQueue.front();
+		encodeQueue.pop_front();
+		lock.unlock();
+
+		Slot& captureSlot = slots.at(slot);
+		std::ostringstream fileName;
+		fileName << "frame_" << std::setw(6) << std::setfill('0') << captureSlot.frameNumber << ".ppm";
+		std::string filePath = (std::filesystem::path(outputDirectory) / fileName.str()).string();
+
+		auto encodeStartTime = std::chrono::steady_clock::now();
+		if (writePpm(filePath, width, height, bgraPixels, captureSlot.pixels)) {
+			capturedCount++;
+		}
+		else {
+			failedCount++;
+		}
+		encodeTimeMicroseconds += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - encodeStartTime).count());
+		captureSlot.state.store(SlotState::Free, std::memory_order_release);
+
+		lock.lock();
+	}
+}
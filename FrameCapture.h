@@ -0,0 +1,77 @@
+#pragma once
+
+#include <condition_variable>
+#include <optional>
+#include <ostream>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <deque>
+#include <mutex>
+
+/// @brief CPU side of the frame readback ring: tracks whether every readback slot is free, waiting on the GPU or being encoded,
+/// @brief and encodes the completed slots to PPM files on a dedicated worker thread, so the render loop never blocks on readback.
+/// @brief A frame whose ring slot isn't free yet is dropped (not captured) instead of waiting for it.
+class FrameCapture {
+public:
+	static constexpr uint32_t DEFAULT_RING_SIZE{ 4 };
+
+	FrameCapture() = default;
+	~FrameCapture();
+
+	FrameCapture(const FrameCapture&) = delete;
+	FrameCapture& operator=(const FrameCapture&) = delete;
+
+	/// @brief Starts the encoder thread. 'slotPixels' are the persistently mapped readback buffers (tightly packed 4 bytes per pixel).
+	void start(const std::string& outputDirectory, uint32_t width, uint32_t height, bool bgraPixels, const std::vector<const void*>& slotPixels);
+	/// @brief Waits for the queued encodes to finish and stops the encoder thread.
+	void stop();
+	bool isRunning() const { return worker.joinable(); }
+
+	// Render loop side (single thread)
+	std::optional<uint32_t> acquireSlot();
+	void markSubmitted(uint32_t slot, uint64_t frameNumber, uint64_t timelineValue);
+	std::vector<uint32_t> collectCompleted(uint64_t completedTimelineValue);
+	void encodeAsync(uint32_t slot);
+
+	uint64_t getCapturedCount() const { return capturedCount.load(); }
+	uint64_t getDroppedCount() const { return droppedCount.load(); }
+	void logReport(std::ostream& out, double elapsedSeconds) const;
+
+	static bool writePpm(const std::string& filePath, uint32_t width, uint32_t height, bool bgraPixels, const uint8_t* pixels);
+
+private:
+	enum class SlotState : uint32_t {
+		Free = 0,   // can be copied into
+		Submitted,  // the GPU copy into it is pending
+		Encoding    // queued for (or being written by) the encoder thread
+	};
+	struct Slot {
+		const uint8_t* pixels{ nullptr };
+		std::atomic<SlotState> state{ SlotState::Free };
+		uint64_t frameNumber{ 0 };
+		uint64_t timelineValue{ 0 };
+	};
+
+	void workerLoop();
+
+	std::string outputDirectory;
+	uint32_t width{ 0 };
+	uint32_t height{ 0 };
+	bool bgraPixels{ true };
+	std::vector<Slot> slots;
+	uint32_t nextSlot{ 0 };
+
+	std::thread worker;
+	std::mutex mutex;
+	std::condition_variable queueChanged;
+	std::deque<uint32_t> encodeQueue;
+	bool stopping{ false };
+
+	std::atomic<uint64_t> capturedCount{ 0 };
+	std::atomic<uint64_t> droppedCount{ 0 };
+	std::atomic<uint64_t> failedCount{ 0 };
+	std::atomic<uint64_t> encodeTimeMicroseconds{ 0 };
+};
@@ -0,0 +1,160 @@
+
+#include "FrameStats.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <cmath>
+#include <sstream>
+
+
+// One extra slot: the one 'record' is writing is never handed out by 'snapshot'
+FrameStats::FrameStats(size_t capacity) : ring(std::max<size_t>(capacity, 1) + 1) {
+}
+
+/// @brief Stores a frame's timings, overwriting the oldest one once the ring is full.
+void FrameStats::record(const FrameSample& sample) {
+	uint64_t index = writeCount.load(std::memory_order_relaxed);
+	ring[index % ring.size()] = sample;
+	// Publishes the sample to 'snapshot' callers
+	writeCount.store(index + 1, std::memory_order_release);
+}
+
+/// @brief Copies the samples currently held in the ring (oldest first).
+std::vector<FrameSample> FrameStats::snapshot() const {
+	// Once the ring is full, the slot of the sample being recorded (endIndex) is also the slot of the oldest one: skip it
+	const uint64_t readableCount = ring.size() - 1;
+	uint64_t endIndex = writeCount.load(std::memory_order_acquire);
+	uint64_t beginIndex = endIndex > readableCount ? endIndex - readableCount : 0;
+
+	std::vector<FrameSample> samples;
+	samples.reserve(static_cast<size_t>(endIndex - beginIndex));
+	for (uint64_t index{ beginIndex }; index < endIndex; index++) {
+		samples.push_back(ring[index % ring.size()]);
+	}
+
+	// Anything the recording thread may have overwritten, or may be overwriting, while we were copying is dropped (oldest samples first)
+	uint64_t endIndexAfterCopy = writeCount.load(std::memory_order_acquire);
+	uint64_t firstValidIndex = endIndexAfterCopy > readableCount ? endIndexAfterCopy - readableCount : 0;
+	if (firstValidIndex > beginIndex) {
+		size_t overwrittenCount = static_cast<size_t>(std::min<uint64_t>(firstValidIndex - beginIndex, samples.size()));
+		samples.erase(samples.begin(), samples.begin() + overwrittenCount);
+	}
+	return samples;
+}
+
+FrameMetricSummary FrameStats::summarize(const std::vector<FrameSample>& samples, FrameMetric metric) {
+	FrameMetricSummary summary{};
+	if (samples.empty()) {
+		return summary;
+	}
+
+	std::vector<double> values;
+	values.reserve(samples.size());
+	double sum{ 0.0 };
+	for (const FrameSample& sample : samples) {
+		values.push_back(sample[metric]);
+		sum += sample[metric];
+	}
+	std::sort(values.begin(), values.end());
+
+	// Nearest-rank percentiles
+	auto percentile = [&values](double fraction) {
+		size_t rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(values.size())));
+		return values.at(std::clamp<size_t>(rank, 1, values.size()) - 1);
+	};
+	summary.mean = sum / static_cast<double>(values.size());
+	summary.p50 = percentile(0.50);
+	summary.p95 = percentile(0.95);
+	summary.p99 = percentile(0.99);
+	summary.max = values.back();
+	return summary;
+}
+
+/// @brief Counts the samples falling in each bucket of HISTOGRAM_BUCKET_LIMITS_MS (plus one overflow bucket).
+std::vector<uint64_t> FrameStats::histogram(const std::vector<FrameSample>& samples, FrameMetric metric) {
+	std::vector<uint64_t> bucketCounts(HISTOGRAM_BUCKET_LIMITS_MS.size() + 1, 0);
+	for (const FrameSample& sample : samples) {
+		auto bucket = std::upper_bound(HISTOGRAM_BUCKET_LIMITS_MS.begin(), HISTOGRAM_BUCKET_LIMITS_MS.end(), sample[metric]);
+		bucketCounts.at(static_cast<size_t>(bucket - HISTOGRAM_BUCKET_LIMITS_MS.begin()))++;
+	}
+	return bucketCounts;
+}
+
+/// @brief Writes the rolling percentiles of every metric and the CPU frame time histogram.
+void FrameStats::logReport(std::ostream& out) const {
+	std::vector<FrameSample> samples = snapshot();
+	if (samples.empty()) {
+		return;
+	}
+
+	out << "\n> Frame statistics (last " << samples.size() << " frames, ms except the resolution scale):\n";
+	out << std::fixed << std::setprecision(3);
+	out << "\t" << std::left << std::setw(14) << "metric" << std::right
+		<< std::setw(10) << "mean" << std::setw(10) << "p50" << std::setw(10) << "p95" << std::setw(10) << "p99" << std::setw(10) << "max" << "\n";
+	for (uint32_t i{ 0 }; i < static_cast<uint32_t>(FrameMetric::Count); i++) {
+		FrameMetric metric = static_cast<FrameMetric>(i);
+		FrameMetricSummary summary = summarize(samples, metric);
+		out << "\t" << std::left << std::setw(14) << getMetricName(metric) << std::right
+			<< std::setw(10) << summary.mean << std::setw(10) << summary.p50 << std::setw(10) << summary.p95
+			<< std::setw(10) << summary.p99 << std::setw(10) << summary.max << "\n";
+	}
+
+	// Histogram of the CPU frame time, where stutters show up as a tail in the upper buckets
+	constexpr size_t HISTOGRAM_BAR_WIDTH{ 40 };
+	std::vector<uint64_t> bucketCounts = histogram(samples, FrameMetric::CpuFrame);
+	out << "\tCPU frame time histogram:\n";
+	for (size_t bucket{ 0 }; bucket < bucketCounts.size(); bucket++) {
+		double lowerLimit = bucket == 0 ? 0.0 : HISTOGRAM_BUCKET_LIMITS_MS.at(bucket - 1);
+		std::ostringstream label;
+		label << std::fixed << std::setprecision(1);
+		if (bucket < HISTOGRAM_BUCKET_LIMITS_MS.size()) {
+			label << lowerLimit << " - " << HISTOGRAM_BUCKET_LIMITS_MS.at(bucket);
+		}
+		else {
+			label << ">= " << lowerLimit;
+		}
+		double fraction = static_cast<double>(bucketCounts.at(bucket)) / static_cast<double>(samples.size());
+		out << "\t\t" << std::left << std::setw(16) << label.str() << std::right << std::setw(8) << bucketCounts.at(bucket)
+			<< " " << std::string(static_cast<size_t>(fraction * HISTOGRAM_BAR_WIDTH + 0.5), '#') << "\n";
+	}
+	out << std::defaultfloat;
+}
+
+/// @brief Writes every frame held in the ring as CSV (one row per frame, one column per metric).
+bool FrameStats::writeCsv(const std::string& filePath) const {
+	std::ofstream file(filePath, std::ios::trunc);
+	if (!file.is_open()) {
+		return false;
+	}
+
+	file << "frame";
+	for (uint32_t i{ 0 }; i < static_cast<uint32_t>(FrameMetric::Count); i++) {
+		FrameMetric metric = static_cast<FrameMetric>(i);
+		file << "," << getMetricName(metric) << (metric == FrameMetric::ResolutionScale ? "" : "_ms");
+	}
+	file << "\n" << std::fixed << std::setprecision(4);
+	for (const FrameSample& sample : snapshot()) {
+		file << sample.frameNumber;
+		for (double value : sample.values) {
+			file << "," << value;
+		}
+		file << "\n";
+	}
+	return file.good();
+}
+
+const char* FrameStats::getMetricName(FrameMetric metric) {
+	switch (metric) {
+	case FrameMetric::CpuFrame:     return "cpu_frame";
+	case FrameMetric::FrameWait:    return "frame_wait";
+	case FrameMetric::AcquireWait:  return "acquire_wait";
+	case FrameMetric::Record:       return "record";
+	case FrameMetric::Present:      return "present";
+	case FrameMetric::CpuWork:      return "cpu_work";
+	case FrameMetric::GpuFrame:     return "gpu_frame";
+	case FrameMetric::GpuRenderPass: return "gpu_render_pass";
+	case FrameMetric::InputLatency: return "input_latency";
+	case FrameMetric::ResolutionScale: return "resolution_scale";
+	default:                        return "unknown";
+	}
+}
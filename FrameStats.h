@@ -0,0 +1,71 @@
+#pragma once
+
+#include <ostream>
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <array>
+
+/// @brief The timings recorded for every frame (in milliseconds, except the resolution scale).
+enum class FrameMetric : uint32_t {
+	CpuFrame = 0,   // whole 'drawFrame' call
+	FrameWait,      // blocked waiting for the frame slot to be free (timeline semaphore)
+	AcquireWait,    // inside vkAcquireNextImageKHR
+	Record,         // recording (or fetching the cached) command buffer
+	Present,        // inside vkQueuePresentKHR
+	CpuWork,        // building & submitting the frame (CpuFrame minus the waits & present)
+	GpuFrame,       // GPU time of the most recently completed frame (timestamps)
+	GpuRenderPass,  // GPU time of the render pass of the most recently completed frame
+	InputLatency,   // input poll to GPU completion of the most recently completed frame
+	ResolutionScale,  // scale the scene was rendered at (a fraction of the swapchain extent, not a time)
+	Count
+};
+
+/// @brief One frame's worth of timings.
+struct FrameSample {
+	uint64_t frameNumber{ 0 };
+	std::array<double, static_cast<size_t>(FrameMetric::Count)> values{};
+
+	double& operator[](FrameMetric metric) { return values.at(static_cast<size_t>(metric)); }
+	double operator[](FrameMetric metric) const { return values.at(static_cast<size_t>(metric)); }
+};
+
+/// @brief Rolling percentiles of one metric over the frames currently held in the ring.
+struct FrameMetricSummary {
+	double mean{ 0.0 };
+	double p50{ 0.0 };
+	double p95{ 0.0 };
+	double p99{ 0.0 };
+	double max{ 0.0 };
+};
+
+/// @brief Records per-frame timings into a fixed size ring (no locks or allocations when recording),
+/// @brief and reports rolling percentiles, a frame time histogram and CSV dumps of the frames in the ring.
+/// @brief There must be a single recording thread. Other threads can take snapshots: samples overwritten
+/// @brief while being copied are detected and dropped.
+class FrameStats {
+public:
+	static constexpr size_t DEFAULT_CAPACITY{ 16384 };
+	/// @brief Upper bounds (ms) of the CPU frame time histogram buckets (the last bucket is everything above).
+	static constexpr std::array<double, 9> HISTOGRAM_BUCKET_LIMITS_MS{ 4.0, 8.0, 12.0, 16.7, 20.0, 33.3, 50.0, 100.0, 250.0 };
+
+	explicit FrameStats(size_t capacity = DEFAULT_CAPACITY);
+
+	void record(const FrameSample& sample);
+
+	std::vector<FrameSample> snapshot() const;
+	uint64_t getRecordedCount() const { return writeCount.load(std::memory_order_acquire); }
+
+	static FrameMetricSummary summarize(const std::vector<FrameSample>& samples, FrameMetric metric);
+	static std::vector<uint64_t> histogram(const std::vector<FrameSample>& samples, FrameMetric metric);
+
+	void logReport(std::ostream& out) const;
+	bool writeCsv(const std::string& filePath) const;
+
+	static const char* getMetricName(FrameMetric metric);
+
+private:
+	std::vector<FrameSample> ring;
+	std::atomic<uint64_t> writeCount{ 0 };
+};
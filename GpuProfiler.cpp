@@ -0,0 +1,340 @@
+
+#include "GpuProfiler.h"
+#include <stdexcept>
+#include <algorithm>
+#include <iomanip>
+#include <chrono>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+
+void GpuProfiler::initialize(VkDevice device, VkPhysicalDevice physicalDevice, uint32_t queueFamilyIndex, uint32_t frameCount, bool pipelineStatisticsEnabled) {
+	this->device = device;
+	this->pipelineStatisticsEnabled = pipelineStatisticsEnabled;
+
+	VkPhysicalDeviceProperties physicalDeviceProperties{};
+	vkGetPhysicalDeviceProperties(physicalDevice, &physicalDeviceProperties);
+	timestampPeriod = static_cast<double>(physicalDeviceProperties.limits.timestampPeriod);
+
+	// Timestamps are supported on a queue if it has valid timestamp bits
+	uint32_t queueFamilyCount{ 0 };
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+	std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
+	uint32_t timestampValidBits = queueFamilies.at(queueFamilyIndex).timestampValidBits;
+	timestampSupported = timestampValidBits > 0;
+	timestampMask = timestampValidBits >= 64 ? ~0ull : ((1ull << timestampValidBits) - 1);
+	timestampQueryCount = 2 + 2 * MAX_SCOPES;
+
+	submitted.assign(frameCount, false);
+	submittedFrameNumbers.assign(frameCount, 0);
+	submittedTimesNs.assign(frameCount, 0);
+	accumulatedScopeTimesMs.assign(MAX_SCOPES, 0.0);
+	accumulatedScopeSamples.assign(MAX_SCOPES, 0);
+
+	if (timestampSupported) {
+		VkQueryPoolCreateInfo queryPoolCreateInfo{};
+		queryPoolCreateInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+		queryPoolCreateInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+		queryPoolCreateInfo.queryCount = timestampQueryCount;
+
+		timestampQueryPools.resize(frameCount);
+		for (uint32_t i{ 0 }; i < frameCount; i++) {
+			if (vkCreateQueryPool(device, &queryPoolCreateInfo, nullptr, &timestampQueryPools.at(i)) != VK_SUCCESS) {
+				throw std::runtime_error("RUNTIME ERROR: Failed to create the timestamp query pool!");
+			}
+		}
+	}
+
+	if (pipelineStatisticsEnabled) {
+		VkQueryPoolCreateInfo queryPoolCreateInfo{};
+		queryPoolCreateInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+		queryPoolCreateInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+		queryPoolCreateInfo.queryCount = 1;
+		queryPoolCreateInfo.pipelineStatistics = PIPELINE_STATISTIC_FLAGS;
+
+		statisticsQueryPools.resize(frameCount);
+		for (uint32_t i{ 0 }; i < frameCount; i++) {
+			if (vkCreateQueryPool(device, &queryPoolCreateInfo, nullptr, &statisticsQueryPools.at(i)) != VK_SUCCESS) {
+				throw std::runtime_error("RUNTIME ERROR: Failed to create the pipeline statistics query pool!");
+			}
+		}
+	}
+}
+
+bool GpuProfiler::enableCalibratedTimestamps(VkInstance instance, VkPhysicalDevice physicalDevice) {
+	if (!timestampSupported) {
+		return false;
+	}
+	// The host domain 'steady_clock' runs on: QueryPerformanceCounter on Windows, CLOCK_MONOTONIC elsewhere
+#ifdef _WIN32
+	hostTimeDomain = VK_TIME_DOMAIN_QUERY_PERFORMANCE_COUNTER_EXT;
+#else
+	hostTimeDomain = VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT;
+#endif
+	auto getTimeDomains = reinterpret_cast<PFN_vkGetPhysicalDeviceCalibrateableTimeDomainsEXT>(
+		vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceCalibrateableTimeDomainsEXT"));
+	getCalibratedTimestamps = reinterpret_cast<PFN_vkGetCalibratedTimestampsEXT>(vkGetDeviceProcAddr(device, "vkGetCalibratedTimestampsEXT"));
+	if (!getTimeDomains || !getCalibratedTimestamps) {
+		return false;
+	}
+	uint32_t timeDomainCount{ 0 };
+	getTimeDomains(physicalDevice, &timeDomainCount, nullptr);
+	std::vector<VkTimeDomainEXT> timeDomains(timeDomainCount);
+	getTimeDomains(physicalDevice, &timeDomainCount, timeDomains.data());
+	bool deviceDomainSupported = std::find(timeDomains.begin(), timeDomains.end(), VK_TIME_DOMAIN_DEVICE_EXT) != timeDomains.end();
+	bool hostDomainSupported = std::find(timeDomains.begin(), timeDomains.end(), hostTimeDomain) != timeDomains.end();
+	if (!deviceDomainSupported || !hostDomainSupported) {
+		return false;
+	}
+
+	calibratedTimestampsEnabled = true;
+	calibrate();
+	return calibratedTimestampsEnabled;
+}
+
+/// @brief Samples the GPU clock and the host clock together, as the reference point of 'ticksToNs'.
+void GpuProfiler::calibrate() {
+	std::array<VkCalibratedTimestampInfoEXT, 2> timestampInfos{};
+	timestampInfos.at(0).sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT;
+	timestampInfos.at(0).timeDomain = VK_TIME_DOMAIN_DEVICE_EXT;
+	timestampInfos.at(1).sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT;
+	timestampInfos.at(1).timeDomain = hostTimeDomain;
+	std::array<uint64_t, 2> timestamps{};
+	uint64_t maxDeviation{ 0 };
+	if (getCalibratedTimestamps(device, static_cast<uint32_t>(timestampInfos.size()), timestampInfos.data(), timestamps.data(), &maxDeviation) != VK_SUCCESS) {
+		calibratedTimestampsEnabled = false;
+		return;
+	}
+	calibrationTicks = timestamps.at(0);
+#ifdef _WIN32
+	// Performance counter ticks to nanoseconds, the way 'steady_clock' converts them
+	LARGE_INTEGER frequency{};
+	QueryPerformanceFrequency(&frequency);
+	uint64_t counter = timestamps.at(1);
+	uint64_t ticksPerSecond = static_cast<uint64_t>(frequency.QuadPart);
+	calibrationNs = static_cast<int64_t>((counter / ticksPerSecond) * 1000000000ull + (counter % ticksPerSecond) * 1000000000ull / ticksPerSecond);
+#else
+	calibrationNs = static_cast<int64_t>(timestamps.at(1));
+#endif
+	collectionsSinceCalibration = 0;
+}
+
+void GpuProfiler::destroy() {
+	for (VkQueryPool queryPool : timestampQueryPools) {
+		vkDestroyQueryPool(device, queryPool, nullptr);
+	}
+	for (VkQueryPool queryPool : statisticsQueryPools) {
+		vkDestroyQueryPool(device, queryPool, nullptr);
+	}
+	timestampQueryPools.clear();
+	statisticsQueryPools.clear();
+}
+
+/// @brief Resets the frame slot's queries and writes the frame's start timestamp. Must be recorded outside of a render pass.
+void GpuProfiler::beginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex) {
+	if (timestampSupported) {
+		vkCmdResetQueryPool(commandBuffer, timestampQueryPools.at(frameIndex), 0, timestampQueryCount);
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, timestampQueryPools.at(frameIndex), 0);
+	}
+	if (pipelineStatisticsEnabled) {
+		vkCmdResetQueryPool(commandBuffer, statisticsQueryPools.at(frameIndex), 0, 1);
+	}
+}
+
+void GpuProfiler::endFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex) {
+	if (timestampSupported) {
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, timestampQueryPools.at(frameIndex), 1);
+	}
+}
+
+/// @brief Writes the start timestamp of a named scope (registered the first time it's used).
+void GpuProfiler::beginScope(VkCommandBuffer commandBuffer, uint32_t frameIndex, const std::string& name) {
+	if (timestampSupported) {
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, timestampQueryPools.at(frameIndex), 2 + 2 * getScopeIndex(name));
+	}
+}
+
+void GpuProfiler::endScope(VkCommandBuffer commandBuffer, uint32_t frameIndex, const std::string& name) {
+	if (timestampSupported) {
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, timestampQueryPools.at(frameIndex), 3 + 2 * getScopeIndex(name));
+	}
+}
+
+/// @brief Starts the pipeline statistics query. If begun outside of a render pass, it must also end outside of it.
+void GpuProfiler::beginPipelineStatistics(VkCommandBuffer commandBuffer, uint32_t frameIndex) {
+	if (pipelineStatisticsEnabled) {
+		vkCmdBeginQuery(commandBuffer, statisticsQueryPools.at(frameIndex), 0, 0);
+	}
+}
+
+void GpuProfiler::endPipelineStatistics(VkCommandBuffer commandBuffer, uint32_t frameIndex) {
+	if (pipelineStatisticsEnabled) {
+		vkCmdEndQuery(commandBuffer, statisticsQueryPools.at(frameIndex), 0);
+	}
+}
+
+/// @brief Marks the frame slot's queries as submitted, so the next 'collect' of that slot reads them.
+void GpuProfiler::markSubmitted(uint32_t frameIndex, uint64_t frameNumber) {
+	submitted.at(frameIndex) = true;
+	submittedFrameNumbers.at(frameIndex) = frameNumber;
+	submittedTimesNs.at(frameIndex) = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// @brief Reads back the results of the frame slot's last submission, which must have finished on the GPU.
+/// @brief Never waits: queries that weren't written (eg: a scope skipped in that frame) are simply left out.
+/// @return True if new results were read.
+bool GpuProfiler::collect(uint32_t frameIndex) {
+	if (!submitted.at(frameIndex)) {
+		return false;
+	}
+	submitted.at(frameIndex) = false;
+
+	GpuFrameResult result{};
+	result.frameNumber = submittedFrameNumbers.at(frameIndex);
+	result.scopeTimesMs.assign(scopeNames.size(), -1.0);
+	result.scopeBeginNs.assign(scopeNames.size(), 0);
+	result.scopeEndNs.assign(scopeNames.size(), 0);
+
+	if (timestampSupported) {
+		// Every query is followed by its availability (non zero once written)
+		std::vector<uint64_t> timestamps(2 * static_cast<size_t>(timestampQueryCount), 0);
+		VkResult queryResult = vkGetQueryPoolResults(
+			device, timestampQueryPools.at(frameIndex), 0, timestampQueryCount,
+			timestamps.size() * sizeof(uint64_t), timestamps.data(), 2 * sizeof(uint64_t),
+			VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT
+		);
+		if (queryResult != VK_SUCCESS && queryResult != VK_NOT_READY) {
+			return false;
+		}
+		auto isAvailable = [&timestamps](uint32_t query) { return timestamps.at(2 * query + 1) != 0; };
+		auto getTimestamp = [&timestamps](uint32_t query) { return timestamps.at(2 * query); };
+
+		// Reference point of the CPU times: a calibration, else the frame's start placed at its submission
+		if (calibratedTimestampsEnabled && ++collectionsSinceCalibration >= CALIBRATION_INTERVAL_FRAMES) {
+			calibrate();
+		}
+		uint64_t referenceTicks = calibratedTimestampsEnabled ? calibrationTicks : getTimestamp(0);
+		int64_t referenceNs = calibratedTimestampsEnabled ? calibrationNs : submittedTimesNs.at(frameIndex);
+
+		if (isAvailable(0) && isAvailable(1)) {
+			result.frameTimeMs = ticksToMs(getTimestamp(0), getTimestamp(1));
+			result.frameBeginNs = ticksToNs(getTimestamp(0), referenceTicks, referenceNs);
+			result.frameEndNs = ticksToNs(getTimestamp(1), referenceTicks, referenceNs);
+			accumulatedFrameTimeMs += result.frameTimeMs;
+			accumulatedFrames++;
+		}
+		for (uint32_t i{ 0 }; i < static_cast<uint32_t>(scopeNames.size()); i++) {
+			uint32_t beginQuery = 2 + 2 * i;
+			if (isAvailable(beginQuery) && isAvailable(beginQuery + 1)) {
+				result.scopeTimesMs.at(i) = ticksToMs(getTimestamp(beginQuery), getTimestamp(beginQuery + 1));
+				result.scopeBeginNs.at(i) = ticksToNs(getTimestamp(beginQuery), referenceTicks, referenceNs);
+				result.scopeEndNs.at(i) = ticksToNs(getTimestamp(beginQuery + 1), referenceTicks, referenceNs);
+				accumulatedScopeTimesMs.at(i) += result.scopeTimesMs.at(i);
+				accumulatedScopeSamples.at(i)++;
+			}
+		}
+	}
+
+	if (pipelineStatisticsEnabled) {
+		std::array<uint64_t, static_cast<size_t>(GpuPipelineStatistic::Count) + 1> statistics{};
+		VkResult queryResult = vkGetQueryPoolResults(
+			device, statisticsQueryPools.at(frameIndex), 0, 1,
+			sizeof(statistics), statistics.data(), sizeof(statistics),
+			VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT
+		);
+		if ((queryResult == VK_SUCCESS || queryResult == VK_NOT_READY) && statistics.back() != 0) {
+			for (size_t i{ 0 }; i < result.statistics.size(); i++) {
+				result.statistics.at(i) = statistics.at(i);
+				accumulatedStatistics.at(i) += statistics.at(i);
+			}
+			result.statisticsValid = true;
+			accumulatedStatisticsSamples++;
+		}
+	}
+
+	lastResult = result;
+	return true;
+}
+
+/// @brief Returns the GPU time of a named scope in the last collected frame (ms), negative if not recorded.
+double GpuProfiler::getLastScopeTimeMs(const std::string& name) const {
+	for (size_t i{ 0 }; i < scopeNames.size() && i < lastResult.scopeTimesMs.size(); i++) {
+		if (scopeNames.at(i) == name) {
+			return lastResult.scopeTimesMs.at(i);
+		}
+	}
+	return -1.0;
+}
+
+/// @brief Writes the average GPU times and pipeline statistics since the last report, then starts a new averaging window.
+void GpuProfiler::logReport(std::ostream& out) {
+	if (!timestampSupported && !pipelineStatisticsEnabled) {
+		out << "> GPU profiler: no timestamp or pipeline statistics support.\n";
+		return;
+	}
+
+	out << std::fixed << std::setprecision(3);
+	out << "> GPU profiler (averages over " << accumulatedFrames << " frames):\n";
+	if (timestampSupported && accumulatedFrames > 0) {
+		out << "\t" << std::left << std::setw(28) << "frame" << std::right << accumulatedFrameTimeMs / accumulatedFrames << " ms\n";
+		for (size_t i{ 0 }; i < scopeNames.size(); i++) {
+			if (accumulatedScopeSamples.at(i) > 0) {
+				out << "\t" << std::left << std::setw(28) << scopeNames.at(i) << std::right
+					<< accumulatedScopeTimesMs.at(i) / accumulatedScopeSamples.at(i) << " ms\n";
+			}
+		}
+	}
+	out << std::defaultfloat;
+	if (pipelineStatisticsEnabled && accumulatedStatisticsSamples > 0) {
+		for (uint32_t i{ 0 }; i < static_cast<uint32_t>(GpuPipelineStatistic::Count); i++) {
+			out << "\t" << std::left << std::setw(28) << getStatisticName(static_cast<GpuPipelineStatistic>(i)) << std::right
+				<< accumulatedStatistics.at(i) / accumulatedStatisticsSamples << " /frame\n";
+		}
+	}
+
+	accumulatedFrames = 0;
+	accumulatedFrameTimeMs = 0.0;
+	accumulatedScopeTimesMs.assign(MAX_SCOPES, 0.0);
+	accumulatedScopeSamples.assign(MAX_SCOPES, 0);
+	accumulatedStatistics.fill(0);
+	accumulatedStatisticsSamples = 0;
+}
+
+const char* GpuProfiler::getStatisticName(GpuPipelineStatistic statistic) {
+	switch (statistic) {
+	case GpuPipelineStatistic::InputAssemblyVertices:     return "input assembly vertices";
+	case GpuPipelineStatistic::VertexShaderInvocations:   return "vertex shader invocations";
+	case GpuPipelineStatistic::ClippingPrimitives:        return "clipping primitives";
+	case GpuPipelineStatistic::FragmentShaderInvocations: return "fragment shader invocations";
+	default:                                              return "unknown";
+	}
+}
+
+/// @brief Returns the index of a named scope, registering it the first time.
+uint32_t GpuProfiler::getScopeIndex(const std::string& name) {
+	for (uint32_t i{ 0 }; i < static_cast<uint32_t>(scopeNames.size()); i++) {
+		if (scopeNames.at(i) == name) {
+			return i;
+		}
+	}
+	if (scopeNames.size() == MAX_SCOPES) {
+		throw std::runtime_error("RUNTIME ERROR: Too many GPU profiler scopes!");
+	}
+	scopeNames.push_back(name);
+	return static_cast<uint32_t>(scopeNames.size() - 1);
+}
+
+double GpuProfiler::ticksToMs(uint64_t begin, uint64_t end) const {
+	return static_cast<double>((end - begin) & timestampMask) * timestampPeriod / 1000000.0;
+}
+
+int64_t GpuProfiler::ticksToNs(uint64_t ticks, uint64_t referenceTicks, int64_t referenceNs) const {
+	// Signed distance to the reference, within the valid bits (the timestamp may be before it, or have wrapped around)
+	uint64_t distance = (ticks - referenceTicks) & timestampMask;
+	int64_t signedDistance = distance > (timestampMask >> 1) ? -static_cast<int64_t>((referenceTicks - ticks) & timestampMask) : static_cast<int64_t>(distance);
+	return referenceNs + static_cast<int64_t>(static_cast<double>(signedDistance) * timestampPeriod);
+}
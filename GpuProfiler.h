@@ -0,0 +1,124 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <ostream>
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <array>
+
+/// @brief The pipeline statistics collected around the render pass (in the order Vulkan writes them: by flag bit).
+enum class GpuPipelineStatistic : uint32_t {
+	InputAssemblyVertices = 0,
+	VertexShaderInvocations,
+	ClippingPrimitives,
+	FragmentShaderInvocations,
+	Count
+};
+
+/// @brief The GPU results of one frame, read back once the GPU has finished it.
+struct GpuFrameResult {
+	uint64_t frameNumber{ 0 };
+	/// @brief GPU time between the first and last command of the frame (ms).
+	double frameTimeMs{ 0.0 };
+	/// @brief GPU time of every registered scope (ms), negative if the scope wasn't recorded in that frame.
+	std::vector<double> scopeTimesMs;
+	std::array<uint64_t, static_cast<size_t>(GpuPipelineStatistic::Count)> statistics{};
+	bool statisticsValid{ false };
+	/// @brief Begin & end of the frame and of every scope on the CPU clock ('steady_clock' ns, 0 if not written), for the trace.
+	int64_t frameBeginNs{ 0 };
+	int64_t frameEndNs{ 0 };
+	std::vector<int64_t> scopeBeginNs;
+	std::vector<int64_t> scopeEndNs;
+};
+
+/// @brief Query pool based GPU profiler: timestamps around the frame and around named scopes, plus pipeline statistics.
+/// @brief Every frame slot (frame in flight) has its own query pools, which are reset from inside the command buffer
+/// @brief (so cached command buffers can be resubmitted as is). The results of a frame slot are collected once its
+/// @brief previous submission has finished, i.e. frames-in-flight frames later, and never wait on the GPU.
+class GpuProfiler {
+public:
+	static constexpr uint32_t MAX_SCOPES{ 16 };
+	/// @brief Statistics queried when the device supports 'pipelineStatisticsQuery'.
+	static constexpr VkQueryPipelineStatisticFlags PIPELINE_STATISTIC_FLAGS{
+		VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT |
+		VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+		VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+		VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT
+	};
+
+	/// @brief Collections between two calibrations of the GPU clock against the CPU clock (they slowly drift apart).
+	static constexpr uint32_t CALIBRATION_INTERVAL_FRAMES{ 60 };
+
+	void initialize(VkDevice device, VkPhysicalDevice physicalDevice, uint32_t queueFamilyIndex, uint32_t frameCount, bool pipelineStatisticsEnabled);
+	/// @brief Aligns the timestamps to the CPU clock with VK_EXT_calibrated_timestamps (which must be enabled on the device).
+	/// @brief Without it, the GPU start of a frame is placed at the frame's submission.
+	/// @return False if the device can't sample its clock together with the 'steady_clock' one.
+	bool enableCalibratedTimestamps(VkInstance instance, VkPhysicalDevice physicalDevice);
+	void destroy();
+
+	bool isTimestampSupported() const { return timestampSupported; }
+	bool isCalibrated() const { return calibratedTimestampsEnabled; }
+	bool isPipelineStatisticsEnabled() const { return pipelineStatisticsEnabled; }
+	/// @brief Flags that Secondary command buffers executed inside the pipeline statistics query must inherit.
+	VkQueryPipelineStatisticFlags getInheritedPipelineStatistics() const { return pipelineStatisticsEnabled ? PIPELINE_STATISTIC_FLAGS : 0; }
+
+	// Recording (the frame's command buffer, on the thread that records it)
+	void beginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex);
+	void endFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex);
+	void beginScope(VkCommandBuffer commandBuffer, uint32_t frameIndex, const std::string& name);
+	void endScope(VkCommandBuffer commandBuffer, uint32_t frameIndex, const std::string& name);
+	void beginPipelineStatistics(VkCommandBuffer commandBuffer, uint32_t frameIndex);
+	void endPipelineStatistics(VkCommandBuffer commandBuffer, uint32_t frameIndex);
+
+	// Readback
+	void markSubmitted(uint32_t frameIndex, uint64_t frameNumber);
+	bool collect(uint32_t frameIndex);
+	const GpuFrameResult& getLastResult() const { return lastResult; }
+	/// @brief Scope names, in the order of 'GpuFrameResult::scopeTimesMs'.
+	const std::vector<std::string>& getScopeNames() const { return scopeNames; }
+	double getLastScopeTimeMs(const std::string& name) const;
+
+	void logReport(std::ostream& out);
+
+	static const char* getStatisticName(GpuPipelineStatistic statistic);
+
+private:
+	uint32_t getScopeIndex(const std::string& name);
+	double ticksToMs(uint64_t begin, uint64_t end) const;
+	void calibrate();
+	/// @brief Timestamp to CPU time, relative to a reference point sampled on both clocks.
+	int64_t ticksToNs(uint64_t ticks, uint64_t referenceTicks, int64_t referenceNs) const;
+
+	VkDevice device = VK_NULL_HANDLE;
+	bool timestampSupported{ false };
+	bool pipelineStatisticsEnabled{ false };
+	double timestampPeriod{ 1.0 };  // nanoseconds per timestamp tick
+	uint64_t timestampMask{ ~0ull };  // only 'timestampValidBits' of every timestamp are meaningful
+	uint32_t timestampQueryCount{ 0 };  // 2 for the frame + 2 per scope
+
+	std::vector<VkQueryPool> timestampQueryPools;  // one per frame slot
+	std::vector<VkQueryPool> statisticsQueryPools;  // one per frame slot
+	std::vector<bool> submitted;
+	std::vector<uint64_t> submittedFrameNumbers;
+	std::vector<int64_t> submittedTimesNs;  // 'steady_clock', when the frame slot was submitted
+
+	// Clock alignment (VK_EXT_calibrated_timestamps)
+	bool calibratedTimestampsEnabled{ false };
+	PFN_vkGetCalibratedTimestampsEXT getCalibratedTimestamps{ nullptr };
+	VkTimeDomainEXT hostTimeDomain{ VK_TIME_DOMAIN_DEVICE_EXT };
+	uint64_t calibrationTicks{ 0 };
+	int64_t calibrationNs{ 0 };
+	uint32_t collectionsSinceCalibration{ 0 };
+	std::vector<std::string> scopeNames;
+
+	GpuFrameResult lastResult;
+
+	// Sums since the last report
+	uint32_t accumulatedFrames{ 0 };
+	double accumulatedFrameTimeMs{ 0.0 };
+	std::vector<double> accumulatedScopeTimesMs;
+	std::vector<uint32_t> accumulatedScopeSamples;
+	std::array<uint64_t, static_cast<size_t>(GpuPipelineStatistic::Count)> accumulatedStatistics{};
+	uint32_t accumulatedStatisticsSamples{ 0 };
+};
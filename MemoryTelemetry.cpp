@@ -0,0 +1,125 @@
+
+#include "MemoryTelemetry.h"
+#include <iomanip>
+
+
+void MemoryTelemetry::initialize(VkPhysicalDevice physicalDevice, bool memoryBudgetExtensionEnabled) {
+	this->physicalDevice = physicalDevice;
+	this->budgetExtensionEnabled = memoryBudgetExtensionEnabled;
+	vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+}
+
+/// @brief Records a new device memory allocation. Called right after a successful vkAllocateMemory.
+void MemoryTelemetry::trackAllocation(VkDeviceMemory memory, MemoryCategory category, VkDeviceSize size, uint32_t memoryTypeIndex) {
+	uint32_t heapIndex = memoryProperties.memoryTypes[memoryTypeIndex].heapIndex;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	allocations[memory] = AllocationRecord{ category, size, heapIndex };
+	categoryBytes.at(static_cast<size_t>(category)) += size;
+	heapBytes.at(heapIndex) += size;
+}
+
+/// @brief Forgets a device memory allocation. Called right before vkFreeMemory.
+void MemoryTelemetry::trackFree(VkDeviceMemory memory) {
+	std::lock_guard<std::mutex> lock(mutex);
+	auto record = allocations.find(memory);
+	if (record == allocations.end()) {
+		return;
+	}
+	categoryBytes.at(static_cast<size_t>(record->second.category)) -= record->second.size;
+	heapBytes.at(record->second.heapIndex) -= record->second.size;
+	allocations.erase(record);
+}
+
+/// @brief Returns the usage vs. budget of every memory heap of the physical device.
+std::vector<MemoryHeapUsage> MemoryTelemetry::queryHeapUsage() const {
+	std::vector<MemoryHeapUsage> heaps(memoryProperties.memoryHeapCount);
+
+	// The budget is a moving target (other processes use the GPU too), so it is queried fresh every time
+	VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties{};
+	budgetProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+	if (budgetExtensionEnabled) {
+		VkPhysicalDeviceMemoryProperties2 memoryProperties2{};
+		memoryProperties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+		memoryProperties2.pNext = &budgetProperties;
+		vkGetPhysicalDeviceMemoryProperties2(physicalDevice, &memoryProperties2);
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	for (uint32_t i{ 0 }; i < memoryProperties.memoryHeapCount; i++) {
+		MemoryHeapUsage& heap = heaps.at(i);
+		heap.heapIndex = i;
+		heap.heapFlags = memoryProperties.memoryHeaps[i].flags;
+		heap.heapSize = memoryProperties.memoryHeaps[i].size;
+		heap.trackedBytes = heapBytes.at(i);
+		if (budgetExtensionEnabled) {
+			heap.usage = budgetProperties.heapUsage[i];
+			heap.budget = budgetProperties.heapBudget[i];
+			heap.budgetFromExtension = true;
+		}
+		else {
+			// Without the extension the best we can do is compare our own allocations against the heap size
+			heap.usage = heap.trackedBytes;
+			heap.budget = heap.heapSize;
+		}
+	}
+	return heaps;
+}
+
+VkDeviceSize MemoryTelemetry::getCategoryBytes(MemoryCategory category) const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return categoryBytes.at(static_cast<size_t>(category));
+}
+
+VkDeviceSize MemoryTelemetry::getTotalTrackedBytes() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	VkDeviceSize total{ 0 };
+	for (VkDeviceSize bytes : categoryBytes) {
+		total += bytes;
+	}
+	return total;
+}
+
+uint32_t MemoryTelemetry::getAllocationCount() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return static_cast<uint32_t>(allocations.size());
+}
+
+/// @brief Writes a human readable report of the per-category allocations and the per-heap usage vs. budget.
+void MemoryTelemetry::logReport(std::ostream& out) const {
+	constexpr double MiB{ 1024.0 * 1024.0 };
+	std::vector<MemoryHeapUsage> heaps = queryHeapUsage();
+
+	out << "\n> GPU memory telemetry (" << getAllocationCount() << " allocations, "
+		<< (budgetExtensionEnabled ? "VK_EXT_memory_budget" : "no budget extension, tracked allocations only") << "):\n";
+	out << std::fixed << std::setprecision(2);
+	for (uint32_t i{ 0 }; i < static_cast<uint32_t>(MemoryCategory::Count); i++) {
+		MemoryCategory category = static_cast<MemoryCategory>(i);
+		out << "\t" << std::left << std::setw(12) << getCategoryName(category) << std::right
+			<< getCategoryBytes(category) / MiB << " MiB\n";
+	}
+	for (const MemoryHeapUsage& heap : heaps) {
+		double budgetFraction = heap.budget > 0 ? static_cast<double>(heap.usage) / static_cast<double>(heap.budget) : 0.0;
+		out << "\tHeap " << heap.heapIndex << ((heap.heapFlags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) ? " (DEVICE_LOCAL)" : " (HOST)")
+			<< ": app = " << heap.trackedBytes / MiB << " MiB"
+			<< ", usage = " << heap.usage / MiB << " MiB"
+			<< ", budget = " << heap.budget / MiB << " MiB"
+			<< " (" << budgetFraction * 100.0 << "%)"
+			<< ", heap size = " << heap.heapSize / MiB << " MiB\n";
+		if (budgetFraction > BUDGET_WARNING_THRESHOLD) {
+			out << "\tWARNING: Heap " << heap.heapIndex << " is close to its budget! Further allocations may spill into system memory.\n";
+		}
+	}
+	out << std::defaultfloat;
+}
+
+const char* MemoryTelemetry::getCategoryName(MemoryCategory category) {
+	switch (category) {
+	case MemoryCategory::Geometry:   return "Geometry";
+	case MemoryCategory::Texture:    return "Texture";
+	case MemoryCategory::Uniform:    return "Uniform";
+	case MemoryCategory::Attachment: return "Attachment";
+	case MemoryCategory::Staging:    return "Staging";
+	default:                         return "Unknown";
+	}
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <unordered_map>
+#include <ostream>
+#include <vector>
+#include <array>
+#include <mutex>
+
+/// @brief The categories that every device memory allocation is tagged with.
+enum class MemoryCategory : uint32_t {
+	Geometry = 0,  // vertex, index and per-instance buffers
+	Texture,       // sampled images
+	Uniform,       // uniform buffers
+	Attachment,    // depth/color render targets
+	Staging,       // short-lived host visible upload/readback buffers
+	Count
+};
+
+/// @brief Usage of a single memory heap, as seen by the application and (if available) by VK_EXT_memory_budget.
+struct MemoryHeapUsage {
+	uint32_t heapIndex{ 0 };
+	VkMemoryHeapFlags heapFlags{ 0 };
+	/// @brief Total size of the heap reported by the driver.
+	VkDeviceSize heapSize{ 0 };
+	/// @brief Bytes currently allocated on this heap through the tracked allocation paths.
+	VkDeviceSize trackedBytes{ 0 };
+	/// @brief Process-wide usage of this heap (from VK_EXT_memory_budget, else equal to trackedBytes).
+	VkDeviceSize usage{ 0 };
+	/// @brief How much this process may use of the heap before spilling (from VK_EXT_memory_budget, else the heap size).
+	VkDeviceSize budget{ 0 };
+	/// @brief True if 'usage' and 'budget' came from VK_EXT_memory_budget.
+	bool budgetFromExtension{ false };
+};
+
+/// @brief Keeps track of every VkDeviceMemory allocation made by the application (tagged by category),
+/// @brief and reports the per-heap usage against the budget the driver gives us.
+class MemoryTelemetry {
+public:
+	/// @brief Fraction of a heap budget above which the report warns about a potential spill to system memory.
+	static constexpr double BUDGET_WARNING_THRESHOLD{ 0.9 };
+
+	void initialize(VkPhysicalDevice physicalDevice, bool memoryBudgetExtensionEnabled);
+
+	void trackAllocation(VkDeviceMemory memory, MemoryCategory category, VkDeviceSize size, uint32_t memoryTypeIndex);
+	void trackFree(VkDeviceMemory memory);
+
+	std::vector<MemoryHeapUsage> queryHeapUsage() const;
+	VkDeviceSize getCategoryBytes(MemoryCategory category) const;
+	VkDeviceSize getTotalTrackedBytes() const;
+	uint32_t getAllocationCount() const;
+	bool isBudgetExtensionEnabled() const { return budgetExtensionEnabled; }
+
+	void logReport(std::ostream& out) const;
+
+	static const char* getCategoryName(MemoryCategory category);
+
+private:
+	struct AllocationRecord {
+		MemoryCategory category;
+		VkDeviceSize size;
+		uint32_t heapIndex;
+	};
+
+	VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
+	VkPhysicalDeviceMemoryProperties memoryProperties{};
+	bool budgetExtensionEnabled{ false };
+
+	// Allocations may be made from worker threads, hence the lock
+	mutable std::mutex mutex;
+	std::unordered_map<VkDeviceMemory, AllocationRecord> allocations;
+	std::array<VkDeviceSize, static_cast<size_t>(MemoryCategory::Count)> categoryBytes{};
+	std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS> heapBytes{};
+};
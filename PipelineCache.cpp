@@ -0,0 +1,163 @@
+
+#include "PipelineCache.h"
+#include "StartupProfiler.h"
+#include <filesystem>
+#include <stdexcept>
+#include <iostream>
+#include <fstream>
+#include <cstring>
+
+
+void PipelineCache::initialize(VkDevice device, VkPhysicalDevice physicalDevice, const std::string& filePath) {
+	this->device = device;
+	this->filePath = filePath;
+
+	VkPhysicalDeviceProperties physicalDeviceProperties{};
+	vkGetPhysicalDeviceProperties(physicalDevice, &physicalDeviceProperties);
+	vendorID = physicalDeviceProperties.vendorID;
+	deviceID = physicalDeviceProperties.deviceID;
+	std::memcpy(pipelineCacheUUID, physicalDeviceProperties.pipelineCacheUUID, VK_UUID_SIZE);
+
+	// Seed data (a missing or mismatching file just means a cold start)
+	std::vector<char> initialData{};
+	if (!filePath.empty()) {
+		std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+		if (file.is_open()) {
+			initialData.resize(static_cast<size_t>(file.tellg()));
+			file.seekg(0);
+			file.read(initialData.data(), static_cast<std::streamsize>(initialData.size()));
+			StartupProfiler::recordBytesRead(initialData.size());
+			std::string reason{};
+			if (!file || !isHeaderValid(initialData, reason)) {
+				std::cout << "> Ignoring pipeline cache file '" << filePath << "' (" << (file ? reason : "read error") << ").\n";
+				initialData.clear();
+			}
+		}
+	}
+
+	VkPipelineCacheCreateInfo pipelineCacheCreateInfo{};
+	pipelineCacheCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+	pipelineCacheCreateInfo.initialDataSize = initialData.size();
+	pipelineCacheCreateInfo.pInitialData = initialData.empty() ? nullptr : initialData.data();
+	if (vkCreatePipelineCache(device, &pipelineCacheCreateInfo, nullptr, &cache) != VK_SUCCESS) {
+		throw std::runtime_error("RUNTIME ERROR: Failed to create the pipeline cache!");
+	}
+	loadedSize = initialData.size();
+
+	if (isWarm()) {
+		std::cout << "> Loaded pipeline cache '" << filePath << "' (" << loadedSize / 1024 << " KiB).\n";
+	}
+	else {
+		std::cout << "> Created empty pipeline cache" << (filePath.empty() ? " (not persisted)" : "") << ".\n";
+	}
+}
+
+/// @brief Checks the 'VkPipelineCacheHeaderVersionOne' at the start of the data against this device.
+/// @brief (the driver would also reject a mismatching cache, but some only do so by crashing or silently ignoring it)
+bool PipelineCache::isHeaderValid(const std::vector<char>& data, std::string& outReason) const {
+	VkPipelineCacheHeaderVersionOne header{};
+	if (data.size() < sizeof(header)) {
+		outReason = "too small";
+		return false;
+	}
+	std::memcpy(&header, data.data(), sizeof(header));
+	if (header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE || header.headerSize < sizeof(header) || header.headerSize > data.size()) {
+		outReason = "unknown header";
+		return false;
+	}
+	if (header.vendorID != vendorID || header.deviceID != deviceID) {
+		outReason = "written for another device";
+		return false;
+	}
+	if (std::memcmp(header.pipelineCacheUUID, pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+		outReason = "written by another driver version";
+		return false;
+	}
+	return true;
+}
+
+bool PipelineCache::save() {
+	if (cache == VK_NULL_HANDLE || filePath.empty()) {
+		return false;
+	}
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!workerCaches.empty()) {
+			if (vkMergePipelineCaches(device, cache, static_cast<uint32_t>(workerCaches.size()), workerCaches.data()) != VK_SUCCESS) {
+				std::cerr << "WARNING: Failed to merge the worker pipeline caches, only saving the main one.\n";
+			}
+		}
+	}
+
+	size_t dataSize{ 0 };
+	std::vector<char> data{};
+	if (vkGetPipelineCacheData(device, cache, &dataSize, nullptr) == VK_SUCCESS) {
+		data.resize(dataSize);
+	}
+	if (data.empty() || vkGetPipelineCacheData(device, cache, &dataSize, data.data()) != VK_SUCCESS) {
+		std::cerr << "WARNING: Failed to get the pipeline cache data!\n";
+		return false;
+	}
+	data.resize(dataSize);
+
+	// Write the whole cache next to the file, then replace it in one step
+	std::string temporaryPath = filePath + ".tmp";
+	{
+		std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+		file.write(data.data(), static_cast<std::streamsize>(data.size()));
+		if (!file) {
+			std::cerr << "WARNING: Failed to write the pipeline cache to '" << temporaryPath << "'!\n";
+			return false;
+		}
+	}
+	std::error_code error{};
+	std::filesystem::rename(temporaryPath, filePath, error);
+	if (error) {
+		std::cerr << "WARNING: Failed to replace the pipeline cache '" << filePath << "': " << error.message() << "\n";
+		std::filesystem::remove(temporaryPath, error);
+		return false;
+	}
+	std::cout << "> Saved pipeline cache '" << filePath << "' (" << data.size() / 1024 << " KiB).\n";
+	return true;
+}
+
+void PipelineCache::destroy() {
+	if (device == VK_NULL_HANDLE) {
+		return;
+	}
+	std::lock_guard<std::mutex> lock(mutex);
+	for (VkPipelineCache workerCache : workerCaches) {
+		vkDestroyPipelineCache(device, workerCache, nullptr);
+	}
+	workerCaches.clear();
+	vkDestroyPipelineCache(device, cache, nullptr);
+	cache = VK_NULL_HANDLE;
+}
+
+VkPipelineCache PipelineCache::createWorkerCache() {
+	VkPipelineCacheCreateInfo pipelineCacheCreateInfo{};
+	pipelineCacheCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+	VkPipelineCache workerCache = VK_NULL_HANDLE;
+	if (vkCreatePipelineCache(device, &pipelineCacheCreateInfo, nullptr, &workerCache) != VK_SUCCESS) {
+		throw std::runtime_error("RUNTIME ERROR: Failed to create a worker pipeline cache!");
+	}
+	std::lock_guard<std::mutex> lock(mutex);
+	workerCaches.push_back(workerCache);
+	return workerCache;
+}
+
+void PipelineCache::recordPipelineCreation(std::chrono::steady_clock::duration duration) {
+	std::lock_guard<std::mutex> lock(mutex);
+	pipelineCreationTime += duration;
+	pipelineCreationCount++;
+}
+
+double PipelineCache::getPipelineCreationMs() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return std::chrono::duration<double, std::milli>(pipelineCreationTime).count();
+}
+
+uint32_t PipelineCache::getPipelineCreationCount() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return pipelineCreationCount;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <mutex>
+
+/// @brief VkPipelineCache persisted to disk, so the driver doesn't recompile every shader on every launch.
+/// @brief The file is only used if its header matches this device and driver (vendor ID, device ID, pipeline cache UUID), and is
+/// @brief written back on 'save' (to a temporary file, renamed over the cache file, so an interrupted write never leaves a torn cache).
+/// @brief Pipelines compiled on other threads may use their own worker caches, which are merged into the main one before saving.
+class PipelineCache {
+public:
+	PipelineCache() = default;
+	~PipelineCache() = default;
+
+	PipelineCache(const PipelineCache&) = delete;
+	PipelineCache& operator=(const PipelineCache&) = delete;
+
+	/// @brief Creates the pipeline cache, seeded with the cache file if it's valid for this device. An empty 'filePath' keeps it in memory only.
+	void initialize(VkDevice device, VkPhysicalDevice physicalDevice, const std::string& filePath);
+	/// @brief Merges the worker caches into the main one and writes it to the cache file. Returns false if it couldn't be written.
+	bool save();
+	void destroy();
+
+	VkPipelineCache getHandle() const { return cache; }
+	/// @brief An extra (empty) cache for a thread compiling pipelines in the background, merged into the main one by 'save'.
+	VkPipelineCache createWorkerCache();
+
+	/// @brief Accounts the time spent creating pipelines (any thread), to compare cold and warm launches.
+	void recordPipelineCreation(std::chrono::steady_clock::duration duration);
+	double getPipelineCreationMs() const;
+	uint32_t getPipelineCreationCount() const;
+
+	/// @brief True if the cache was seeded from a valid cache file (a warm launch).
+	bool isWarm() const { return loadedSize > 0; }
+	size_t getLoadedSize() const { return loadedSize; }
+
+private:
+	bool isHeaderValid(const std::vector<char>& data, std::string& outReason) const;
+
+	VkDevice device = VK_NULL_HANDLE;
+	VkPipelineCache cache = VK_NULL_HANDLE;
+	std::string filePath;
+	size_t loadedSize{ 0 };
+	uint32_t vendorID{ 0 };
+	uint32_t deviceID{ 0 };
+	uint8_t pipelineCacheUUID[VK_UUID_SIZE]{};
+
+	// Guarded by 'mutex'
+	mutable std::mutex mutex;
+	std::vector<VkPipelineCache> workerCaches;
+	std::chrono::steady_clock::duration pipelineCreationTime{ 0 };
+	uint32_t pipelineCreationCount{ 0 };
+};
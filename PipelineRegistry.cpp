@@ -0,0 +1,167 @@
+
+#include "PipelineRegistry.h"
+#include <stdexcept>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+
+/// @brief FNV-1a over every field of the key.
+uint64_t GraphicsPipelineKey::hash() const {
+	uint64_t hashValue{ 14695981039346656037ull };
+	auto mix = [&hashValue](uint32_t value) {
+		for (uint32_t byte{ 0 }; byte < 4; byte++) {
+			hashValue ^= (value >> (byte * 8)) & 0xFF;
+			hashValue *= 1099511628211ull;
+		}
+	};
+	mix(static_cast<uint32_t>(vertexLayout));
+	mix(static_cast<uint32_t>(cullMode));
+	mix(blendEnable ? 1 : 0);
+	mix(depthTestEnable ? 1 : 0);
+	mix(depthWriteEnable ? 1 : 0);
+	mix(static_cast<uint32_t>(depthCompareOp));
+	for (uint32_t constant : specializationConstants) {
+		mix(constant);
+	}
+	return hashValue;
+}
+
+bool GraphicsPipelineKey::operator==(const GraphicsPipelineKey& other) const {
+	return vertexLayout == other.vertexLayout
+		&& cullMode == other.cullMode
+		&& blendEnable == other.blendEnable
+		&& depthTestEnable == other.depthTestEnable
+		&& depthWriteEnable == other.depthWriteEnable
+		&& depthCompareOp == other.depthCompareOp
+		&& specializationConstants == other.specializationConstants;
+}
+
+
+PipelineRegistry::~PipelineRegistry() {
+	destroy();
+}
+
+void PipelineRegistry::initialize(VkDevice device, PipelineCache& pipelineCache, Builder builder, const GraphicsPipelineKey& genericKey, uint32_t workerCount) {
+	this->device = device;
+	this->builder = std::move(builder);
+	this->genericKey = genericKey;
+
+	// The fallback of every other variant, so it's needed before the first frame
+	genericPipeline = this->builder(genericKey, pipelineCache.getHandle());
+	auto genericVariant = std::make_unique<Variant>();
+	genericVariant->state = VariantState::Ready;
+	genericVariant->pipeline = genericPipeline;
+	variants.emplace(genericKey, std::move(genericVariant));
+
+	stopping = false;
+	for (uint32_t i{ 0 }; i < workerCount; i++) {
+		workers.emplace_back(&PipelineRegistry::workerLoop, this, pipelineCache.createWorkerCache());
+	}
+}
+
+void PipelineRegistry::destroy() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+		queue.clear();
+	}
+	workAvailable.notify_all();
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+	workers.clear();
+
+	for (auto& [key, variant] : variants) {
+		if (variant->pipeline != VK_NULL_HANDLE) {
+			vkDestroyPipeline(device, variant->pipeline, nullptr);
+		}
+	}
+	variants.clear();
+	genericPipeline = VK_NULL_HANDLE;
+}
+
+PipelineRegistry::Variant& PipelineRegistry::findOrQueue(const GraphicsPipelineKey& key) {
+	auto found = variants.find(key);
+	if (found != variants.end()) {
+		return *found->second;
+	}
+	Variant& variant = *variants.emplace(key, std::make_unique<Variant>()).first->second;
+	if (workers.empty() || stopping) {
+		variant.state = VariantState::Failed;  // nothing would ever compile it
+	}
+	else {
+		queue.push_back(key);
+		workAvailable.notify_one();
+	}
+	return variant;
+}
+
+VkPipeline PipelineRegistry::getPipeline(const GraphicsPipelineKey& key) {
+	std::lock_guard<std::mutex> lock(mutex);
+	const Variant& variant = findOrQueue(key);
+	return variant.state == VariantState::Ready ? variant.pipeline : genericPipeline;
+}
+
+void PipelineRegistry::request(const GraphicsPipelineKey& key) {
+	std::lock_guard<std::mutex> lock(mutex);
+	findOrQueue(key);
+}
+
+bool PipelineRegistry::isReady(const GraphicsPipelineKey& key) const {
+	std::lock_guard<std::mutex> lock(mutex);
+	auto found = variants.find(key);
+	return found != variants.end() && found->second->state == VariantState::Ready;
+}
+
+uint64_t PipelineRegistry::getReadyGeneration() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return readyGeneration;
+}
+
+size_t PipelineRegistry::getVariantCount() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return variants.size();
+}
+
+size_t PipelineRegistry::getPendingCount() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return queue.size() + compilingCount;
+}
+
+/// @brief Compiles the queued variants one at a time, into this worker's own pipeline cache (merged into the main one when it's saved).
+void PipelineRegistry::workerLoop(VkPipelineCache workerCache) {
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true) {
+		workAvailable.wait(lock, [this]() { return stopping || !queue.empty(); });
+		if (stopping) {
+			return;
+		}
+		GraphicsPipelineKey key = queue.front();
+		queue.pop_front();
+		Variant& variant = *variants.at(key);
+		variant.state = VariantState::Compiling;
+		compilingCount++;
+		lock.unlock();
+
+		VkPipeline pipeline = VK_NULL_HANDLE;
+		auto compileStartTime = std::chrono::steady_clock::now();
+		try {
+			pipeline = builder(key, workerCache);
+		}
+		catch (const std::exception& e) {
+			std::cerr << "WARNING: Pipeline variant " << std::hex << key.hash() << std::dec << " failed to compile, keeping its fallback: " << e.what() << "\n";
+		}
+		double compileMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - compileStartTime).count();
+
+		lock.lock();
+		compilingCount--;
+		variant.pipeline = pipeline;
+		variant.compileMs = compileMs;
+		variant.state = (pipeline != VK_NULL_HANDLE) ? VariantState::Ready : VariantState::Failed;
+		if (variant.state == VariantState::Ready) {
+			readyGeneration++;
+			std::cout << "> Pipeline variant " << std::hex << key.hash() << std::dec << " compiled in the background (" << compileMs << " ms).\n";
+		}
+	}
+}
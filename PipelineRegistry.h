@@ -0,0 +1,106 @@
+#pragma once
+
+#include "PipelineCache.h"
+#include <vulkan/vulkan.h>
+#include <condition_variable>
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <deque>
+#include <array>
+#include <mutex>
+
+/// @brief Vertex input layouts a graphics pipeline variant can be built for.
+enum class VertexLayout : uint32_t {
+	MeshInstanced = 0  // binding 0: 'Vertex', binding 1: 'InstanceData'
+};
+
+/// @brief The state a graphics pipeline variant is built from (the shaders, pipeline layout and render pass are shared by every variant).
+/// @brief The specialization constants are those of the fragment shader, constant_id i taking 'specializationConstants[i]'.
+struct GraphicsPipelineKey {
+	static constexpr uint32_t MAX_SPECIALIZATION_CONSTANTS{ 4 };
+
+	VertexLayout vertexLayout{ VertexLayout::MeshInstanced };
+	VkCullModeFlags cullMode{ VK_CULL_MODE_NONE };
+	bool blendEnable{ false };
+	bool depthTestEnable{ true };
+	bool depthWriteEnable{ true };
+	VkCompareOp depthCompareOp{ VK_COMPARE_OP_LESS };
+	std::array<uint32_t, MAX_SPECIALIZATION_CONSTANTS> specializationConstants{};
+
+	uint64_t hash() const;
+	bool operator==(const GraphicsPipelineKey& other) const;
+	bool operator!=(const GraphicsPipelineKey& other) const { return !(*this == other); }
+};
+
+struct GraphicsPipelineKeyHash {
+	size_t operator()(const GraphicsPipelineKey& key) const { return static_cast<size_t>(key.hash()); }
+};
+
+/// @brief Graphics pipeline variants, keyed by their state. The generic variant is compiled up front (on the calling thread);
+/// @brief every other variant is compiled on the registry's worker threads the first time it's asked for, and 'getPipeline'
+/// @brief returns the generic variant until it's ready, so a new variant never stalls the frame that first uses it.
+/// @brief The pipelines themselves are built by the 'Builder' (which owns the shaders, layout and render pass).
+class PipelineRegistry {
+public:
+	/// @brief Builds the pipeline of a variant with the given pipeline cache. May run on any worker thread, may throw.
+	using Builder = std::function<VkPipeline(const GraphicsPipelineKey& key, VkPipelineCache cache)>;
+
+	PipelineRegistry() = default;
+	~PipelineRegistry();
+
+	PipelineRegistry(const PipelineRegistry&) = delete;
+	PipelineRegistry& operator=(const PipelineRegistry&) = delete;
+
+	/// @brief Compiles the generic variant right away and starts the workers (each compiling into its own worker cache of 'pipelineCache').
+	void initialize(VkDevice device, PipelineCache& pipelineCache, Builder builder, const GraphicsPipelineKey& genericKey, uint32_t workerCount);
+	/// @brief Waits for the compilations in progress (the queued ones are dropped) and destroys every pipeline.
+	void destroy();
+
+	/// @brief The variant's pipeline if it's ready. Otherwise queues it (the first time) and returns the generic variant's.
+	VkPipeline getPipeline(const GraphicsPipelineKey& key);
+	/// @brief Queues the variant's compilation if it isn't known yet (eg: to warm up the variants of the next scene).
+	void request(const GraphicsPipelineKey& key);
+	bool isReady(const GraphicsPipelineKey& key) const;
+
+	/// @brief Bumped every time a variant becomes ready (anything recorded with its fallback can be re-recorded).
+	uint64_t getReadyGeneration() const;
+	size_t getVariantCount() const;
+	size_t getPendingCount() const;
+
+private:
+	enum class VariantState {
+		Queued,
+		Compiling,
+		Ready,
+		Failed  // stays on the fallback
+	};
+	struct Variant {
+		VariantState state{ VariantState::Queued };
+		VkPipeline pipeline = VK_NULL_HANDLE;
+		double compileMs{ 0.0 };
+	};
+
+	void workerLoop(VkPipelineCache workerCache);
+	// (the caller holds 'mutex')
+	Variant& findOrQueue(const GraphicsPipelineKey& key);
+
+	VkDevice device = VK_NULL_HANDLE;
+	Builder builder;
+	GraphicsPipelineKey genericKey{};
+	VkPipeline genericPipeline = VK_NULL_HANDLE;
+	std::vector<std::thread> workers;
+
+	// Guarded by 'mutex'
+	mutable std::mutex mutex;
+	std::condition_variable workAvailable;
+	std::unordered_map<GraphicsPipelineKey, std::unique_ptr<Variant>, GraphicsPipelineKeyHash> variants;
+	std::deque<GraphicsPipelineKey> queue;
+	uint32_t compilingCount{ 0 };
+	uint64_t readyGeneration{ 0 };
+	bool stopping{ false };
+};
@@ -0,0 +1,548 @@
+
+#include "RenderGraph.h"
+#include <algorithm>
+#include <stdexcept>
+#include <iomanip>
+#include <utility>
+
+
+namespace {
+	/// @brief The names of the set bits of 'flags', joined with '|' ("0" if none).
+	std::string getFlagNames(uint32_t flags, const std::vector<std::pair<uint32_t, const char*>>& names) {
+		std::string result{};
+		for (const auto& [bit, name] : names) {
+			if (flags & bit) {
+				result += (result.empty() ? "" : "|") + std::string(name);
+				flags &= ~bit;
+			}
+		}
+		if (flags != 0) {
+			result += (result.empty() ? "" : "|") + std::to_string(flags);
+		}
+		return result.empty() ? "0" : result;
+	}
+
+	std::string getStageNames(VkPipelineStageFlags stages) {
+		static const std::vector<std::pair<uint32_t, const char*>> names = {
+			{ VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, "TOP_OF_PIPE" },
+			{ VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, "DRAW_INDIRECT" },
+			{ VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, "VERTEX_INPUT" },
+			{ VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, "VERTEX_SHADER" },
+			{ VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, "FRAGMENT_SHADER" },
+			{ VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT, "EARLY_FRAGMENT_TESTS" },
+			{ VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT, "LATE_FRAGMENT_TESTS" },
+			{ VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, "COLOR_ATTACHMENT_OUTPUT" },
+			{ VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, "COMPUTE_SHADER" },
+			{ VK_PIPELINE_STAGE_TRANSFER_BIT, "TRANSFER" },
+			{ VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, "BOTTOM_OF_PIPE" },
+			{ VK_PIPELINE_STAGE_HOST_BIT, "HOST" }
+		};
+		return getFlagNames(stages, names);
+	}
+
+	std::string getAccessFlagNames(VkAccessFlags access) {
+		static const std::vector<std::pair<uint32_t, const char*>> names = {
+			{ VK_ACCESS_INDIRECT_COMMAND_READ_BIT, "INDIRECT_COMMAND_READ" },
+			{ VK_ACCESS_SHADER_READ_BIT, "SHADER_READ" },
+			{ VK_ACCESS_SHADER_WRITE_BIT, "SHADER_WRITE" },
+			{ VK_ACCESS_COLOR_ATTACHMENT_READ_BIT, "COLOR_ATTACHMENT_READ" },
+			{ VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, "COLOR_ATTACHMENT_WRITE" },
+			{ VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT, "DEPTH_STENCIL_ATTACHMENT_READ" },
+			{ VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT, "DEPTH_STENCIL_ATTACHMENT_WRITE" },
+			{ VK_ACCESS_TRANSFER_READ_BIT, "TRANSFER_READ" },
+			{ VK_ACCESS_TRANSFER_WRITE_BIT, "TRANSFER_WRITE" },
+			{ VK_ACCESS_HOST_READ_BIT, "HOST_READ" }
+		};
+		return getFlagNames(access, names);
+	}
+
+	const char* getLayoutName(VkImageLayout layout) {
+		switch (layout) {
+		case VK_IMAGE_LAYOUT_UNDEFINED: return "UNDEFINED";
+		case VK_IMAGE_LAYOUT_GENERAL: return "GENERAL";
+		case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL: return "COLOR_ATTACHMENT_OPTIMAL";
+		case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL: return "DEPTH_STENCIL_ATTACHMENT_OPTIMAL";
+		case VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL: return "DEPTH_STENCIL_READ_ONLY_OPTIMAL";
+		case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL: return "SHADER_READ_ONLY_OPTIMAL";
+		case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL: return "TRANSFER_SRC_OPTIMAL";
+		case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL: return "TRANSFER_DST_OPTIMAL";
+		case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR: return "PRESENT_SRC_KHR";
+		default: return "?";
+		}
+	}
+}
+
+
+RenderGraphAccessInfo RenderGraph::getAccessInfo(RenderGraphAccess access) {
+	constexpr VkPipelineStageFlags fragmentTests = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+	constexpr VkAccessFlags depthAttachmentAccess = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+	switch (access) {
+	case RenderGraphAccess::None:
+		return {};
+	case RenderGraphAccess::ColorAttachmentWrite:
+		return { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, false, true };
+	case RenderGraphAccess::ColorAttachmentReadWrite:
+		return { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, true, true };
+	case RenderGraphAccess::DepthAttachmentWrite:
+		return { fragmentTests, depthAttachmentAccess, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, false, true };
+	case RenderGraphAccess::DepthAttachmentReadWrite:
+		return { fragmentTests, depthAttachmentAccess, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, true, true };
+	case RenderGraphAccess::DepthSampledRead:
+		return { VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, true, false };
+	case RenderGraphAccess::ComputeRead:
+		return { VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_GENERAL, true, false };
+	case RenderGraphAccess::ComputeWrite:
+		return { VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT, VK_IMAGE_LAYOUT_GENERAL, false, true };
+	case RenderGraphAccess::ComputeReadWrite:
+		return { VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT, VK_IMAGE_LAYOUT_GENERAL, true, true };
+	case RenderGraphAccess::FragmentSampledRead:
+		return { VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, true, false };
+	case RenderGraphAccess::IndirectRead:
+		return { VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT, VK_IMAGE_LAYOUT_GENERAL, true, false };
+	case RenderGraphAccess::TransferRead:
+		return { VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, true, false };
+	case RenderGraphAccess::TransferWrite:
+		return { VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, false, true };
+	case RenderGraphAccess::HostRead:
+		return { VK_PIPELINE_STAGE_HOST_BIT, VK_ACCESS_HOST_READ_BIT, VK_IMAGE_LAYOUT_GENERAL, true, false };
+	case RenderGraphAccess::Present:
+		// (the presentation engine's wait on the semaphore covers the memory side)
+		return { VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, true, false };
+	}
+	throw std::invalid_argument("RUNTIME ERROR: Unknown render graph access!");
+}
+
+const char* RenderGraph::getAccessName(RenderGraphAccess access) {
+	switch (access) {
+	case RenderGraphAccess::None: return "none";
+	case RenderGraphAccess::ColorAttachmentWrite: return "color attachment write";
+	case RenderGraphAccess::ColorAttachmentReadWrite: return "color attachment read/write";
+	case RenderGraphAccess::DepthAttachmentWrite: return "depth attachment write";
+	case RenderGraphAccess::DepthAttachmentReadWrite: return "depth attachment read/write";
+	case RenderGraphAccess::DepthSampledRead: return "depth sampled read";
+	case RenderGraphAccess::ComputeRead: return "compute read";
+	case RenderGraphAccess::ComputeWrite: return "compute write";
+	case RenderGraphAccess::ComputeReadWrite: return "compute read/write";
+	case RenderGraphAccess::FragmentSampledRead: return "fragment sampled read";
+	case RenderGraphAccess::IndirectRead: return "indirect read";
+	case RenderGraphAccess::TransferRead: return "transfer read";
+	case RenderGraphAccess::TransferWrite: return "transfer write";
+	case RenderGraphAccess::HostRead: return "host read";
+	case RenderGraphAccess::Present: return "present";
+	}
+	return "?";
+}
+
+RenderGraph::ResourceId RenderGraph::importImage(const std::string& name, VkImage image, VkImageAspectFlags aspectMask, uint32_t mipLevels, RenderGraphAccess initialAccess, std::optional<RenderGraphAccess> finalAccess, bool discardContents) {
+	Resource resource{};
+	resource.name = name;
+	resource.image = image;
+	resource.aspectMask = aspectMask;
+	resource.mipLevels = mipLevels;
+	resource.initialAccess = initialAccess;
+	resource.finalAccess = finalAccess;
+	resource.discardContents = discardContents;
+	resources.push_back(std::move(resource));
+	return static_cast<ResourceId>(resources.size() - 1);
+}
+
+RenderGraph::ResourceId RenderGraph::importBuffer(const std::string& name, RenderGraphAccess initialAccess, std::optional<RenderGraphAccess> finalAccess) {
+	Resource resource{};
+	resource.name = name;
+	resource.isImage = false;
+	resource.initialAccess = initialAccess;
+	resource.finalAccess = finalAccess;
+	resources.push_back(std::move(resource));
+	return static_cast<ResourceId>(resources.size() - 1);
+}
+
+RenderGraph::ResourceId RenderGraph::createTransientImage(const std::string& name, VkExtent2D extent, VkFormat format, VkImageUsageFlags usage, VkImageAspectFlags aspectMask) {
+	Resource resource{};
+	resource.name = name;
+	resource.transient = true;
+	resource.extent = extent;
+	resource.format = format;
+	resource.usage = usage;
+	resource.aspectMask = aspectMask;
+	resource.discardContents = true;
+	resources.push_back(std::move(resource));
+	return static_cast<ResourceId>(resources.size() - 1);
+}
+
+void RenderGraph::setImportedImage(ResourceId resource, VkImage image) {
+	Resource& importedResource = resources.at(resource);
+	if (!importedResource.isImage || importedResource.transient) {
+		throw std::invalid_argument("RUNTIME ERROR: Only imported images can be rebound!");
+	}
+	importedResource.image = image;
+}
+
+RenderGraph::PassId RenderGraph::addPass(const std::string& name, std::vector<Use> uses, std::function<void(VkCommandBuffer)> record, bool hasSideEffects) {
+	for (const Use& use : uses) {
+		if (use.resource >= resources.size()) {
+			throw std::invalid_argument("RUNTIME ERROR: Render graph pass '" + name + "' uses an unknown resource!");
+		}
+	}
+	Pass pass{};
+	pass.name = name;
+	pass.uses = std::move(uses);
+	pass.record = std::move(record);
+	pass.hasSideEffects = hasSideEffects;
+	passes.push_back(std::move(pass));
+	compiled = false;
+	return static_cast<PassId>(passes.size() - 1);
+}
+
+void RenderGraph::compile(VkDevice device, const TransientAllocator& transientAllocator) {
+	cullPasses();
+	placeTransientImages(device, transientAllocator);
+	computeBarriers();
+	compiled = true;
+}
+
+/// @brief Walks the passes backwards, keeping track of the resources whose current contents are still going to be read (starting
+/// @brief with the exported ones). A pass is kept if it has side effects or writes one of them. A kept pass that overwrites a
+/// @brief resource without reading it ends the need for its previous contents, and the resources it reads become needed.
+void RenderGraph::cullPasses() {
+	std::vector<bool> needed(resources.size(), false);
+	for (size_t i{ 0 }; i < resources.size(); i++) {
+		needed.at(i) = resources.at(i).finalAccess.has_value();
+	}
+	for (size_t passIndex = passes.size(); passIndex-- > 0;) {
+		Pass& pass = passes.at(passIndex);
+		bool writesNeededResource{ false };
+		for (const Use& use : pass.uses) {
+			writesNeededResource = writesNeededResource || (getAccessInfo(use.access).writes && needed.at(use.resource));
+		}
+		pass.culled = !pass.hasSideEffects && !writesNeededResource;
+		if (pass.culled) {
+			continue;
+		}
+		for (const Use& use : pass.uses) {
+			RenderGraphAccessInfo info = getAccessInfo(use.access);
+			if (info.writes && !info.reads) {
+				needed.at(use.resource) = false;
+			}
+		}
+		for (const Use& use : pass.uses) {
+			if (getAccessInfo(use.access).reads) {
+				needed.at(use.resource) = true;
+			}
+		}
+	}
+}
+
+/// @brief Creates the transient images used by kept passes and places them in one block: the ones whose pass ranges don't overlap may
+/// @brief share bytes. An image waits, in its first barrier, for the last uses of the images placed in its bytes.
+void RenderGraph::placeTransientImages(VkDevice device, const TransientAllocator& transientAllocator) {
+	for (uint32_t passIndex{ 0 }; passIndex < passes.size(); passIndex++) {
+		if (passes.at(passIndex).culled) {
+			continue;
+		}
+		for (const Use& use : passes.at(passIndex).uses) {
+			Resource& resource = resources.at(use.resource);
+			resource.firstPass = std::min(resource.firstPass, passIndex);
+			resource.lastPass = std::max(resource.lastPass, passIndex);
+		}
+	}
+
+	std::vector<ResourceId> transientIds{};
+	std::vector<TransientImage> transientImages{};
+	bool allTransientAttachments{ true };
+	for (ResourceId id{ 0 }; id < resources.size(); id++) {
+		Resource& resource = resources.at(id);
+		if (!resource.transient || resource.firstPass == UINT32_MAX) {
+			continue;  // (only used by culled passes: never created)
+		}
+		VkImageCreateInfo imageCreateInfo{};
+		imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+		imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
+		imageCreateInfo.extent = { resource.extent.width, resource.extent.height, 1 };
+		imageCreateInfo.mipLevels = resource.mipLevels;
+		imageCreateInfo.arrayLayers = 1;
+		imageCreateInfo.format = resource.format;
+		imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+		imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		imageCreateInfo.usage = resource.usage;
+		imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+		imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		if (vkCreateImage(device, &imageCreateInfo, nullptr, &resource.image) != VK_SUCCESS) {
+			throw std::runtime_error("RUNTIME ERROR: Failed to create the render graph's transient image '" + resource.name + "'!");
+		}
+		VkMemoryRequirements memoryRequirements{};
+		vkGetImageMemoryRequirements(device, resource.image, &memoryRequirements);
+		resource.size = memoryRequirements.size;
+		allTransientAttachments = allTransientAttachments && (resource.usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT);
+		transientIds.push_back(id);
+		transientImages.push_back({ resource.image, resource.firstPass, resource.lastPass });
+	}
+	if (transientIds.empty()) {
+		return;
+	}
+
+	// (lazily allocated memory only takes images that are nothing but transient attachments)
+	transientBlock = transientAllocator.allocate(device, transientImages, allTransientAttachments);
+	for (size_t i{ 0 }; i < transientIds.size(); i++) {
+		Resource& resource = resources.at(transientIds.at(i));
+		resource.offset = transientBlock.offsets.at(i);
+
+		VkImageViewCreateInfo viewInfo{};
+		viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+		viewInfo.image = resource.image;
+		viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+		viewInfo.format = resource.format;
+		viewInfo.subresourceRange = { resource.aspectMask, 0, resource.mipLevels, 0, 1 };
+		if (vkCreateImageView(device, &viewInfo, nullptr, &resource.imageView) != VK_SUCCESS) {
+			throw std::runtime_error("RUNTIME ERROR: Failed to create the render graph's transient image view '" + resource.name + "'!");
+		}
+	}
+
+	// The first use of an image waits for the last use of every image in the same bytes: the ones that ended earlier in the frame
+	// (aliasing), and the ones (itself included) that ended later in the previous frame
+	for (ResourceId id : transientIds) {
+		Resource& resource = resources.at(id);
+		for (ResourceId otherId : transientIds) {
+			const Resource& other = resources.at(otherId);
+			bool overlappingBytes = resource.offset < other.offset + other.size && other.offset < resource.offset + resource.size;
+			if (!overlappingBytes) {
+				continue;
+			}
+			for (const Use& use : passes.at(other.lastPass).uses) {
+				if (use.resource == otherId) {
+					RenderGraphAccessInfo info = getAccessInfo(use.access);
+					resource.aliasWaitStages |= info.stages;
+					resource.aliasWaitAccess |= info.writes ? info.access : 0;
+				}
+			}
+		}
+	}
+}
+
+void RenderGraph::computeBarriers() {
+	std::vector<ResourceState> states(resources.size());
+	for (size_t i{ 0 }; i < resources.size(); i++) {
+		const Resource& resource = resources.at(i);
+		ResourceState& state = states.at(i);
+		if (resource.transient) {
+			state.writeStages = resource.aliasWaitStages;
+			state.writeAccess = resource.aliasWaitAccess;
+			continue;
+		}
+		RenderGraphAccessInfo info = getAccessInfo(resource.initialAccess);
+		state.layout = resource.discardContents ? VK_IMAGE_LAYOUT_UNDEFINED : info.layout;
+		state.writeStages = info.writes ? info.stages : 0;
+		state.writeAccess = info.writes ? info.access : 0;
+		state.readStages = info.writes ? 0 : info.stages;
+	}
+
+	passBarriers.assign(passes.size(), BarrierBatch{});
+	finalBarriers = BarrierBatch{};
+	for (size_t passIndex{ 0 }; passIndex < passes.size(); passIndex++) {
+		if (passes.at(passIndex).culled) {
+			continue;
+		}
+		for (const Use& use : passes.at(passIndex).uses) {
+			transition(use.resource, resources.at(use.resource), states.at(use.resource), use.access, passBarriers.at(passIndex));
+		}
+	}
+	for (ResourceId id{ 0 }; id < resources.size(); id++) {
+		if (resources.at(id).finalAccess) {
+			transition(id, resources.at(id), states.at(id), *resources.at(id).finalAccess, finalBarriers);
+		}
+	}
+}
+
+/// @brief Adds the barrier (if any) a use of the resource needs after its current state, then moves the state past the use:
+/// @brief a layout change waits for every previous access, a read waits for the last write unless already visible to its
+/// @brief stages, and a write waits for the reads since the last write (execution only), or for the last write.
+void RenderGraph::transition(ResourceId resource, const Resource& description, ResourceState& state, RenderGraphAccess access, BarrierBatch& batch) {
+	RenderGraphAccessInfo info = getAccessInfo(access);
+	Barrier barrier{ resource, 0, info.stages, 0, info.access, state.layout, info.layout };
+	bool layoutChange = description.isImage && info.layout != state.layout;
+	if (layoutChange) {
+		barrier.srcStages = state.writeStages | state.readStages;
+		// (the previous writes are made available even when discarded, so they can't land after the transition)
+		barrier.srcAccess = state.writeAccess;
+	}
+	else {
+		bool notYetVisible = (info.stages & ~state.visibleStages) != 0 || (info.access & ~state.visibleAccess) != 0;
+		if (info.reads && state.writeStages != 0 && notYetVisible) {
+			barrier.srcStages |= state.writeStages;
+			barrier.srcAccess |= state.writeAccess;
+		}
+		if (info.writes) {
+			if (state.readStages != 0) {
+				barrier.srcStages |= state.readStages;
+			}
+			else if (state.writeStages != 0) {
+				barrier.srcStages |= state.writeStages;
+				barrier.srcAccess |= state.writeAccess;
+			}
+		}
+	}
+	bool barrierNeeded = layoutChange || barrier.srcStages != 0;
+	if (barrierNeeded) {
+		batch.barriers.push_back(barrier);
+		batch.srcStages |= barrier.srcStages;
+		batch.dstStages |= barrier.dstStages;
+	}
+
+	if (info.writes || layoutChange) {
+		// (a layout transition is a write the following accesses must wait for)
+		state.layout = description.isImage ? info.layout : state.layout;
+		state.writeStages = info.stages;
+		state.writeAccess = info.writes ? info.access : 0;
+		state.readStages = info.writes ? 0 : info.stages;
+		state.visibleStages = info.writes ? 0 : info.stages;
+		state.visibleAccess = info.writes ? 0 : info.access;
+	}
+	else {
+		state.readStages |= info.stages;
+		if (barrierNeeded) {
+			state.visibleStages |= info.stages;
+			state.visibleAccess |= info.access;
+		}
+	}
+}
+
+void RenderGraph::execute(VkCommandBuffer commandBuffer) const {
+	if (!compiled) {
+		throw std::runtime_error("RUNTIME ERROR: The render graph must be compiled before it's executed!");
+	}
+	for (size_t passIndex{ 0 }; passIndex < passes.size(); passIndex++) {
+		const Pass& pass = passes.at(passIndex);
+		if (pass.culled) {
+			continue;
+		}
+		recordBatch(commandBuffer, passBarriers.at(passIndex));
+		pass.record(commandBuffer);
+	}
+	recordBatch(commandBuffer, finalBarriers);
+}
+
+void RenderGraph::recordBatch(VkCommandBuffer commandBuffer, const BarrierBatch& batch) const {
+	if (batch.barriers.empty()) {
+		return;
+	}
+	std::vector<VkImageMemoryBarrier> imageBarriers{};
+	VkMemoryBarrier memoryBarrier{};
+	memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+	bool hasMemoryBarrier{ false };
+	for (const Barrier& barrier : batch.barriers) {
+		const Resource& resource = resources.at(barrier.resource);
+		if (!resource.isImage) {
+			memoryBarrier.srcAccessMask |= barrier.srcAccess;
+			memoryBarrier.dstAccessMask |= barrier.dstAccess;
+			hasMemoryBarrier = true;
+			continue;
+		}
+		if (resource.image == VK_NULL_HANDLE) {
+			throw std::runtime_error("RUNTIME ERROR: The render graph image '" + resource.name + "' isn't bound to any image!");
+		}
+		VkImageMemoryBarrier imageBarrier{};
+		imageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		imageBarrier.srcAccessMask = barrier.srcAccess;
+		imageBarrier.dstAccessMask = barrier.dstAccess;
+		imageBarrier.oldLayout = barrier.oldLayout;
+		imageBarrier.newLayout = barrier.newLayout;
+		imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		imageBarrier.image = resource.image;
+		imageBarrier.subresourceRange = { resource.aspectMask, 0, resource.mipLevels, 0, 1 };
+		imageBarriers.push_back(imageBarrier);
+	}
+	vkCmdPipelineBarrier(
+		commandBuffer,
+		batch.srcStages != 0 ? batch.srcStages : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+		batch.dstStages != 0 ? batch.dstStages : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+		0,
+		hasMemoryBarrier ? 1 : 0, hasMemoryBarrier ? &memoryBarrier : nullptr,
+		0, nullptr,
+		static_cast<uint32_t>(imageBarriers.size()), imageBarriers.data()
+	);
+}
+
+void RenderGraph::destroy(VkDevice device) {
+	for (Resource& resource : resources) {
+		if (!resource.transient) {
+			continue;
+		}
+		if (resource.imageView != VK_NULL_HANDLE) {
+			vkDestroyImageView(device, resource.imageView, nullptr);
+		}
+		if (resource.image != VK_NULL_HANDLE) {
+			vkDestroyImage(device, resource.image, nullptr);
+		}
+		resource.imageView = VK_NULL_HANDLE;
+		resource.image = VK_NULL_HANDLE;
+	}
+}
+
+VkImage RenderGraph::getImage(ResourceId resource) const {
+	return resources.at(resource).image;
+}
+
+VkImageView RenderGraph::getImageView(ResourceId resource) const {
+	return resources.at(resource).imageView;
+}
+
+void RenderGraph::logSummary(std::ostream& out) const {
+	size_t culledPassCount = std::count_if(passes.begin(), passes.end(), [](const Pass& pass) { return pass.culled; });
+	size_t barrierCount{ finalBarriers.barriers.size() };
+	size_t batchCount{ finalBarriers.barriers.empty() ? 0u : 1u };
+	for (const BarrierBatch& batch : passBarriers) {
+		barrierCount += batch.barriers.size();
+		batchCount += batch.barriers.empty() ? 0 : 1;
+	}
+	out << "> Render graph compiled: " << passes.size() - culledPassCount << " pass(es) (" << culledPassCount << " culled), "
+		<< barrierCount << " barrier(s) in " << batchCount << " vkCmdPipelineBarrier call(s), transient memory "
+		<< transientBlock.size / 1024 << " KiB (" << transientBlock.unaliasedSize / 1024 << " KiB without aliasing).\n";
+}
+
+void RenderGraph::writeBatch(std::ostream& out, const BarrierBatch& batch) const {
+	if (batch.barriers.empty()) {
+		out << "\tbarriers: none\n";
+		return;
+	}
+	out << "\tbarriers: " << getStageNames(batch.srcStages != 0 ? batch.srcStages : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT)
+		<< " -> " << getStageNames(batch.dstStages != 0 ? batch.dstStages : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT) << "\n";
+	for (const Barrier& barrier : batch.barriers) {
+		const Resource& resource = resources.at(barrier.resource);
+		out << "\t\t" << resource.name << ": " << getStageNames(barrier.srcStages) << " (" << getAccessFlagNames(barrier.srcAccess) << ") -> "
+			<< getStageNames(barrier.dstStages) << " (" << getAccessFlagNames(barrier.dstAccess) << ")";
+		if (resource.isImage) {
+			out << ", " << getLayoutName(barrier.oldLayout) << " -> " << getLayoutName(barrier.newLayout);
+		}
+		out << "\n";
+	}
+}
+
+void RenderGraph::writeSchedule(std::ostream& out) const {
+	out << "Render graph schedule (" << passes.size() << " passes, " << resources.size() << " resources)\n";
+	for (size_t passIndex{ 0 }; passIndex < passes.size(); passIndex++) {
+		const Pass& pass = passes.at(passIndex);
+		out << "[" << passIndex << "] " << pass.name << (pass.culled ? " (culled)" : "") << (pass.hasSideEffects ? " (side effects)" : "") << "\n";
+		for (const Use& use : pass.uses) {
+			out << "\tuses " << resources.at(use.resource).name << ": " << getAccessName(use.access) << "\n";
+		}
+		if (!pass.culled) {
+			writeBatch(out, passBarriers.at(passIndex));
+		}
+	}
+	out << "[end of frame]\n";
+	writeBatch(out, finalBarriers);
+
+	out << "Transient images (" << transientBlock.size / 1024 << " KiB block, " << transientBlock.unaliasedSize / 1024 << " KiB without aliasing"
+		<< (transientBlock.lazilyAllocated ? ", lazily allocated" : "") << ")\n";
+	for (const Resource& resource : resources) {
+		if (!resource.transient) {
+			continue;
+		}
+		if (resource.image == VK_NULL_HANDLE) {
+			out << "\t" << resource.name << ": not created (only used by culled passes)\n";
+			continue;
+		}
+		out << "\t" << resource.name << ": " << resource.extent.width << "x" << resource.extent.height << ", offset " << resource.offset
+			<< ", " << resource.size / 1024 << " KiB, passes [" << resource.firstPass << ", " << resource.lastPass << "]\n";
+	}
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include "TransientAllocator.h"
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// @brief How a pass uses a resource. Each one maps to the exact stages, access and (for images) layout it needs.
+enum class RenderGraphAccess : uint32_t {
+	None = 0,                   // not used yet (UNDEFINED layout, nothing to wait for)
+	ColorAttachmentWrite,       // cleared & written
+	ColorAttachmentReadWrite,   // loaded & written
+	DepthAttachmentWrite,       // cleared & tested/written
+	DepthAttachmentReadWrite,   // loaded & tested/written
+	DepthSampledRead,           // depth sampled by a compute shader (DEPTH_STENCIL_READ_ONLY_OPTIMAL)
+	ComputeRead,                // read by a compute shader (GENERAL for images)
+	ComputeWrite,               // entirely rewritten by a compute shader (GENERAL for images)
+	ComputeReadWrite,
+	FragmentSampledRead,        // sampled by a fragment shader
+	IndirectRead,               // indirect draw commands & counts
+	TransferRead,
+	TransferWrite,
+	HostRead,                   // read back by the CPU once the frame is done
+	Present
+};
+
+struct RenderGraphAccessInfo {
+	VkPipelineStageFlags stages{ 0 };
+	VkAccessFlags access{ 0 };
+	VkImageLayout layout{ VK_IMAGE_LAYOUT_UNDEFINED };
+	bool reads{ false };
+	bool writes{ false };
+};
+
+/// @brief A frame described as passes that declare the resources they read and write. Compiled once (until the resources change)
+/// @brief into the barriers between passes, batched into one vkCmdPipelineBarrier per pass whose stage masks are the union of the
+/// @brief exact stages on both sides of its dependencies. Passes whose writes reach no exported resource (nor have side effects) are culled, and
+/// @brief the transient images are placed in one block where the ones with disjoint lifetimes alias (see 'TransientAllocator').
+/// @brief Passes are recorded in the order they were added; the barriers inside a pass (eg: between mip levels) are its own.
+class RenderGraph {
+public:
+	using ResourceId = uint32_t;
+	using PassId = uint32_t;
+
+	struct Use {
+		ResourceId resource;
+		RenderGraphAccess access;
+	};
+
+	static RenderGraphAccessInfo getAccessInfo(RenderGraphAccess access);
+	static const char* getAccessName(RenderGraphAccess access);
+
+	/// @brief An image that outlives the frame. 'initialAccess' is its last use before the frame (eg: by the previous frame), and
+	/// @brief 'finalAccess' the use it's handed over to after the last pass (none leaves it as the last pass did, and doesn't keep the
+	/// @brief passes writing it alive). 'discardContents' transitions it from UNDEFINED at its first use.
+	ResourceId importImage(const std::string& name, VkImage image, VkImageAspectFlags aspectMask, uint32_t mipLevels, RenderGraphAccess initialAccess, std::optional<RenderGraphAccess> finalAccess, bool discardContents);
+	/// @brief A buffer (or a set of buffers used together) that outlives the frame. Buffer dependencies are global memory barriers.
+	ResourceId importBuffer(const std::string& name, RenderGraphAccess initialAccess, std::optional<RenderGraphAccess> finalAccess);
+	/// @brief An image only used within the frame, created (and aliased) by 'compile'. Its contents are undefined at its first use.
+	ResourceId createTransientImage(const std::string& name, VkExtent2D extent, VkFormat format, VkImageUsageFlags usage, VkImageAspectFlags aspectMask);
+	/// @brief Rebinds an imported image (eg: to the swapchain image being recorded). The compiled barriers stay valid.
+	void setImportedImage(ResourceId resource, VkImage image);
+
+	PassId addPass(const std::string& name, std::vector<Use> uses, std::function<void(VkCommandBuffer)> record, bool hasSideEffects = false);
+
+	/// @brief Culls the unused passes, computes the barriers, then creates the transient images & their memory block (the block
+	/// @brief belongs to the caller, see 'getTransientBlock'). Throws if a pass uses an unknown resource.
+	void compile(VkDevice device, const TransientAllocator& transientAllocator);
+	/// @brief Records the kept passes, each after its batch of barriers, then the hand-over to the final accesses.
+	void execute(VkCommandBuffer commandBuffer) const;
+	/// @brief Destroys the transient images & views (not their memory block).
+	void destroy(VkDevice device);
+
+	VkImage getImage(ResourceId resource) const;
+	VkImageView getImageView(ResourceId resource) const;
+	const TransientBlock& getTransientBlock() const { return transientBlock; }
+
+	void logSummary(std::ostream& out) const;
+	/// @brief The compiled schedule: kept & culled passes, every barrier (stages, accesses, layouts) and the transient placements.
+	void writeSchedule(std::ostream& out) const;
+
+private:
+	struct Resource {
+		std::string name;
+		bool isImage{ true };
+		bool transient{ false };
+		VkImage image = VK_NULL_HANDLE;
+		VkImageView imageView = VK_NULL_HANDLE;  // (transient images only)
+		VkImageAspectFlags aspectMask{ 0 };
+		uint32_t mipLevels{ 1 };
+		VkExtent2D extent{ 0, 0 };
+		VkFormat format{ VK_FORMAT_UNDEFINED };
+		VkImageUsageFlags usage{ 0 };
+		RenderGraphAccess initialAccess{ RenderGraphAccess::None };
+		std::optional<RenderGraphAccess> finalAccess;
+		bool discardContents{ false };
+		// Kept passes using it (transient lifetime), and its place in the transient block
+		uint32_t firstPass{ UINT32_MAX };
+		uint32_t lastPass{ 0 };
+		VkDeviceSize offset{ 0 };
+		VkDeviceSize size{ 0 };
+		// Last uses of the transient images sharing its bytes, itself included (its first barrier waits for them)
+		VkPipelineStageFlags aliasWaitStages{ 0 };
+		VkAccessFlags aliasWaitAccess{ 0 };
+	};
+
+	struct Pass {
+		std::string name;
+		std::vector<Use> uses;
+		std::function<void(VkCommandBuffer)> record;
+		bool hasSideEffects{ false };
+		bool culled{ false };
+	};
+
+	struct Barrier {
+		ResourceId resource;
+		VkPipelineStageFlags srcStages;
+		VkPipelineStageFlags dstStages;
+		VkAccessFlags srcAccess;
+		VkAccessFlags dstAccess;
+		VkImageLayout oldLayout;
+		VkImageLayout newLayout;
+	};
+
+	/// @brief The barriers recorded before a pass (or after the last one), as a single vkCmdPipelineBarrier.
+	struct BarrierBatch {
+		std::vector<Barrier> barriers;
+		VkPipelineStageFlags srcStages{ 0 };
+		VkPipelineStageFlags dstStages{ 0 };
+	};
+
+	/// @brief Where a resource stands while the barriers are computed.
+	struct ResourceState {
+		VkImageLayout layout{ VK_IMAGE_LAYOUT_UNDEFINED };
+		VkPipelineStageFlags writeStages{ 0 };
+		VkAccessFlags writeAccess{ 0 };
+		VkPipelineStageFlags readStages{ 0 };  // (reads since the last write)
+		VkPipelineStageFlags visibleStages{ 0 };  // stages & accesses the last write is already visible to
+		VkAccessFlags visibleAccess{ 0 };
+	};
+
+	void cullPasses();
+	void placeTransientImages(VkDevice device, const TransientAllocator& transientAllocator);
+	void computeBarriers();
+	static void transition(ResourceId resource, const Resource& description, ResourceState& state, RenderGraphAccess access, BarrierBatch& batch);
+	void recordBatch(VkCommandBuffer commandBuffer, const BarrierBatch& batch) const;
+	void writeBatch(std::ostream& out, const BarrierBatch& batch) const;
+
+	std::vector<Resource> resources;
+	std::vector<Pass> passes;
+	std::vector<BarrierBatch> passBarriers;  // one per pass (empty if culled)
+	BarrierBatch finalBarriers;
+	TransientBlock transientBlock{};
+	bool compiled{ false };
+};
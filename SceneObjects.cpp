@@ -0,0 +1,269 @@
+
+#include "SceneObjects.h"
+#include <algorithm>
+
+// The SSE path only needs SSE (baseline on x64), the AVX2 path is compiled in as well and picked at runtime if the CPU supports it
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1) || defined(__SSE__)
+#define SCENE_OBJECTS_X86_SIMD
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define SCENE_OBJECTS_AVX2_TARGET
+#else
+#define SCENE_OBJECTS_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+
+void SceneObjects::clear() {
+	count = 0;
+	for (std::vector<float>* values : { &centerX, &centerY, &centerZ, &radius, &minX, &minY, &minZ, &maxX, &maxY, &maxZ }) {
+		values->clear();
+	}
+}
+
+void SceneObjects::reserve(uint32_t objectCount) {
+	size_t paddedCount = (static_cast<size_t>(objectCount) + BATCH_SIZE - 1) / BATCH_SIZE * BATCH_SIZE;
+	for (std::vector<float>* values : { &centerX, &centerY, &centerZ, &radius, &minX, &minY, &minZ, &maxX, &maxY, &maxZ }) {
+		values->reserve(paddedCount);
+	}
+}
+
+uint32_t SceneObjects::add(const glm::vec3& sphereCenter, float sphereRadius, const glm::vec3& aabbMin, const glm::vec3& aabbMax) {
+	// A new batch starts: append a whole batch of padding, whose bits are masked out after the test
+	if (count % BATCH_SIZE == 0) {
+		for (std::vector<float>* values : { &centerX, &centerY, &centerZ, &radius, &minX, &minY, &minZ, &maxX, &maxY, &maxZ }) {
+			values->resize(values->size() + BATCH_SIZE, 0.0f);
+		}
+	}
+	centerX.at(count) = sphereCenter.x;
+	centerY.at(count) = sphereCenter.y;
+	centerZ.at(count) = sphereCenter.z;
+	radius.at(count) = sphereRadius;
+	minX.at(count) = aabbMin.x;
+	minY.at(count) = aabbMin.y;
+	minZ.at(count) = aabbMin.z;
+	maxX.at(count) = aabbMax.x;
+	maxY.at(count) = aabbMax.y;
+	maxZ.at(count) = aabbMax.z;
+	return count++;
+}
+
+uint32_t SceneObjects::cull(const std::array<glm::vec4, 6>& frustumPlanes, std::vector<uint64_t>& visibilityMask) const {
+	return cull(frustumPlanes, visibilityMask, getBestSupportedPath());
+}
+
+uint32_t SceneObjects::cull(const std::array<glm::vec4, 6>& frustumPlanes, std::vector<uint64_t>& visibilityMask, CullingPath path) const {
+	visibilityMask.assign((static_cast<size_t>(count) + 63) / 64, 0);
+	if (count == 0) {
+		return 0;
+	}
+
+	switch (isPathSupported(path) ? path : CullingPath::Scalar) {
+	case CullingPath::Avx2: cullAvx2(frustumPlanes, visibilityMask.data()); break;
+	case CullingPath::Sse:  cullSse(frustumPlanes, visibilityMask.data()); break;
+	default:                cullScalar(frustumPlanes, visibilityMask.data()); break;
+	}
+
+	// Clear the bits of the padding (the batches write whole bytes / nibbles), then count the visible objects
+	if (count % 64 != 0) {
+		visibilityMask.back() &= (1ull << (count % 64)) - 1;
+	}
+	uint32_t visibleCount{ 0 };
+	for (uint64_t bits : visibilityMask) {
+		for (; bits != 0; bits &= bits - 1) {
+			visibleCount++;
+		}
+	}
+	return visibleCount;
+}
+
+/// @brief Reference implementation: the same operations in the same order as the batched paths, one object at a time.
+void SceneObjects::cullScalar(const std::array<glm::vec4, 6>& frustumPlanes, uint64_t* visibilityMask) const {
+	for (uint32_t i{ 0 }; i < count; i++) {
+		bool visible{ true };
+		for (const glm::vec4& plane : frustumPlanes) {
+			// Sphere: its center is at most 'radius' behind the plane
+			float sphereDistance = plane.x * centerX[i] + plane.y * centerY[i] + plane.z * centerZ[i] + plane.w;
+			// AABB: its corner furthest along the plane normal (the "positive vertex") is in front of the plane
+			float boxDistance = plane.x * (plane.x >= 0.0f ? maxX[i] : minX[i]) + plane.y * (plane.y >= 0.0f ? maxY[i] : minY[i]) + plane.z * (plane.z >= 0.0f ? maxZ[i] : minZ[i]) + plane.w;
+			visible = visible && (sphereDistance + radius[i] >= 0.0f) && (boxDistance >= 0.0f);
+		}
+		if (visible) {
+			visibilityMask[i / 64] |= 1ull << (i % 64);
+		}
+	}
+}
+
+#ifdef SCENE_OBJECTS_X86_SIMD
+
+void SceneObjects::cullSse(const std::array<glm::vec4, 6>& frustumPlanes, uint64_t* visibilityMask) const {
+	// The positive vertex of a plane only depends on the signs of its normal, so it's picked per plane rather than per object
+	std::array<const float*, 6> positiveX{};
+	std::array<const float*, 6> positiveY{};
+	std::array<const float*, 6> positiveZ{};
+	for (size_t p{ 0 }; p < frustumPlanes.size(); p++) {
+		positiveX[p] = frustumPlanes[p].x >= 0.0f ? maxX.data() : minX.data();
+		positiveY[p] = frustumPlanes[p].y >= 0.0f ? maxY.data() : minY.data();
+		positiveZ[p] = frustumPlanes[p].z >= 0.0f ? maxZ.data() : minZ.data();
+	}
+
+	const __m128 zero = _mm_setzero_ps();
+	for (uint32_t first{ 0 }; first < count; first += 4) {
+		__m128 cx = _mm_loadu_ps(centerX.data() + first);
+		__m128 cy = _mm_loadu_ps(centerY.data() + first);
+		__m128 cz = _mm_loadu_ps(centerZ.data() + first);
+		__m128 r = _mm_loadu_ps(radius.data() + first);
+		__m128 visible = _mm_cmpeq_ps(zero, zero);  // all bits set
+		for (size_t p{ 0 }; p < frustumPlanes.size(); p++) {
+			__m128 nx = _mm_set1_ps(frustumPlanes[p].x);
+			__m128 ny = _mm_set1_ps(frustumPlanes[p].y);
+			__m128 nz = _mm_set1_ps(frustumPlanes[p].z);
+			__m128 d = _mm_set1_ps(frustumPlanes[p].w);
+
+			__m128 sphereDistance = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)), _mm_mul_ps(nz, cz)), d);
+			visible = _mm_and_ps(visible, _mm_cmpge_ps(_mm_add_ps(sphereDistance, r), zero));
+
+			__m128 boxDistance = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+				_mm_mul_ps(nx, _mm_loadu_ps(positiveX[p] + first)),
+				_mm_mul_ps(ny, _mm_loadu_ps(positiveY[p] + first))),
+				_mm_mul_ps(nz, _mm_loadu_ps(positiveZ[p] + first))), d);
+			visible = _mm_and_ps(visible, _mm_cmpge_ps(boxDistance, zero));
+		}
+		uint64_t bits = static_cast<uint64_t>(_mm_movemask_ps(visible));
+		visibilityMask[first / 64] |= bits << (first % 64);
+	}
+}
+
+SCENE_OBJECTS_AVX2_TARGET
+void SceneObjects::cullAvx2(const std::array<glm::vec4, 6>& frustumPlanes, uint64_t* visibilityMask) const {
+	std::array<const float*, 6> positiveX{};
+	std::array<const float*, 6> positiveY{};
+	std::array<const float*, 6> positiveZ{};
+	for (size_t p{ 0 }; p < frustumPlanes.size(); p++) {
+		positiveX[p] = frustumPlanes[p].x >= 0.0f ? maxX.data() : minX.data();
+		positiveY[p] = frustumPlanes[p].y >= 0.0f ? maxY.data() : minY.data();
+		positiveZ[p] = frustumPlanes[p].z >= 0.0f ? maxZ.data() : minZ.data();
+	}
+
+	const __m256 zero = _mm256_setzero_ps();
+	for (uint32_t first{ 0 }; first < count; first += 8) {
+		__m256 cx = _mm256_loadu_ps(centerX.data() + first);
+		__m256 cy = _mm256_loadu_ps(centerY.data() + first);
+		__m256 cz = _mm256_loadu_ps(centerZ.data() + first);
+		__m256 r = _mm256_loadu_ps(radius.data() + first);
+		__m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+		for (size_t p{ 0 }; p < frustumPlanes.size(); p++) {
+			__m256 nx = _mm256_set1_ps(frustumPlanes[p].x);
+			__m256 ny = _mm256_set1_ps(frustumPlanes[p].y);
+			__m256 nz = _mm256_set1_ps(frustumPlanes[p].z);
+			__m256 d = _mm256_set1_ps(frustumPlanes[p].w);
+
+			// (multiplies and adds kept separate, not fused, so the results match the scalar path bit for bit)
+			__m256 sphereDistance = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx, cx), _mm256_mul_ps(ny, cy)), _mm256_mul_ps(nz, cz)), d);
+			visible = _mm256_and_ps(visible, _mm256_cmp_ps(_mm256_add_ps(sphereDistance, r), zero, _CMP_GE_OQ));
+
+			__m256 boxDistance = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+				_mm256_mul_ps(nx, _mm256_loadu_ps(positiveX[p] + first)),
+				_mm256_mul_ps(ny, _mm256_loadu_ps(positiveY[p] + first))),
+				_mm256_mul_ps(nz, _mm256_loadu_ps(positiveZ[p] + first))), d);
+			visible = _mm256_and_ps(visible, _mm256_cmp_ps(boxDistance, zero, _CMP_GE_OQ));
+		}
+		uint64_t bits = static_cast<uint64_t>(_mm256_movemask_ps(visible));
+		visibilityMask[first / 64] |= bits << (first % 64);
+	}
+}
+
+#else
+
+void SceneObjects::cullSse(const std::array<glm::vec4, 6>& frustumPlanes, uint64_t* visibilityMask) const {
+	cullScalar(frustumPlanes, visibilityMask);
+}
+
+void SceneObjects::cullAvx2(const std::array<glm::vec4, 6>& frustumPlanes, uint64_t* visibilityMask) const {
+	cullScalar(frustumPlanes, visibilityMask);
+}
+
+#endif
+
+CullingPath SceneObjects::getBestSupportedPath() {
+	static const CullingPath bestPath = isPathSupported(CullingPath::Avx2) ? CullingPath::Avx2 : isPathSupported(CullingPath::Sse) ? CullingPath::Sse : CullingPath::Scalar;
+	return bestPath;
+}
+
+bool SceneObjects::isPathSupported(CullingPath path) {
+	switch (path) {
+	case CullingPath::Scalar:
+		return true;
+#ifdef SCENE_OBJECTS_X86_SIMD
+	case CullingPath::Sse:
+		return true;
+	case CullingPath::Avx2: {
+#if defined(_MSC_VER)
+		// AVX2 (CPUID leaf 7, EBX bit 5), and the OS saving the YMM registers (OSXSAVE, then XCR0 bits 1 & 2)
+		int cpuInfo[4]{};
+		__cpuid(cpuInfo, 0);
+		if (cpuInfo[0] < 7) {
+			return false;
+		}
+		__cpuid(cpuInfo, 1);
+		bool osSavesYmm = (cpuInfo[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+		__cpuidex(cpuInfo, 7, 0);
+		return osSavesYmm && (cpuInfo[1] & (1 << 5)) != 0;
+#else
+		return __builtin_cpu_supports("avx2");
+#endif
+	}
+#endif
+	default:
+		return false;
+	}
+}
+
+const char* SceneObjects::getPathName(CullingPath path) {
+	switch (path) {
+	case CullingPath::Scalar: return "scalar";
+	case CullingPath::Sse:    return "SSE";
+	case CullingPath::Avx2:   return "AVX2";
+	default:                  return "unknown";
+	}
+}
+
+/// @brief Extracts the 6 frustum planes (left, right, bottom, top, near, far) from a view-projection matrix.
+/// @brief Each plane is normalized, with its normal pointing into the frustum (assumes a [0, 1] clip space depth range).
+std::array<glm::vec4, 6> SceneObjects::extractFrustumPlanes(const glm::mat4& viewProjection) {
+	// Rows of the matrix (GLM matrices are column-major)
+	std::array<glm::vec4, 4> rows{};
+	for (int row{ 0 }; row < 4; row++) {
+		rows.at(row) = glm::vec4(viewProjection[0][row], viewProjection[1][row], viewProjection[2][row], viewProjection[3][row]);
+	}
+
+	std::array<glm::vec4, 6> frustumPlanes = {
+		rows[3] + rows[0],  // left
+		rows[3] - rows[0],  // right
+		rows[3] + rows[1],  // bottom
+		rows[3] - rows[1],  // top
+		rows[2],            // near
+		rows[3] - rows[2]   // far
+	};
+	for (glm::vec4& plane : frustumPlanes) {
+		plane /= glm::length(glm::vec3(plane));
+	}
+	return frustumPlanes;
+}
+
+uint32_t SceneObjects::countTrailingZeros(uint64_t bits) {
+#if defined(_MSC_VER) && defined(_M_X64)
+	unsigned long index{ 0 };
+	_BitScanForward64(&index, bits);
+	return static_cast<uint32_t>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+	return static_cast<uint32_t>(__builtin_ctzll(bits));
+#else
+	uint32_t index{ 0 };
+	for (; (bits & 1) == 0; bits >>= 1) {
+		index++;
+	}
+	return index;
+#endif
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+// (same GLM configuration as Application.h: it must match in every translation unit that uses GLM types)
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#define GLM_FORCE_DEFAULT_ALIGNED_GENTYPES
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include <array>
+
+/// @brief Implementations of the frustum test (the batched ones test 4 or 8 objects per instruction).
+enum class CullingPath : uint32_t {
+	Scalar = 0,
+	Sse,
+	Avx2
+};
+
+/// @brief The objects placed in the scene with their world space bounds (a bounding sphere and an AABB each), stored as
+/// @brief structure-of-arrays so the frustum test runs on 4 (SSE) or 8 (AVX2) objects at once.
+/// @brief The frustum planes come straight from the camera's view-projection matrix ('extractFrustumPlanes'),
+/// @brief and the result is a visibility bitmask (bit i of word i / 64 is set if object i is visible).
+class SceneObjects {
+public:
+	/// @brief The arrays are padded to a multiple of this, so the batched tests never need a scalar tail.
+	static constexpr uint32_t BATCH_SIZE{ 8 };
+
+	void clear();
+	void reserve(uint32_t objectCount);
+	/// @brief Adds an object (with its world space bounds) and returns its index.
+	uint32_t add(const glm::vec3& sphereCenter, float sphereRadius, const glm::vec3& aabbMin, const glm::vec3& aabbMax);
+	uint32_t getCount() const { return count; }
+
+	/// @brief Tests every object against the frustum with the fastest path the CPU supports. An object is visible if both its
+	/// @brief sphere and its AABB are at least partly inside all 6 planes. Fills 'visibilityMask' and returns the visible count.
+	uint32_t cull(const std::array<glm::vec4, 6>& frustumPlanes, std::vector<uint64_t>& visibilityMask) const;
+	uint32_t cull(const std::array<glm::vec4, 6>& frustumPlanes, std::vector<uint64_t>& visibilityMask, CullingPath path) const;
+
+	/// @brief Calls 'function(objectIndex)' for every visible object of a visibility mask, in increasing order.
+	template <typename Function>
+	static void forEachVisible(const std::vector<uint64_t>& visibilityMask, Function&& function) {
+		for (size_t word{ 0 }; word < visibilityMask.size(); word++) {
+			for (uint64_t bits = visibilityMask[word]; bits != 0; bits &= bits - 1) {
+				function(static_cast<uint32_t>(word * 64 + countTrailingZeros(bits)));
+			}
+		}
+	}
+
+	static CullingPath getBestSupportedPath();
+	static bool isPathSupported(CullingPath path);
+	static const char* getPathName(CullingPath path);
+	static std::array<glm::vec4, 6> extractFrustumPlanes(const glm::mat4& viewProjection);
+
+private:
+	void cullScalar(const std::array<glm::vec4, 6>& frustumPlanes, uint64_t* visibilityMask) const;
+	void cullSse(const std::array<glm::vec4, 6>& frustumPlanes, uint64_t* visibilityMask) const;
+	void cullAvx2(const std::array<glm::vec4, 6>& frustumPlanes, uint64_t* visibilityMask) const;
+	static uint32_t countTrailingZeros(uint64_t bits);
+
+	uint32_t count{ 0 };
+	// One entry per object (padded to a multiple of BATCH_SIZE)
+	std::vector<float> centerX;
+	std::vector<float> centerY;
+	std::vector<float> centerZ;
+	std::vector<float> radius;
+	std::vector<float> minX;
+	std::vector<float> minY;
+	std::vector<float> minZ;
+	std::vector<float> maxX;
+	std::vector<float> maxY;
+	std::vector<float> maxZ;
+};
@@ -0,0 +1,161 @@
+
+#include "StartupProfiler.h"
+#include <filesystem>
+#include <algorithm>
+#include <iomanip>
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+
+// Running totals of the thread (a scope keeps their values at its start)
+static thread_local uint64_t threadBytesRead{ 0 };
+static thread_local uint64_t threadHeapBytes{ 0 };
+static thread_local uint64_t threadDeviceMemoryBytes{ 0 };
+
+// Heap allocations of the whole program go through here (counted, then forwarded to malloc)
+void* operator new(std::size_t size) {
+	threadHeapBytes += size;
+	if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+		return pointer;
+	}
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+	return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept {
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+	std::free(pointer);
+}
+
+
+StartupProfiler::Scope::Scope(StartupProfiler& profiler, const std::string& name)
+	: profiler(profiler), name(name) {
+	startCpuMs = getThreadCpuMs();
+	startBytesRead = threadBytesRead;
+	startHeapBytes = threadHeapBytes;
+	startDeviceMemoryBytes = threadDeviceMemoryBytes;
+	startTime = std::chrono::steady_clock::now();
+}
+
+StartupProfiler::Scope::~Scope() {
+	auto endTime = std::chrono::steady_clock::now();
+	Phase phase{};
+	phase.name = name;
+	phase.startMs = std::chrono::duration<double, std::milli>(startTime - profiler.creationTime).count();
+	phase.wallMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+	phase.cpuMs = getThreadCpuMs() - startCpuMs;
+	phase.bytesRead = threadBytesRead - startBytesRead;
+	phase.heapBytes = threadHeapBytes - startHeapBytes;
+	phase.deviceMemoryBytes = threadDeviceMemoryBytes - startDeviceMemoryBytes;
+
+	std::lock_guard<std::mutex> lock(profiler.mutex);
+	profiler.phases.push_back(std::move(phase));
+}
+
+
+StartupProfiler::StartupProfiler()
+	: creationTime(std::chrono::steady_clock::now()) {
+}
+
+void StartupProfiler::recordBytesRead(uint64_t bytes) {
+	threadBytesRead += bytes;
+}
+
+void StartupProfiler::recordFileRead(const std::string& filePath) {
+	std::error_code error{};
+	std::uintmax_t fileSize = std::filesystem::file_size(filePath, error);
+	if (!error) {
+		threadBytesRead += fileSize;
+	}
+}
+
+void StartupProfiler::recordDeviceMemoryAllocation(uint64_t bytes) {
+	threadDeviceMemoryBytes += bytes;
+}
+
+/// @brief CPU time (user + kernel) the calling thread has used so far.
+double StartupProfiler::getThreadCpuMs() {
+#ifdef _WIN32
+	FILETIME creationTime{}, exitTime{}, kernelTime{}, userTime{};
+	if (!GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+		return 0.0;
+	}
+	auto toTicks = [](const FILETIME& time) { return (static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime; };
+	return static_cast<double>(toTicks(kernelTime) + toTicks(userTime)) / 10000.0;  // 100 ns ticks
+#else
+	timespec time{};
+	if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0) {
+		return 0.0;
+	}
+	return static_cast<double>(time.tv_sec) * 1000.0 + static_cast<double>(time.tv_nsec) / 1000000.0;
+#endif
+}
+
+void StartupProfiler::logReport(std::ostream& out) const {
+	std::vector<Phase> sortedPhases{};
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		sortedPhases = phases;
+	}
+	std::sort(sortedPhases.begin(), sortedPhases.end(), [](const Phase& a, const Phase& b) { return a.wallMs > b.wallMs; });
+
+	Phase total{};
+	out << std::fixed << std::setprecision(2)
+		<< "> Startup phases (slowest first):\n"
+		<< "\t" << std::left << std::setw(32) << "Phase" << std::right
+		<< std::setw(11) << "Wall ms" << std::setw(11) << "CPU ms" << std::setw(12) << "Read KiB" << std::setw(12) << "Heap KiB" << std::setw(14) << "Device KiB" << "\n";
+	for (const Phase& phase : sortedPhases) {
+		out << "\t" << std::left << std::setw(32) << phase.name << std::right
+			<< std::setw(11) << phase.wallMs << std::setw(11) << phase.cpuMs
+			<< std::setw(12) << phase.bytesRead / 1024 << std::setw(12) << phase.heapBytes / 1024 << std::setw(14) << phase.deviceMemoryBytes / 1024 << "\n";
+		total.wallMs += phase.wallMs;
+		total.cpuMs += phase.cpuMs;
+		total.bytesRead += phase.bytesRead;
+		total.heapBytes += phase.heapBytes;
+		total.deviceMemoryBytes += phase.deviceMemoryBytes;
+	}
+	out << "\t" << std::left << std::setw(32) << "(sum)" << std::right
+		<< std::setw(11) << total.wallMs << std::setw(11) << total.cpuMs
+		<< std::setw(12) << total.bytesRead / 1024 << std::setw(12) << total.heapBytes / 1024 << std::setw(14) << total.deviceMemoryBytes / 1024 << "\n"
+		<< std::defaultfloat;
+}
+
+void StartupProfiler::writeJson(std::ostream& out) const {
+	std::lock_guard<std::mutex> lock(mutex);
+	out << std::fixed << std::setprecision(3)
+		<< "{\n"
+		<< "\t\"phases\": [\n";
+	for (size_t i{ 0 }; i < phases.size(); i++) {
+		const Phase& phase = phases.at(i);
+		out << "\t\t{ \"name\": \"" << phase.name << "\""
+			<< ", \"startMs\": " << phase.startMs
+			<< ", \"wallMs\": " << phase.wallMs
+			<< ", \"cpuMs\": " << phase.cpuMs
+			<< ", \"bytesRead\": " << phase.bytesRead
+			<< ", \"heapBytes\": " << phase.heapBytes
+			<< ", \"deviceMemoryBytes\": " << phase.deviceMemoryBytes << " }"
+			<< (i + 1 < phases.size() ? "," : "") << "\n";
+	}
+	out << "\t]\n}\n" << std::defaultfloat;
+}
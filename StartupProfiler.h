@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <mutex>
+
+/// @brief Per-step accounting of the startup: wall time, CPU time, bytes read from disk, heap bytes allocated and device memory
+/// @brief allocated, measured by a 'Scope' around each initialization step. The counters are per thread, so steps running at the
+/// @brief same time on different threads (see 'TaskGraph') are each charged only what they did themselves. Scopes may nest (the
+/// @brief outer one then includes the inner one's costs).
+class StartupProfiler {
+public:
+	/// @brief Measures from its construction to its destruction, on the thread it was created on.
+	class Scope {
+	public:
+		Scope(StartupProfiler& profiler, const std::string& name);
+		~Scope();
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+		StartupProfiler& profiler;
+		std::string name;
+		std::chrono::steady_clock::time_point startTime;
+		double startCpuMs{ 0.0 };
+		uint64_t startBytesRead{ 0 };
+		uint64_t startHeapBytes{ 0 };
+		uint64_t startDeviceMemoryBytes{ 0 };
+	};
+
+	StartupProfiler();
+
+	/// @brief eg: 'auto phase = startupProfiler.scope("createGraphicsPipeline");'
+	Scope scope(const std::string& name) { return Scope(*this, name); }
+
+	/// @brief Counters of the calling thread (the heap allocations are counted by the global 'operator new' itself).
+	static void recordBytesRead(uint64_t bytes);
+	/// @brief For the files read whole by a library (eg: the model, the texture): records the file's size.
+	static void recordFileRead(const std::string& filePath);
+	static void recordDeviceMemoryAllocation(uint64_t bytes);
+
+	/// @brief Every phase, slowest first, and the totals.
+	void logReport(std::ostream& out) const;
+	/// @brief Every phase (in the order they ended) as JSON.
+	void writeJson(std::ostream& out) const;
+
+private:
+	struct Phase {
+		std::string name;
+		double startMs{ 0.0 };  // since the profiler's creation
+		double wallMs{ 0.0 };
+		double cpuMs{ 0.0 };
+		uint64_t bytesRead{ 0 };
+		uint64_t heapBytes{ 0 };
+		uint64_t deviceMemoryBytes{ 0 };
+	};
+
+	static double getThreadCpuMs();
+
+	std::chrono::steady_clock::time_point creationTime;
+	mutable std::mutex mutex;
+	std::vector<Phase> phases;
+};
@@ -0,0 +1,180 @@
+
+#include "TaskGraph.h"
+#include <algorithm>
+#include <stdexcept>
+#include <iomanip>
+#include <thread>
+
+
+TaskId TaskGraph::add(const std::string& name, std::function<void()> function, const std::vector<TaskId>& dependencies, double estimatedCostMs, bool mainThreadOnly) {
+	TaskId taskId = static_cast<TaskId>(tasks.size());
+	for (TaskId dependency : dependencies) {
+		if (dependency >= taskId) {
+			throw std::runtime_error("RUNTIME ERROR: Task '" + name + "' depends on a task added after it!");
+		}
+	}
+	Task task{};
+	task.name = name;
+	task.function = std::move(function);
+	task.dependencies = dependencies;
+	task.estimatedCostMs = estimatedCostMs;
+	task.mainThreadOnly = mainThreadOnly;
+	tasks.push_back(std::move(task));
+	for (TaskId dependency : dependencies) {
+		tasks.at(dependency).dependents.push_back(taskId);
+	}
+	return taskId;
+}
+
+void TaskGraph::run(uint32_t threadCount) {
+	runThreadCount = std::max(1u, threadCount);
+
+	// Priorities, from the last task back (the ids are a topological order)
+	for (size_t i{ tasks.size() }; i-- > 0;) {
+		Task& task = tasks.at(i);
+		double longestDependentPath{ 0.0 };
+		for (TaskId dependent : task.dependents) {
+			longestDependentPath = std::max(longestDependentPath, tasks.at(dependent).priority);
+		}
+		task.priority = task.estimatedCostMs + longestDependentPath;
+	}
+
+	readyTasks.clear();
+	for (TaskId taskId{ 0 }; taskId < tasks.size(); taskId++) {
+		Task& task = tasks.at(taskId);
+		task.pendingDependencies = static_cast<uint32_t>(task.dependencies.size());
+		task.executed = false;
+		if (task.pendingDependencies == 0) {
+			readyTasks.push_back(taskId);
+		}
+	}
+	remainingTasks = tasks.size();
+	firstException = nullptr;
+	runStartTime = std::chrono::steady_clock::now();
+
+	std::vector<std::thread> workers{};
+	for (uint32_t threadIndex{ 1 }; threadIndex < runThreadCount; threadIndex++) {
+		workers.emplace_back(&TaskGraph::workerLoop, this, threadIndex);
+	}
+	workerLoop(0);
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+	wallTimeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - runStartTime).count();
+
+	if (firstException) {
+		std::rethrow_exception(firstException);
+	}
+}
+
+/// @brief Runs the highest priority ready task this thread may run, until every task is done (or one has thrown).
+void TaskGraph::workerLoop(uint32_t threadIndex) {
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true) {
+		auto bestReadyTask = readyTasks.end();
+		stateChanged.wait(lock, [&]() {
+			if (remainingTasks == 0 || firstException) {
+				return true;
+			}
+			bestReadyTask = readyTasks.end();
+			for (auto readyTask = readyTasks.begin(); readyTask != readyTasks.end(); readyTask++) {
+				const Task& task = tasks.at(*readyTask);
+				if ((threadIndex == 0 || !task.mainThreadOnly) && (bestReadyTask == readyTasks.end() || task.priority > tasks.at(*bestReadyTask).priority)) {
+					bestReadyTask = readyTask;
+				}
+			}
+			return bestReadyTask != readyTasks.end();
+		});
+		if (remainingTasks == 0 || firstException) {
+			return;
+		}
+		TaskId taskId = *bestReadyTask;
+		readyTasks.erase(bestReadyTask);
+		Task& task = tasks.at(taskId);
+		task.threadIndex = threadIndex;
+		task.startMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - runStartTime).count();
+		lock.unlock();
+
+		std::exception_ptr exception{};
+		try {
+			task.function();
+		}
+		catch (...) {
+			exception = std::current_exception();
+		}
+
+		lock.lock();
+		task.endMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - runStartTime).count();
+		task.executed = true;
+		remainingTasks--;
+		if (exception && !firstException) {
+			firstException = exception;
+		}
+		for (TaskId dependent : task.dependents) {
+			if (--tasks.at(dependent).pendingDependencies == 0) {
+				readyTasks.push_back(dependent);
+			}
+		}
+		stateChanged.notify_all();
+	}
+}
+
+std::vector<TaskId> TaskGraph::getCriticalPath() const {
+	std::vector<TaskId> criticalPath{};
+	auto lastTask = std::max_element(tasks.begin(), tasks.end(), [](const Task& a, const Task& b) { return a.endMs < b.endMs; });
+	if (lastTask == tasks.end()) {
+		return criticalPath;
+	}
+	TaskId taskId = static_cast<TaskId>(lastTask - tasks.begin());
+	while (true) {
+		criticalPath.push_back(taskId);
+		const Task& task = tasks.at(taskId);
+		if (task.dependencies.empty()) {
+			break;
+		}
+		taskId = *std::max_element(task.dependencies.begin(), task.dependencies.end(), [this](TaskId a, TaskId b) { return tasks.at(a).endMs < tasks.at(b).endMs; });
+	}
+	std::reverse(criticalPath.begin(), criticalPath.end());
+	return criticalPath;
+}
+
+void TaskGraph::logSummary(std::ostream& out) const {
+	double summedTaskMs{ 0.0 };
+	for (const Task& task : tasks) {
+		summedTaskMs += task.endMs - task.startMs;
+	}
+	std::vector<TaskId> criticalPath = getCriticalPath();
+	out << std::fixed << std::setprecision(2)
+		<< "> Ran " << tasks.size() << " tasks on " << runThreadCount << " thread(s) in " << wallTimeMs << " ms (" << summedTaskMs << " ms of task time).\n"
+		<< "> Critical path (" << criticalPath.size() << " tasks):\n";
+	for (TaskId taskId : criticalPath) {
+		const Task& task = tasks.at(taskId);
+		out << "\t" << std::left << std::setw(32) << task.name << std::right << std::setw(9) << task.endMs - task.startMs << " ms  (ends at " << task.endMs << " ms)\n";
+	}
+	out << std::defaultfloat;
+}
+
+void TaskGraph::writeJson(std::ostream& out) const {
+	std::vector<TaskId> criticalPath = getCriticalPath();
+	out << std::fixed << std::setprecision(3)
+		<< "{\n"
+		<< "\t\"threads\": " << runThreadCount << ",\n"
+		<< "\t\"wallTimeMs\": " << wallTimeMs << ",\n"
+		<< "\t\"tasks\": [\n";
+	for (TaskId taskId{ 0 }; taskId < tasks.size(); taskId++) {
+		const Task& task = tasks.at(taskId);
+		bool onCriticalPath = std::find(criticalPath.begin(), criticalPath.end(), taskId) != criticalPath.end();
+		out << "\t\t{ \"id\": " << taskId << ", \"name\": \"" << task.name << "\", \"dependencies\": [";
+		for (size_t i{ 0 }; i < task.dependencies.size(); i++) {
+			out << (i > 0 ? ", " : "") << task.dependencies.at(i);
+		}
+		out << "], \"executed\": " << (task.executed ? "true" : "false")
+			<< ", \"thread\": " << task.threadIndex
+			<< ", \"startMs\": " << task.startMs
+			<< ", \"durationMs\": " << task.endMs - task.startMs
+			<< ", \"estimatedCostMs\": " << task.estimatedCostMs
+			<< ", \"criticalPath\": " << (onCriticalPath ? "true" : "false") << " }"
+			<< (taskId + 1 < tasks.size() ? "," : "") << "\n";
+	}
+	out << "\t]\n}\n" << std::defaultfloat;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <cstdint>
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <mutex>
+
+/// @brief Index of a task in its 'TaskGraph' (tasks are numbered in the order they're added).
+using TaskId = uint32_t;
+
+/// @brief Tasks with dependencies, run on a set of threads as soon as their dependencies are done (eg: the initialization steps).
+/// @brief Among the ready tasks, the one with the longest estimated path to the end of the graph runs first (critical path scheduling),
+/// @brief so the long chains start as early as possible. The calling thread takes part, and is the only one running the tasks
+/// @brief flagged 'mainThreadOnly' (eg: the windowing system calls). Every task's measured start & end are kept for the report.
+class TaskGraph {
+public:
+	/// @brief Adds a task. Its dependencies must have been added before it (so the graph can't have cycles).
+	/// @brief 'estimatedCostMs' only steers the scheduling.
+	TaskId add(const std::string& name, std::function<void()> function, const std::vector<TaskId>& dependencies = {}, double estimatedCostMs = 1.0, bool mainThreadOnly = false);
+	/// @brief Runs every task on the calling thread plus 'threadCount - 1' worker threads, and rethrows the first exception a task threw
+	/// @brief (the tasks not started by then are skipped).
+	void run(uint32_t threadCount);
+
+	size_t getTaskCount() const { return tasks.size(); }
+	double getWallTimeMs() const { return wallTimeMs; }
+	/// @brief The measured critical path: from the last task to finish, back through the dependency each task waited for last.
+	std::vector<TaskId> getCriticalPath() const;
+
+	/// @brief Wall time, summed task time and the critical path.
+	void logSummary(std::ostream& out) const;
+	/// @brief The executed graph (tasks, dependencies, threads & timings) as JSON.
+	void writeJson(std::ostream& out) const;
+
+private:
+	struct Task {
+		std::string name;
+		std::function<void()> function;
+		std::vector<TaskId> dependencies;
+		std::vector<TaskId> dependents;
+		double estimatedCostMs{ 1.0 };
+		bool mainThreadOnly{ false };
+		double priority{ 0.0 };  // estimated cost of the longest path from this task to the end of the graph
+		// Execution
+		uint32_t pendingDependencies{ 0 };
+		uint32_t threadIndex{ 0 };
+		double startMs{ 0.0 };
+		double endMs{ 0.0 };
+		bool executed{ false };
+	};
+
+	void workerLoop(uint32_t threadIndex);
+
+	std::vector<Task> tasks;
+	double wallTimeMs{ 0.0 };
+	uint32_t runThreadCount{ 0 };
+
+	// Execution state (guarded by 'mutex')
+	std::mutex mutex;
+	std::condition_variable stateChanged;
+	std::vector<TaskId> readyTasks;
+	size_t remainingTasks{ 0 };
+	std::exception_ptr firstException;
+	std::chrono::steady_clock::time_point runStartTime;
+};
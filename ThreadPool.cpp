@@ -0,0 +1,73 @@
+
+#include "ThreadPool.h"
+
+
+ThreadPool::ThreadPool(uint32_t threadCount) {
+	workers.reserve(threadCount);
+	for (uint32_t i{ 0 }; i < threadCount; i++) {
+		workers.emplace_back(&ThreadPool::workerLoop, this);
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	workAvailable.notify_all();
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+}
+
+void ThreadPool::dispatch(uint32_t taskCount, const std::function<void(uint32_t taskIndex)>& task) {
+	if (taskCount == 0) {
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(mutex);
+	currentTask = &task;
+	this->taskCount = taskCount;
+	nextTaskIndex = 0;
+	tasksRemaining = taskCount;
+	firstException = nullptr;
+	workAvailable.notify_all();
+
+	workFinished.wait(lock, [this]() { return tasksRemaining == 0; });
+	currentTask = nullptr;
+	this->taskCount = 0;
+
+	if (firstException) {
+		std::rethrow_exception(firstException);
+	}
+}
+
+void ThreadPool::workerLoop() {
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true) {
+		workAvailable.wait(lock, [this]() { return stopping || nextTaskIndex < taskCount; });
+		if (stopping) {
+			return;
+		}
+
+		// Grab the next task of the batch and run it outside the lock
+		uint32_t taskIndex = nextTaskIndex++;
+		const std::function<void(uint32_t)>& task = *currentTask;
+		lock.unlock();
+		std::exception_ptr exception;
+		try {
+			task(taskIndex);
+		}
+		catch (...) {
+			exception = std::current_exception();
+		}
+		lock.lock();
+
+		if (exception && !firstException) {
+			firstException = exception;
+		}
+		if (--tasksRemaining == 0) {
+			workFinished.notify_one();
+		}
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <mutex>
+
+/// @brief Fixed set of worker threads that run batches of indexed tasks (eg: one command buffer slice per task).
+/// @brief 'dispatch' blocks until the whole batch is done, and rethrows the first exception thrown by a task.
+class ThreadPool {
+public:
+	explicit ThreadPool(uint32_t threadCount);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	uint32_t getThreadCount() const { return static_cast<uint32_t>(workers.size()); }
+
+	/// @brief Runs 'task(taskIndex)' for every taskIndex in [0, taskCount) across the workers, and waits for all of them.
+	void dispatch(uint32_t taskCount, const std::function<void(uint32_t taskIndex)>& task);
+
+private:
+	void workerLoop();
+
+	std::vector<std::thread> workers;
+	std::mutex mutex;
+	std::condition_variable workAvailable;
+	std::condition_variable workFinished;
+
+	// Current batch (guarded by 'mutex')
+	const std::function<void(uint32_t)>* currentTask = nullptr;
+	uint32_t taskCount{ 0 };
+	uint32_t nextTaskIndex{ 0 };
+	uint32_t tasksRemaining{ 0 };
+	std::exception_ptr firstException;
+	bool stopping{ false };
+};
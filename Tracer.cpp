@@ -0,0 +1,171 @@
+
+#include "Tracer.h"
+#include <unordered_set>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <mutex>
+
+
+std::atomic<bool> Tracer::enabled{ false };
+
+namespace {
+	struct TraceEvent {
+		const char* name;
+		const char* category;
+		int64_t beginNs;
+		int64_t endNs;
+	};
+
+	/// @brief One thread's events. Only its thread writes to it; the count is published after the event it covers.
+	struct ThreadTraceBuffer {
+		uint32_t trackId{ 0 };
+		std::string name;
+		std::unique_ptr<TraceEvent[]> events;
+		std::atomic<size_t> count{ 0 };
+		std::atomic<uint64_t> dropped{ 0 };
+		std::mutex nameMutex;  // (the name may be set while another thread exports)
+	};
+
+	// Registry of every buffer (kept until exit, so the events of finished threads can still be exported)
+	std::mutex registryMutex;
+	std::vector<std::unique_ptr<ThreadTraceBuffer>> threadBuffers;
+	std::unordered_set<std::string> internedNames;
+	ThreadTraceBuffer gpuBuffer;
+	std::mutex gpuMutex;  // GPU events may come from any thread
+	int64_t startNs{ 0 };
+
+	thread_local ThreadTraceBuffer* threadBuffer{ nullptr };
+
+	/// @brief The calling thread's buffer, registered the first time (the only time a lock is taken).
+	ThreadTraceBuffer& getThreadBuffer() {
+		if (!threadBuffer) {
+			auto buffer = std::make_unique<ThreadTraceBuffer>();
+			buffer->events = std::make_unique<TraceEvent[]>(Tracer::EVENTS_PER_THREAD);
+			std::lock_guard<std::mutex> lock(registryMutex);
+			buffer->trackId = static_cast<uint32_t>(threadBuffers.size() + 1);
+			buffer->name = "thread " + std::to_string(buffer->trackId);
+			threadBuffer = buffer.get();
+			threadBuffers.push_back(std::move(buffer));
+		}
+		return *threadBuffer;
+	}
+
+	void append(ThreadTraceBuffer& buffer, const TraceEvent& event) {
+		size_t index = buffer.count.load(std::memory_order_relaxed);
+		if (index >= Tracer::EVENTS_PER_THREAD) {
+			buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		buffer.events[index] = event;
+		buffer.count.store(index + 1, std::memory_order_release);
+	}
+
+	void writeEvents(std::ostream& out, const ThreadTraceBuffer& buffer, uint32_t processId, bool& first) {
+		size_t count = buffer.count.load(std::memory_order_acquire);
+		for (size_t i{ 0 }; i < count; i++) {
+			const TraceEvent& event = buffer.events[i];
+			out << (first ? "" : ",\n")
+				<< "\t\t{ \"name\": \"" << event.name << "\", \"cat\": \"" << event.category << "\", \"ph\": \"X\""
+				<< ", \"ts\": " << static_cast<double>(event.beginNs - startNs) / 1000.0
+				<< ", \"dur\": " << static_cast<double>(event.endNs - event.beginNs) / 1000.0
+				<< ", \"pid\": " << processId << ", \"tid\": " << buffer.trackId << " }";
+			first = false;
+		}
+	}
+}
+
+
+void Tracer::start() {
+	{
+		std::lock_guard<std::mutex> lock(gpuMutex);
+		if (!gpuBuffer.events) {
+			gpuBuffer.events = std::make_unique<TraceEvent[]>(EVENTS_PER_THREAD);
+			gpuBuffer.name = "GPU (graphics queue)";
+		}
+	}
+	if (startNs == 0) {
+		startNs = now();
+	}
+	enabled.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::stop() {
+	enabled.store(false, std::memory_order_relaxed);
+}
+
+int64_t Tracer::now() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Tracer::addCpuEvent(const char* name, const char* category, int64_t beginNs, int64_t endNs) {
+	append(getThreadBuffer(), TraceEvent{ name, category, beginNs, endNs });
+}
+
+void Tracer::addGpuEvent(const char* name, int64_t beginNs, int64_t endNs) {
+	std::lock_guard<std::mutex> lock(gpuMutex);
+	if (!gpuBuffer.events) {
+		return;  // never started
+	}
+	append(gpuBuffer, TraceEvent{ name, "gpu", beginNs, endNs });
+}
+
+void Tracer::setThreadName(const std::string& name) {
+	ThreadTraceBuffer& buffer = getThreadBuffer();
+	std::lock_guard<std::mutex> lock(buffer.nameMutex);
+	buffer.name = name;
+}
+
+const char* Tracer::intern(const std::string& name) {
+	std::lock_guard<std::mutex> lock(registryMutex);
+	return internedNames.insert(name).first->c_str();
+}
+
+bool Tracer::writeJson(const std::string& filePath) {
+	std::ofstream file(filePath);
+	if (!file.is_open()) {
+		std::cerr << "WARNING: Failed to write the trace to '" << filePath << "'!\n";
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(registryMutex);
+	uint64_t eventCount{ gpuBuffer.count.load(std::memory_order_acquire) };
+	uint64_t droppedCount{ gpuBuffer.dropped.load(std::memory_order_relaxed) };
+	bool first{ false };  // (the track names come first)
+	file << std::fixed << std::setprecision(3)
+		<< "{\n"
+		<< "\t\"displayTimeUnit\": \"ms\",\n"
+		<< "\t\"traceEvents\": [\n";
+	// Track names (CPU threads in process 1, the GPU in process 2)
+	file << "\t\t{ \"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"args\": { \"name\": \"CPU\" } },\n"
+		<< "\t\t{ \"name\": \"process_name\", \"ph\": \"M\", \"pid\": 2, \"args\": { \"name\": \"GPU\" } },\n"
+		<< "\t\t{ \"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 2, \"tid\": 0, \"args\": { \"name\": \"" << gpuBuffer.name << "\" } }";
+	for (const auto& buffer : threadBuffers) {
+		std::lock_guard<std::mutex> nameLock(buffer->nameMutex);
+		file << ",\n\t\t{ \"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << buffer->trackId << ", \"args\": { \"name\": \"" << buffer->name << "\" } }";
+	}
+	for (const auto& buffer : threadBuffers) {
+		writeEvents(file, *buffer, 1, first);
+		eventCount += buffer->count.load(std::memory_order_acquire);
+		droppedCount += buffer->dropped.load(std::memory_order_relaxed);
+	}
+	{
+		std::lock_guard<std::mutex> gpuLock(gpuMutex);
+		writeEvents(file, gpuBuffer, 2, first);
+	}
+	file << "\n\t]\n}\n";
+
+	if (!file) {
+		std::cerr << "WARNING: Failed to write the trace to '" << filePath << "'!\n";
+		return false;
+	}
+	std::cout << "> Wrote " << eventCount << " trace events to '" << filePath << "'";
+	if (droppedCount > 0) {
+		std::cout << " (" << droppedCount << " dropped, the buffers were full)";
+	}
+	std::cout << ".\n";
+	return true;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <string>
+
+/// @brief Timeline tracing of CPU scopes (every thread) and GPU scopes, exported as Chrome trace-event JSON
+/// @brief (chrome://tracing, ui.perfetto.dev). Every thread appends to its own fixed-size event buffer without any lock
+/// @brief (it's the buffer's only writer), so a scope costs two clock reads. While tracing is off a scope is a single
+/// @brief relaxed load. The timestamps are 'steady_clock' nanoseconds, which the GPU timestamps are aligned to.
+class Tracer {
+public:
+	/// @brief Events kept per thread (the ones past it are dropped, and counted).
+	static constexpr size_t EVENTS_PER_THREAD{ 1 << 18 };
+
+	static void start();
+	static void stop();
+	static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+	/// @brief 'steady_clock' time, in nanoseconds.
+	static int64_t now();
+
+	/// @brief The names must outlive the tracer (string literals, or 'intern').
+	static void addCpuEvent(const char* name, const char* category, int64_t beginNs, int64_t endNs);
+	/// @brief Added to the GPU track, whatever the calling thread.
+	static void addGpuEvent(const char* name, int64_t beginNs, int64_t endNs);
+	/// @brief Name of the calling thread's track (eg: "main", "recording worker 2").
+	static void setThreadName(const std::string& name);
+	/// @brief A copy of the string that lives as long as the program (for the names built at runtime).
+	static const char* intern(const std::string& name);
+
+	/// @brief Every buffered event as Chrome trace-event JSON. To be called once the traced threads are done (or idle).
+	static bool writeJson(const std::string& filePath);
+
+private:
+	static std::atomic<bool> enabled;
+};
+
+/// @brief Traces the time between its construction and destruction on the calling thread (if tracing is on when it starts).
+class TraceScope {
+public:
+	explicit TraceScope(const char* name, const char* category = "cpu")
+		: name(Tracer::isEnabled() ? name : nullptr), category(category) {
+		if (this->name) {
+			beginNs = Tracer::now();
+		}
+	}
+	~TraceScope() {
+		if (name) {
+			Tracer::addCpuEvent(name, category, beginNs, Tracer::now());
+		}
+	}
+
+	TraceScope(const TraceScope&) = delete;
+	TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+	const char* name;
+	const char* category;
+	int64_t beginNs{ 0 };
+};
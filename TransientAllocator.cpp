@@ -0,0 +1,110 @@
+
+#include "TransientAllocator.h"
+#include <algorithm>
+#include <stdexcept>
+#include <numeric>
+
+
+void TransientAllocator::initialize(VkPhysicalDevice physicalDevice) {
+	vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+}
+
+bool TransientAllocator::hasLazilyAllocatedMemory() const {
+	for (uint32_t i{ 0 }; i < memoryProperties.memoryTypeCount; i++) {
+		if (memoryProperties.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT) {
+			return true;
+		}
+	}
+	return false;
+}
+
+TransientBlock TransientAllocator::allocate(VkDevice device, const std::vector<TransientImage>& images, bool preferLazilyAllocated) const {
+	TransientBlock block{};
+	std::vector<VkMemoryRequirements> requirements(images.size());
+	uint32_t memoryTypeBits{ ~0u };
+	for (size_t i{ 0 }; i < images.size(); i++) {
+		vkGetImageMemoryRequirements(device, images.at(i).image, &requirements.at(i));
+		memoryTypeBits &= requirements.at(i).memoryTypeBits;
+		block.unaliasedSize += requirements.at(i).size;
+	}
+	block.size = planOffsets(requirements, images, block.offsets);
+
+	// Lazily allocated device local memory if wanted (and allowed by every image), else plain device local memory
+	auto findMemoryType = [&](VkMemoryPropertyFlags properties) -> int32_t {
+		for (uint32_t i{ 0 }; i < memoryProperties.memoryTypeCount; i++) {
+			if ((memoryTypeBits & (1u << i)) && (memoryProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+				return static_cast<int32_t>(i);
+			}
+		}
+		return -1;
+	};
+	int32_t memoryTypeIndex{ -1 };
+	if (preferLazilyAllocated) {
+		memoryTypeIndex = findMemoryType(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT);
+		block.lazilyAllocated = memoryTypeIndex >= 0;
+	}
+	if (memoryTypeIndex < 0) {
+		memoryTypeIndex = findMemoryType(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+	}
+	if (memoryTypeIndex < 0) {
+		throw std::runtime_error("RUNTIME ERROR: The transient images have no device local memory type in common!");
+	}
+	block.memoryTypeIndex = static_cast<uint32_t>(memoryTypeIndex);
+
+	VkMemoryAllocateInfo memoryAllocateInfo{};
+	memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+	memoryAllocateInfo.allocationSize = block.size;
+	memoryAllocateInfo.memoryTypeIndex = block.memoryTypeIndex;
+	if (vkAllocateMemory(device, &memoryAllocateInfo, nullptr, &block.memory) != VK_SUCCESS) {
+		throw std::runtime_error("RUNTIME ERROR: Failed to allocate the transient attachment memory!");
+	}
+	for (size_t i{ 0 }; i < images.size(); i++) {
+		vkBindImageMemory(device, images.at(i).image, block.memory, block.offsets.at(i));
+	}
+	return block;
+}
+
+VkDeviceSize TransientAllocator::planOffsets(const std::vector<VkMemoryRequirements>& requirements, const std::vector<TransientImage>& lifetimes, std::vector<VkDeviceSize>& outOffsets) {
+	outOffsets.assign(requirements.size(), 0);
+	std::vector<size_t> order(requirements.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&requirements](size_t a, size_t b) { return requirements.at(a).size > requirements.at(b).size; });
+
+	VkDeviceSize blockSize{ 0 };
+	std::vector<size_t> placed{};
+	for (size_t resource : order) {
+		const VkMemoryRequirements& resourceRequirements = requirements.at(resource);
+		VkDeviceSize alignment = std::max<VkDeviceSize>(resourceRequirements.alignment, 1);
+		// The ranges taken, during this resource's passes, by the resources already placed (by increasing offset)
+		std::vector<std::pair<VkDeviceSize, VkDeviceSize>> takenRanges{};
+		for (size_t other : placed) {
+			bool overlappingLifetimes = lifetimes.at(resource).firstPass <= lifetimes.at(other).lastPass && lifetimes.at(other).firstPass <= lifetimes.at(resource).lastPass;
+			if (overlappingLifetimes) {
+				takenRanges.emplace_back(outOffsets.at(other), outOffsets.at(other) + requirements.at(other).size);
+			}
+		}
+		std::sort(takenRanges.begin(), takenRanges.end());
+
+		// Lowest aligned offset that fits between (or after) the taken ranges
+		VkDeviceSize offset{ 0 };
+		for (const auto& [takenBegin, takenEnd] : takenRanges) {
+			if (offset + resourceRequirements.size <= takenBegin) {
+				break;
+			}
+			offset = std::max(offset, (takenEnd + alignment - 1) / alignment * alignment);
+		}
+		outOffsets.at(resource) = offset;
+		blockSize = std::max(blockSize, offset + resourceRequirements.size);
+		placed.push_back(resource);
+	}
+	return blockSize;
+}
+
+VkDeviceSize TransientAllocator::getCommittedBytes(VkDevice device, const TransientBlock& block) {
+	if (!block.lazilyAllocated || block.memory == VK_NULL_HANDLE) {
+		return block.size;
+	}
+	VkDeviceSize committedBytes{ 0 };
+	vkGetDeviceMemoryCommitment(device, block.memory, &committedBytes);
+	return committedBytes;
+}
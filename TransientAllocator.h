@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <vector>
+
+/// @brief An image that only lives within the passes [firstPass, lastPass] of a frame (eg: a depth attachment never read afterwards).
+struct TransientImage {
+	VkImage image = VK_NULL_HANDLE;
+	uint32_t firstPass{ 0 };
+	uint32_t lastPass{ 0 };
+};
+
+/// @brief One memory block shared by transient images, each bound at its own offset.
+struct TransientBlock {
+	VkDeviceMemory memory = VK_NULL_HANDLE;
+	uint32_t memoryTypeIndex{ 0 };
+	/// @brief Size of the block, and what the images would take in separate allocations.
+	VkDeviceSize size{ 0 };
+	VkDeviceSize unaliasedSize{ 0 };
+	/// @brief True if the block is in a LAZILY_ALLOCATED memory type (only backed by real memory as far as the GPU needs it).
+	bool lazilyAllocated{ false };
+	std::vector<VkDeviceSize> offsets;  // one per image, in the order they were given
+};
+
+/// @brief Places transient images in a single memory block: images whose pass ranges don't overlap may share the same bytes
+/// @brief (memory aliasing), since one is done with them before the other starts. Prefers a LAZILY_ALLOCATED memory type,
+/// @brief which tile-based GPUs back with on-chip memory only, when every image allows it.
+class TransientAllocator {
+public:
+	void initialize(VkPhysicalDevice physicalDevice);
+
+	bool hasLazilyAllocatedMemory() const;
+
+	/// @brief Allocates the block and binds every image into it. The block's memory belongs to the caller. Throws if the images
+	/// @brief have no memory type in common.
+	TransientBlock allocate(VkDevice device, const std::vector<TransientImage>& images, bool preferLazilyAllocated) const;
+
+	/// @brief Offsets of the resources in a shared block (largest first, each at the lowest offset free during its passes).
+	/// @return The size of the block.
+	static VkDeviceSize planOffsets(const std::vector<VkMemoryRequirements>& requirements, const std::vector<TransientImage>& lifetimes, std::vector<VkDeviceSize>& outOffsets);
+
+	/// @brief Bytes of a lazily allocated block actually backed by memory right now (the block's size otherwise).
+	static VkDeviceSize getCommittedBytes(VkDevice device, const TransientBlock& block);
+
+private:
+	VkPhysicalDeviceMemoryProperties memoryProperties{};
+};
@@ -1,11 +1,19 @@
 
 #include "Application.h"
+#include "Benchmark.h"
 
-int main() {
-
-	Application application;
+int main(int argc, char* argv[]) {
 
 	try {
+		ApplicationOptions options = ApplicationOptions::fromCommandLine(argc, argv);
+		// The benchmark runs every scenario in its own Application
+		if (options.benchmark) {
+			return Benchmark::run(options);
+		}
+		if (options.cullingBenchmark) {
+			return Benchmark::runCulling();
+		}
+		Application application(options);
 		application.run();
 	} catch (const std::exception& e) {
 		std::cerr << e.what() << std::endl;
@@ -13,4 +21,4 @@ int main() {
 	}
 
 	return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
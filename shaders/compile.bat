@@ -1,4 +1,9 @@
 C:/VulkanSDK/1.4.309.0/Bin/glslc.exe shader.vert -o vert.spv
 C:/VulkanSDK/1.4.309.0/Bin/glslc.exe shader.frag -o frag.spv
+C:/VulkanSDK/1.4.309.0/Bin/glslc.exe -DBINDLESS shader.vert -o vert_bindless.spv
+C:/VulkanSDK/1.4.309.0/Bin/glslc.exe -DBINDLESS shader.frag -o frag_bindless.spv
+C:/VulkanSDK/1.4.309.0/Bin/glslc.exe cull.comp -o cull.spv
+C:/VulkanSDK/1.4.309.0/Bin/glslc.exe -DOCCLUSION_CULLING cull.comp -o cull_occlusion.spv
+C:/VulkanSDK/1.4.309.0/Bin/glslc.exe hiz.comp -o hiz.spv
 pause
 
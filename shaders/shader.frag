@@ -1,6 +1,21 @@
 #version 450
 
+// Compiled a second time with BINDLESS defined (frag_bindless.spv): the texture comes from the array of every texture, at the
+// object's slot (which may differ between the instances of a draw, hence 'nonuniformEXT')
+#ifdef BINDLESS
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout(binding = 2) uniform sampler2D textures[];
+
+layout(location = 2) flat in uint fragTextureIndex;
+
+#define texSampler textures[nonuniformEXT(fragTextureIndex)]
+#else
 layout(binding = 1) uniform sampler2D texSampler;
+#endif
+
+// Selected per pipeline variant (see 'ShadingMode'): 0 textured, 1 texture * vertex color, 2 vertex color, 3 texture coordinates
+layout(constant_id = 0) const uint SHADING_MODE = 0;
 
 layout(location = 0) in vec3 fragColor;
 layout(location = 1) in vec2 fragTexCoord;
@@ -8,5 +23,16 @@ layout(location = 1) in vec2 fragTexCoord;
 layout(location = 0) out vec4 outColor;
 
 void main() {
-    outColor = texture(texSampler, fragTexCoord);
+    if (SHADING_MODE == 1) {
+        outColor = texture(texSampler, fragTexCoord) * vec4(fragColor, 1.0);
+    }
+    else if (SHADING_MODE == 2) {
+        outColor = vec4(fragColor, 1.0);
+    }
+    else if (SHADING_MODE == 3) {
+        outColor = vec4(fragTexCoord, 0.0, 1.0);
+    }
+    else {
+        outColor = texture(texSampler, fragTexCoord);
+    }
 }
\ No newline at end of file
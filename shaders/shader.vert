@@ -1,20 +1,54 @@
 #version 450
 
+// Compiled a second time with BINDLESS defined (vert_bindless.spv): a single descriptor set holds every frame's uniform & object
+// buffers, this frame's ones are selected by the 'frameIndex' push constant, and each object's data by its instance index
+// (the instance buffer's order, which 'firstInstance' follows in every draw path).
+#ifdef BINDLESS
+#extension GL_EXT_nonuniform_qualifier : require
+
+struct ObjectData {
+    uint textureIndex;
+};
+
+layout(binding = 0) uniform UniformBufferObject {
+    mat4 model;
+    mat4 view;
+    mat4 proj;
+} ubos[];
+
+layout(std430, binding = 1) readonly buffer ObjectBuffer {
+    ObjectData objects[];
+} objectBuffers[];
+
+layout(push_constant) uniform ScenePushConstants {
+    uint frameIndex;
+};
+
+#define ubo ubos[frameIndex]
+
+layout(location = 2) flat out uint fragTextureIndex;
+#else
 layout(binding=0) uniform UniformBufferObject {
     mat4 model;
     mat4 view;
     mat4 proj;
 } ubo;
+#endif
 
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inColor;
 layout(location = 2) in vec2 inTexCoord;
+// Per-instance transform (occupies locations 3 to 6, one per column)
+layout(location = 3) in mat4 inInstanceModel;
 
 layout(location = 0) out vec3 fragColor;
 layout(location = 1) out vec2 fragTexCoord;
 
 void main() {
-    gl_Position = ubo.proj * ubo.view * ubo.model * vec4(inPosition, 1.0);
+    gl_Position = ubo.proj * ubo.view * inInstanceModel * ubo.model * vec4(inPosition, 1.0);
     fragColor = inColor;
     fragTexCoord = inTexCoord;
+#ifdef BINDLESS
+    fragTextureIndex = objectBuffers[frameIndex].objects[gl_InstanceIndex].textureIndex;
+#endif
 }
\ No newline at end of file